@@ -6,6 +6,14 @@ fn main() {
         .warnings(false) // SPH/vendored code has some pedantic warnings
         .opt_level(2);
 
+    // cryptonight.c only compiles its ARMv8 Crypto Extension kernels when the
+    // compiler targets the extension. They are still selected at runtime.
+    let target_arch = std::env::var("CARGO_CFG_TARGET_ARCH").unwrap_or_default();
+    let target_os = std::env::var("CARGO_CFG_TARGET_OS").unwrap_or_default();
+    if target_arch == "aarch64" && (target_os == "linux" || target_os == "android") {
+        build.flag_if_supported("-march=armv8-a+crypto");
+    }
+
     // SPH hash function implementations (each is a standalone compilation unit)
     let sph_sources = [
         "ghostrider/sph_blake.c",
@@ -23,6 +31,7 @@ fn main() {
         "ghostrider/sph_simd.c",
         "ghostrider/sph_skein.c",
         "ghostrider/sph_whirlpool.c",
+        "ghostrider/sph_x4.c",
     ];
 
     for src in &sph_sources {
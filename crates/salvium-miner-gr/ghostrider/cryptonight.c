@@ -2,7 +2,8 @@
  * CryptoNight hash — standalone portable C implementation for GhostRider.
  *
  * Implements CN_1 (Monero V7) base with the 6 GhostRider variant parameters.
- * Software AES only (T-table approach, no hardware AES-NI).
+ * The AES rounds use AES-NI on x86 and the Crypto Extension on ARMv8 when
+ * the CPU has them (checked at runtime), and software T-tables otherwise.
  *
  * Reference: XMRig CryptoNight_x86.h, soft_aes.h, CryptoNight_monero.h
  * License: GPL-3.0+
@@ -18,6 +19,35 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define CN_HAVE_AESNI 1
+#include <emmintrin.h>
+#include <wmmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#elif (defined(__aarch64__) || defined(_M_ARM64)) && \
+      (defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_AES))
+#define CN_HAVE_ARMV8_AES 1
+#include <arm_neon.h>
+#if defined(__linux__)
+#include <sys/auxv.h>
+#ifndef HWCAP_AES
+#define HWCAP_AES (1 << 3)
+#endif
+#endif
+#endif
+
+#if defined(_MSC_VER)
+#define CN_INLINE __forceinline
+#define CN_TARGET_AESNI
+#else
+#define CN_INLINE inline __attribute__((always_inline))
+#define CN_TARGET_AESNI __attribute__((target("aes")))
+#endif
+
 /* ── AES T-tables (generated from S-box via macros, same as XMRig soft_aes.h) ── */
 
 #define SAES_WPOLY 0x011b
@@ -243,6 +273,110 @@ static inline void cn_aes_10rounds(uint8_t block[16], const uint32_t rk[10][4])
     }
 }
 
+/* Apply 10 AES rounds (in-place) to the 8 working blocks */
+static void cn_aes_10rounds_x8(uint8_t blocks[8][16], const uint32_t rk[10][4])
+{
+    for (int b = 0; b < 8; b++) {
+        cn_aes_10rounds(blocks[b], rk);
+    }
+}
+
+/*
+ * The explode, main loop and implode code below is shared by the software
+ * and hardware AES implementations; each one only provides two primitives:
+ *   round_to:    dst = aesenc(src, key)
+ *   rounds_x8:   10 aesenc rounds on 8 independent blocks
+ */
+typedef void (*cn_round_to_fn)(const uint8_t src[16], const uint32_t key[4],
+                               uint8_t dst[16]);
+typedef void (*cn_rounds_x8_fn)(uint8_t blocks[8][16], const uint32_t rk[10][4]);
+
+#ifdef CN_HAVE_AESNI
+
+static CN_TARGET_AESNI CN_INLINE void cn_aesni_round_to(const uint8_t src[16],
+                                                        const uint32_t key[4],
+                                                        uint8_t dst[16])
+{
+    __m128i x = _mm_load_si128((const __m128i *)src);
+    __m128i k = _mm_loadu_si128((const __m128i *)key);
+    _mm_storeu_si128((__m128i *)dst, _mm_aesenc_si128(x, k));
+}
+
+/* The 8 blocks are independent, so their rounds are interleaved to hide
+ * the AESENC latency. */
+static CN_TARGET_AESNI CN_INLINE void cn_aesni_10rounds_x8(uint8_t blocks[8][16],
+                                                           const uint32_t rk[10][4])
+{
+    __m128i x0 = _mm_loadu_si128((const __m128i *)blocks[0]);
+    __m128i x1 = _mm_loadu_si128((const __m128i *)blocks[1]);
+    __m128i x2 = _mm_loadu_si128((const __m128i *)blocks[2]);
+    __m128i x3 = _mm_loadu_si128((const __m128i *)blocks[3]);
+    __m128i x4 = _mm_loadu_si128((const __m128i *)blocks[4]);
+    __m128i x5 = _mm_loadu_si128((const __m128i *)blocks[5]);
+    __m128i x6 = _mm_loadu_si128((const __m128i *)blocks[6]);
+    __m128i x7 = _mm_loadu_si128((const __m128i *)blocks[7]);
+
+    for (int i = 0; i < 10; i++) {
+        const __m128i k = _mm_loadu_si128((const __m128i *)rk[i]);
+        x0 = _mm_aesenc_si128(x0, k);
+        x1 = _mm_aesenc_si128(x1, k);
+        x2 = _mm_aesenc_si128(x2, k);
+        x3 = _mm_aesenc_si128(x3, k);
+        x4 = _mm_aesenc_si128(x4, k);
+        x5 = _mm_aesenc_si128(x5, k);
+        x6 = _mm_aesenc_si128(x6, k);
+        x7 = _mm_aesenc_si128(x7, k);
+    }
+
+    _mm_storeu_si128((__m128i *)blocks[0], x0);
+    _mm_storeu_si128((__m128i *)blocks[1], x1);
+    _mm_storeu_si128((__m128i *)blocks[2], x2);
+    _mm_storeu_si128((__m128i *)blocks[3], x3);
+    _mm_storeu_si128((__m128i *)blocks[4], x4);
+    _mm_storeu_si128((__m128i *)blocks[5], x5);
+    _mm_storeu_si128((__m128i *)blocks[6], x6);
+    _mm_storeu_si128((__m128i *)blocks[7], x7);
+}
+
+#endif /* CN_HAVE_AESNI */
+
+#ifdef CN_HAVE_ARMV8_AES
+
+/*
+ * AESE computes SubBytes(ShiftRows(x ^ k)), so x86 aesenc(x, k) is
+ * AESMC(AESE(x, 0)) ^ k.  In a chain of rounds the XOR with a round key is
+ * folded into the next AESE instead.
+ */
+static CN_INLINE void cn_armv8_round_to(const uint8_t src[16],
+                                        const uint32_t key[4],
+                                        uint8_t dst[16])
+{
+    uint8x16_t x = vaesmcq_u8(vaeseq_u8(vld1q_u8(src), vdupq_n_u8(0)));
+    vst1q_u8(dst, veorq_u8(x, vld1q_u8((const uint8_t *)key)));
+}
+
+static CN_INLINE void cn_armv8_10rounds_x8(uint8_t blocks[8][16],
+                                           const uint32_t rk[10][4])
+{
+    const uint8x16_t zero = vdupq_n_u8(0);
+    uint8x16_t x[8];
+
+    for (int b = 0; b < 8; b++) {
+        x[b] = vaesmcq_u8(vaeseq_u8(vld1q_u8(blocks[b]), zero));
+    }
+    for (int i = 0; i < 9; i++) {
+        const uint8x16_t k = vld1q_u8((const uint8_t *)rk[i]);
+        for (int b = 0; b < 8; b++) {
+            x[b] = vaesmcq_u8(vaeseq_u8(x[b], k));
+        }
+    }
+    for (int b = 0; b < 8; b++) {
+        vst1q_u8(blocks[b], veorq_u8(x[b], vld1q_u8((const uint8_t *)rk[9])));
+    }
+}
+
+#endif /* CN_HAVE_ARMV8_AES */
+
 /* ── Explode scratchpad ────────────────────────────────────────── */
 
 /*
@@ -253,7 +387,8 @@ static inline void cn_aes_10rounds(uint8_t block[16], const uint32_t rk[10][4])
  * If first_half: save AES state after filling for use in second pass.
  * If !first_half: restore saved AES state before filling.
  */
-static void cn_explode_scratchpad(cn_ctx *ctx, const cn_variant *v)
+static CN_INLINE void cn_explode_scratchpad(cn_ctx *ctx, const cn_variant *v,
+                                            cn_rounds_x8_fn rounds_x8)
 {
     uint32_t rk[10][4];
     cn_aes_genkey(ctx->state, rk);  /* key from state[0:31] */
@@ -273,9 +408,7 @@ static void cn_explode_scratchpad(cn_ctx *ctx, const cn_variant *v)
 
     uint8_t *out = ctx->memory;
     for (size_t i = 0; i < N; i += 8) {
-        for (int b = 0; b < 8; b++) {
-            cn_aes_10rounds(blocks[b], rk);
-        }
+        rounds_x8(blocks, rk);
         /* Store blocks 0-3 at offset, blocks 4-7 at offset+64 */
         memcpy(out,      blocks[0], 16);
         memcpy(out + 16, blocks[1], 16);
@@ -303,7 +436,8 @@ static void cn_explode_scratchpad(cn_ctx *ctx, const cn_variant *v)
  *
  * For half_mem: process first half, then re-explode second half and process that.
  */
-static void cn_implode_scratchpad(cn_ctx *ctx, const cn_variant *v)
+static CN_INLINE void cn_implode_scratchpad(cn_ctx *ctx, const cn_variant *v,
+                                            cn_rounds_x8_fn rounds_x8)
 {
     uint32_t rk[10][4];
     cn_aes_genkey(ctx->state + 32, rk);  /* key from state[32:63] */
@@ -323,7 +457,7 @@ static void cn_implode_scratchpad(cn_ctx *ctx, const cn_variant *v)
             /* Re-explode the second half of the scratchpad */
             inp = ctx->memory;  /* reset to beginning */
             ctx->first_half = 0;
-            cn_explode_scratchpad(ctx, v);
+            cn_explode_scratchpad(ctx, v, rounds_x8);
         }
 
         for (size_t i = 0; i < N; i += 8) {
@@ -337,9 +471,7 @@ static void cn_implode_scratchpad(cn_ctx *ctx, const cn_variant *v)
             inp += 128;
 
             /* Apply 10 AES rounds */
-            for (int b = 0; b < 8; b++) {
-                cn_aes_10rounds(xout[b], rk);
-            }
+            rounds_x8(xout, rk);
         }
     }
 
@@ -372,6 +504,296 @@ static inline uint64_t cn_umul128(uint64_t a, uint64_t b, uint64_t *hi)
 #endif
 }
 
+/* ── Main loop ─────────────────────────────────────────────────── */
+
+static CN_INLINE void cn_main_loop(cn_ctx *ctx, const cn_variant *v,
+                                   uint64_t tweak1_2, cn_round_to_fn round_to)
+{
+    uint64_t *h = (uint64_t *)ctx->state;
+    uint8_t *l = ctx->memory;
+    const uint32_t mask = v->mask;
+
+    uint64_t al0 = h[0] ^ h[4];
+    uint64_t ah0 = h[1] ^ h[5];
+    uint64_t idx0 = al0;
+
+    /* bx0 = (h[2]^h[6], h[3]^h[7]) as 128-bit value */
+    uint64_t bx0_lo = h[2] ^ h[6];
+    uint64_t bx0_hi = h[3] ^ h[7];
+
+    for (uint32_t i = 0; i < v->iterations; i++) {
+        /* cx = aesenc(scratchpad[idx0 & mask], key=(al0, ah0)) */
+        uint8_t cx[16];
+        uint32_t aes_key[4];
+        memcpy(aes_key, &al0, 8);
+        memcpy(aes_key + 2, &ah0, 8);
+        round_to(&l[idx0 & mask], aes_key, cx);
+
+        /* Store bx0 ^ cx at old address, with V1 tweak */
+        {
+            uint64_t cx_lo, cx_hi;
+            memcpy(&cx_lo, cx, 8);
+            memcpy(&cx_hi, cx + 8, 8);
+            uint64_t store_lo = bx0_lo ^ cx_lo;
+            uint64_t store_hi = bx0_hi ^ cx_hi;
+
+            /* VARIANT1_1: tweak byte 11 of the stored block */
+            /* Byte 11 = byte 3 of store_hi (little-endian uint64_t) */
+            {
+                uint8_t *store_bytes = (uint8_t *)&store_hi;
+                uint8_t tmp = store_bytes[3];  /* byte 11 of 16-byte block */
+                uint8_t index = (((tmp >> 3) & 6) | (tmp & 1)) << 1;
+                store_bytes[3] = tmp ^ ((0x75310 >> index) & 0x30);
+            }
+
+            memcpy(&l[idx0 & mask], &store_lo, 8);
+            memcpy(&l[(idx0 & mask) + 8], &store_hi, 8);
+        }
+
+        /* idx0 = low 64 bits of cx */
+        memcpy(&idx0, cx, 8);
+
+        /* Read (cl, ch) from new address */
+        uint64_t cl, ch;
+        memcpy(&cl, &l[idx0 & mask], 8);
+        memcpy(&ch, &l[(idx0 & mask) + 8], 8);
+
+        /* 128-bit multiply: (hi, lo) = idx0 * cl */
+        uint64_t hi_mul, lo_mul;
+        lo_mul = cn_umul128(idx0, cl, &hi_mul);
+
+        /* Update a registers */
+        al0 += hi_mul;
+        ah0 += lo_mul;
+
+        /* Store (al0, ah0 ^ tweak1_2) at new address */
+        memcpy(&l[idx0 & mask], &al0, 8);
+        uint64_t store_ah = ah0 ^ tweak1_2;
+        memcpy(&l[(idx0 & mask) + 8], &store_ah, 8);
+
+        /* XOR and update */
+        al0 ^= cl;
+        ah0 ^= ch;
+        idx0 = al0;
+
+        /* Update bx0 = cx */
+        memcpy(&bx0_lo, cx, 8);
+        memcpy(&bx0_hi, cx + 8, 8);
+    }
+}
+
+/*
+ * N-way main loop: n independent hashes of the same variant, each with its
+ * own context and scratchpad.  Every step is done for all lanes before the
+ * next one, so the dependent load/AES/multiply chains of the lanes overlap.
+ * n is a constant at each call site, so the lane loops are unrolled.
+ */
+static CN_INLINE void cn_main_loop_n(cn_ctx *const ctxs[], int n, const cn_variant *v,
+                                     const uint64_t tweak1_2[], cn_round_to_fn round_to)
+{
+    uint8_t *l[CN_MAX_LANES];
+    uint64_t al[CN_MAX_LANES], ah[CN_MAX_LANES], idx[CN_MAX_LANES];
+    uint64_t bx_lo[CN_MAX_LANES], bx_hi[CN_MAX_LANES];
+    const uint32_t mask = v->mask;
+
+    for (int j = 0; j < n; j++) {
+        const uint64_t *h = (const uint64_t *)ctxs[j]->state;
+        l[j] = ctxs[j]->memory;
+        al[j] = h[0] ^ h[4];
+        ah[j] = h[1] ^ h[5];
+        idx[j] = al[j];
+        bx_lo[j] = h[2] ^ h[6];
+        bx_hi[j] = h[3] ^ h[7];
+    }
+
+    for (uint32_t i = 0; i < v->iterations; i++) {
+        uint8_t cx[CN_MAX_LANES][16];
+
+        for (int j = 0; j < n; j++) {
+            uint32_t aes_key[4];
+            memcpy(aes_key, &al[j], 8);
+            memcpy(aes_key + 2, &ah[j], 8);
+            round_to(&l[j][idx[j] & mask], aes_key, cx[j]);
+        }
+
+        for (int j = 0; j < n; j++) {
+            uint64_t cx_lo, cx_hi;
+            memcpy(&cx_lo, cx[j], 8);
+            memcpy(&cx_hi, cx[j] + 8, 8);
+            uint64_t store_lo = bx_lo[j] ^ cx_lo;
+            uint64_t store_hi = bx_hi[j] ^ cx_hi;
+
+            /* VARIANT1_1 tweak of byte 11, as in cn_main_loop */
+            uint8_t tmp = (uint8_t)(store_hi >> 24);
+            uint8_t index = (((tmp >> 3) & 6) | (tmp & 1)) << 1;
+            store_hi ^= (uint64_t)((0x75310 >> index) & 0x30) << 24;
+
+            memcpy(&l[j][idx[j] & mask], &store_lo, 8);
+            memcpy(&l[j][(idx[j] & mask) + 8], &store_hi, 8);
+
+            idx[j] = cx_lo;
+            bx_lo[j] = cx_lo;
+            bx_hi[j] = cx_hi;
+        }
+
+        for (int j = 0; j < n; j++) {
+            uint64_t cl, ch, hi_mul, lo_mul;
+            memcpy(&cl, &l[j][idx[j] & mask], 8);
+            memcpy(&ch, &l[j][(idx[j] & mask) + 8], 8);
+
+            lo_mul = cn_umul128(idx[j], cl, &hi_mul);
+            al[j] += hi_mul;
+            ah[j] += lo_mul;
+
+            uint64_t store_ah = ah[j] ^ tweak1_2[j];
+            memcpy(&l[j][idx[j] & mask], &al[j], 8);
+            memcpy(&l[j][(idx[j] & mask) + 8], &store_ah, 8);
+
+            al[j] ^= cl;
+            ah[j] ^= ch;
+            idx[j] = al[j];
+        }
+    }
+}
+
+/* ── AES implementations ───────────────────────────────────────── */
+
+typedef struct {
+    void (*explode)(cn_ctx *ctx, const cn_variant *v);
+    void (*main_loop)(cn_ctx *ctx, const cn_variant *v, uint64_t tweak1_2);
+    void (*implode)(cn_ctx *ctx, const cn_variant *v);
+    void (*main_loop_multi)(cn_ctx *const ctxs[], int n, const cn_variant *v,
+                            const uint64_t tweak1_2[]);
+} cn_kernels;
+
+static void cn_explode_soft(cn_ctx *ctx, const cn_variant *v)
+{
+    cn_explode_scratchpad(ctx, v, cn_aes_10rounds_x8);
+}
+
+static void cn_main_loop_soft(cn_ctx *ctx, const cn_variant *v, uint64_t tweak1_2)
+{
+    cn_main_loop(ctx, v, tweak1_2, cn_aes_round_to);
+}
+
+static void cn_implode_soft(cn_ctx *ctx, const cn_variant *v)
+{
+    cn_implode_scratchpad(ctx, v, cn_aes_10rounds_x8);
+}
+
+static void cn_main_loop_multi_soft(cn_ctx *const ctxs[], int n, const cn_variant *v,
+                                    const uint64_t tweak1_2[])
+{
+    switch (n) {
+    case 2:  cn_main_loop_n(ctxs, 2, v, tweak1_2, cn_aes_round_to); break;
+    case 3:  cn_main_loop_n(ctxs, 3, v, tweak1_2, cn_aes_round_to); break;
+    default: cn_main_loop_n(ctxs, 4, v, tweak1_2, cn_aes_round_to); break;
+    }
+}
+
+#if defined(CN_HAVE_AESNI)
+
+static CN_TARGET_AESNI void cn_explode_hw(cn_ctx *ctx, const cn_variant *v)
+{
+    cn_explode_scratchpad(ctx, v, cn_aesni_10rounds_x8);
+}
+
+static CN_TARGET_AESNI void cn_main_loop_hw(cn_ctx *ctx, const cn_variant *v, uint64_t tweak1_2)
+{
+    cn_main_loop(ctx, v, tweak1_2, cn_aesni_round_to);
+}
+
+static CN_TARGET_AESNI void cn_implode_hw(cn_ctx *ctx, const cn_variant *v)
+{
+    cn_implode_scratchpad(ctx, v, cn_aesni_10rounds_x8);
+}
+
+static CN_TARGET_AESNI void cn_main_loop_multi_hw(cn_ctx *const ctxs[], int n,
+                                                  const cn_variant *v,
+                                                  const uint64_t tweak1_2[])
+{
+    switch (n) {
+    case 2:  cn_main_loop_n(ctxs, 2, v, tweak1_2, cn_aesni_round_to); break;
+    case 3:  cn_main_loop_n(ctxs, 3, v, tweak1_2, cn_aesni_round_to); break;
+    default: cn_main_loop_n(ctxs, 4, v, tweak1_2, cn_aesni_round_to); break;
+    }
+}
+
+#elif defined(CN_HAVE_ARMV8_AES)
+
+static void cn_explode_hw(cn_ctx *ctx, const cn_variant *v)
+{
+    cn_explode_scratchpad(ctx, v, cn_armv8_10rounds_x8);
+}
+
+static void cn_main_loop_hw(cn_ctx *ctx, const cn_variant *v, uint64_t tweak1_2)
+{
+    cn_main_loop(ctx, v, tweak1_2, cn_armv8_round_to);
+}
+
+static void cn_implode_hw(cn_ctx *ctx, const cn_variant *v)
+{
+    cn_implode_scratchpad(ctx, v, cn_armv8_10rounds_x8);
+}
+
+static void cn_main_loop_multi_hw(cn_ctx *const ctxs[], int n, const cn_variant *v,
+                                  const uint64_t tweak1_2[])
+{
+    switch (n) {
+    case 2:  cn_main_loop_n(ctxs, 2, v, tweak1_2, cn_armv8_round_to); break;
+    case 3:  cn_main_loop_n(ctxs, 3, v, tweak1_2, cn_armv8_round_to); break;
+    default: cn_main_loop_n(ctxs, 4, v, tweak1_2, cn_armv8_round_to); break;
+    }
+}
+
+#else
+
+/* Never selected: cn_hw_aes_available() returns 0 */
+#define cn_explode_hw   cn_explode_soft
+#define cn_main_loop_hw cn_main_loop_soft
+#define cn_implode_hw   cn_implode_soft
+#define cn_main_loop_multi_hw cn_main_loop_multi_soft
+
+#endif
+
+/* Indexed by CN_AES_SOFT / CN_AES_HW */
+static const cn_kernels cn_kernel_table[2] = {
+    { cn_explode_soft, cn_main_loop_soft, cn_implode_soft, cn_main_loop_multi_soft },
+    { cn_explode_hw,   cn_main_loop_hw,   cn_implode_hw,   cn_main_loop_multi_hw   },
+};
+
+int cn_hw_aes_available(void)
+{
+#if defined(CN_HAVE_AESNI)
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] >> 25) & 1;
+#else
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return 0;
+    return (ecx >> 25) & 1;
+#endif
+#elif defined(CN_HAVE_ARMV8_AES)
+#if defined(__linux__)
+    return (getauxval(AT_HWCAP) & HWCAP_AES) != 0;
+#else
+    return 1;  /* built for a CPU with the Crypto Extension */
+#endif
+#else
+    return 0;
+#endif
+}
+
+int cn_set_aes_impl(cn_ctx *ctx, int impl)
+{
+    if (impl == CN_AES_SOFT || (impl == CN_AES_HW && cn_hw_aes_available())) {
+        ctx->aes_impl = impl;
+        return 0;
+    }
+    return -1;
+}
+
 /* ── Extra hashes (final step: blake256 / groestl / jh256 / skein256) ── */
 
 static void cn_extra_blake(const uint8_t *input, size_t len, uint8_t *output)
@@ -418,6 +840,7 @@ cn_ctx *cn_alloc_ctx(void)
         return NULL;
     }
 #endif
+    ctx->aes_impl = cn_hw_aes_available() ? CN_AES_HW : CN_AES_SOFT;
     return ctx;
 }
 
@@ -443,6 +866,7 @@ void cryptonight_hash(const uint8_t *input, size_t size,
     }
 
     const cn_variant *v = &gr_variants[variant];
+    const cn_kernels *k = &cn_kernel_table[ctx->aes_impl];
 
     /* Step 1: Keccak-1600 → 200-byte state */
     gr_keccak(input, (int)size, ctx->state, 200);
@@ -457,87 +881,58 @@ void cryptonight_hash(const uint8_t *input, size_t size,
     if (v->half_mem) {
         ctx->first_half = 1;
     }
-    cn_explode_scratchpad(ctx, v);
+    k->explode(ctx, v);
 
     /* Step 4: Main loop */
-    uint64_t *h = (uint64_t *)ctx->state;
-    uint8_t *l = ctx->memory;
-    const uint32_t mask = v->mask;
-
-    uint64_t al0 = h[0] ^ h[4];
-    uint64_t ah0 = h[1] ^ h[5];
-    uint64_t idx0 = al0;
-
-    /* bx0 = (h[2]^h[6], h[3]^h[7]) as 128-bit value */
-    uint64_t bx0_lo = h[2] ^ h[6];
-    uint64_t bx0_hi = h[3] ^ h[7];
+    k->main_loop(ctx, v, tweak1_2);
 
-    for (uint32_t i = 0; i < v->iterations; i++) {
-        /* cx = aesenc(scratchpad[idx0 & mask], key=(al0, ah0)) */
-        uint8_t cx[16];
-        uint32_t aes_key[4];
-        memcpy(aes_key, &al0, 8);
-        memcpy(aes_key + 2, &ah0, 8);
-        cn_aes_round_to(&l[idx0 & mask], aes_key, cx);
+    /* Step 5: Implode scratchpad */
+    k->implode(ctx, v);
 
-        /* Store bx0 ^ cx at old address, with V1 tweak */
-        {
-            uint64_t cx_lo, cx_hi;
-            memcpy(&cx_lo, cx, 8);
-            memcpy(&cx_hi, cx + 8, 8);
-            uint64_t store_lo = bx0_lo ^ cx_lo;
-            uint64_t store_hi = bx0_hi ^ cx_hi;
+    /* Step 6: Keccak-f[1600] permutation */
+    gr_keccakf((uint64_t *)ctx->state, 24);
 
-            /* VARIANT1_1: tweak byte 11 of the stored block */
-            /* Byte 11 = byte 3 of store_hi (little-endian uint64_t) */
-            {
-                uint8_t *store_bytes = (uint8_t *)&store_hi;
-                uint8_t tmp = store_bytes[3];  /* byte 11 of 16-byte block */
-                uint8_t index = (((tmp >> 3) & 6) | (tmp & 1)) << 1;
-                store_bytes[3] = tmp ^ ((0x75310 >> index) & 0x30);
-            }
+    /* Step 7: Final hash (blake256/groestl/jh256/skein256) */
+    extra_hashes[ctx->state[0] & 3](ctx->state, 200, output);
+}
 
-            memcpy(&l[idx0 & mask], &store_lo, 8);
-            memcpy(&l[(idx0 & mask) + 8], &store_hi, 8);
+void cryptonight_hash_multi(const uint8_t *const inputs[], size_t size,
+                            uint8_t *const outputs[], cn_ctx *const ctxs[],
+                            int n, int variant)
+{
+    if (n == 1) {
+        cryptonight_hash(inputs[0], size, outputs[0], ctxs[0], variant);
+        return;
+    }
+    if (variant < 0 || variant > 5 || n < 1 || n > CN_MAX_LANES) {
+        for (int j = 0; j < n && j < CN_MAX_LANES; j++) {
+            memset(outputs[j], 0, 32);
         }
-
-        /* idx0 = low 64 bits of cx */
-        memcpy(&idx0, cx, 8);
-
-        /* Read (cl, ch) from new address */
-        uint64_t cl, ch;
-        memcpy(&cl, &l[idx0 & mask], 8);
-        memcpy(&ch, &l[(idx0 & mask) + 8], 8);
-
-        /* 128-bit multiply: (hi, lo) = idx0 * cl */
-        uint64_t hi_mul, lo_mul;
-        lo_mul = cn_umul128(idx0, cl, &hi_mul);
-
-        /* Update a registers */
-        al0 += hi_mul;
-        ah0 += lo_mul;
-
-        /* Store (al0, ah0 ^ tweak1_2) at new address */
-        memcpy(&l[idx0 & mask], &al0, 8);
-        uint64_t store_ah = ah0 ^ tweak1_2;
-        memcpy(&l[(idx0 & mask) + 8], &store_ah, 8);
-
-        /* XOR and update */
-        al0 ^= cl;
-        ah0 ^= ch;
-        idx0 = al0;
-
-        /* Update bx0 = cx */
-        memcpy(&bx0_lo, cx, 8);
-        memcpy(&bx0_hi, cx + 8, 8);
+        return;
     }
 
-    /* Step 5: Implode scratchpad */
-    cn_implode_scratchpad(ctx, v);
+    const cn_variant *v = &gr_variants[variant];
+    const cn_kernels *k = &cn_kernel_table[ctxs[0]->aes_impl];
+    uint64_t tweak1_2[CN_MAX_LANES];
+
+    /* Steps 1-3 per lane: Keccak, tweak init, explode */
+    for (int j = 0; j < n; j++) {
+        gr_keccak(inputs[j], (int)size, ctxs[j]->state, 200);
+        memcpy(&tweak1_2[j], inputs[j] + 35, 8);
+        tweak1_2[j] ^= ((uint64_t *)ctxs[j]->state)[24];
+        if (v->half_mem) {
+            ctxs[j]->first_half = 1;
+        }
+        k->explode(ctxs[j], v);
+    }
 
-    /* Step 6: Keccak-f[1600] permutation */
-    gr_keccakf((uint64_t *)ctx->state, 24);
+    /* Step 4: interleaved main loop */
+    k->main_loop_multi(ctxs, n, v, tweak1_2);
 
-    /* Step 7: Final hash (blake256/groestl/jh256/skein256) */
-    extra_hashes[ctx->state[0] & 3](ctx->state, 200, output);
+    /* Steps 5-7 per lane: implode, Keccak-f, final hash */
+    for (int j = 0; j < n; j++) {
+        k->implode(ctxs[j], v);
+        gr_keccakf((uint64_t *)ctxs[j]->state, 24);
+        extra_hashes[ctxs[j]->state[0] & 3](ctxs[j]->state, 200, outputs[j]);
+    }
 }
@@ -2,7 +2,8 @@
  * CryptoNight hash — standalone portable C implementation for GhostRider.
  *
  * Implements the 6 CN GR variants (all based on CN_1 / Monero V7).
- * Software AES only (T-table), no SSE/AES-NI intrinsics.
+ * AES rounds use AES-NI / ARMv8 Crypto Extension when available, with a
+ * software T-table fallback.
  *
  * Reference: XMRig CryptoNight_x86.h, CnAlgo.h
  */
@@ -20,17 +21,35 @@ extern "C" {
 /* Maximum scratchpad size across all GR variants (2 MB for CN_GR_2) */
 #define CN_MAX_MEMORY  0x200000
 
+/* Maximum number of hashes interleaved by cryptonight_hash_multi() */
+#define CN_MAX_LANES   4
+
 /* Per-thread context: holds 200-byte Keccak state + 2MB scratchpad */
 typedef struct {
     uint8_t state[200]   __attribute__((aligned(16)));
     uint8_t save_state[128] __attribute__((aligned(16)));
     uint8_t *memory;     /* scratchpad, CN_MAX_MEMORY bytes, 16-byte aligned */
     int first_half;
+    int aes_impl;        /* CN_AES_SOFT or CN_AES_HW */
 } cn_ctx;
 
+/* AES implementations for the CryptoNight rounds */
+#define CN_AES_SOFT 0    /* portable T-tables */
+#define CN_AES_HW   1    /* AES-NI on x86, Crypto Extension on ARMv8 */
+
+/* Allocates a context using CN_AES_HW if cn_hw_aes_available(), else CN_AES_SOFT. */
 cn_ctx *cn_alloc_ctx(void);
 void    cn_free_ctx(cn_ctx *ctx);
 
+/* Returns 1 if this build and CPU support CN_AES_HW. */
+int cn_hw_aes_available(void);
+
+/*
+ * Select the AES implementation used by ctx.  Both produce identical hashes.
+ * Returns 0 on success, -1 if impl is not available.
+ */
+int cn_set_aes_impl(cn_ctx *ctx, int impl);
+
 /*
  * Compute CryptoNight hash for a GhostRider variant.
  *
@@ -42,6 +61,18 @@ void    cn_free_ctx(cn_ctx *ctx);
 void cryptonight_hash(const uint8_t *input, size_t size,
                       uint8_t *output, cn_ctx *ctx, int variant);
 
+/*
+ * Compute n (1..CN_MAX_LANES) CryptoNight hashes of the same variant with
+ * interleaved main loops.  Results match n calls to cryptonight_hash().
+ *
+ * inputs:  n inputs of size bytes each
+ * outputs: n 32-byte output buffers
+ * ctxs:    n distinct contexts; all lanes use the AES implementation of ctxs[0]
+ */
+void cryptonight_hash_multi(const uint8_t *const inputs[], size_t size,
+                            uint8_t *const outputs[], cn_ctx *const ctxs[],
+                            int n, int variant);
+
 #ifdef __cplusplus
 }
 #endif
@@ -26,6 +26,7 @@
 #include "sph_fugue.h"
 #include "sph_shabal.h"
 #include "sph_whirlpool.h"
+#include "sph_x4.h"
 
 #include <string.h>
 #include <stdlib.h>
@@ -39,133 +40,128 @@
 /* 64-byte intermediate hash buffer (all SPH-512 hashes produce 64 bytes) */
 #define HASH_BUF_SIZE 64
 
-/* ---- SPH-512 core hash wrappers ---- */
-
-static void hash_blake512(const uint8_t* data, size_t len, uint8_t* out) {
-    sph_blake512_context ctx;
-    sph_blake512_init(&ctx);
-    sph_blake512(&ctx, data, len);
-    sph_blake512_close(&ctx, out);
-}
-
-static void hash_bmw512(const uint8_t* data, size_t len, uint8_t* out) {
-    sph_bmw512_context ctx;
-    sph_bmw512_init(&ctx);
-    sph_bmw512(&ctx, data, len);
-    sph_bmw512_close(&ctx, out);
-}
-
-static void hash_groestl512(const uint8_t* data, size_t len, uint8_t* out) {
-    sph_groestl512_context ctx;
-    sph_groestl512_init(&ctx);
-    sph_groestl512(&ctx, data, len);
-    sph_groestl512_close(&ctx, out);
-}
-
-static void hash_jh512(const uint8_t* data, size_t len, uint8_t* out) {
-    sph_jh512_context ctx;
-    sph_jh512_init(&ctx);
-    sph_jh512(&ctx, data, len);
-    sph_jh512_close(&ctx, out);
-}
-
-static void hash_keccak512(const uint8_t* data, size_t len, uint8_t* out) {
-    sph_keccak512_context ctx;
-    sph_keccak512_init(&ctx);
-    sph_keccak512(&ctx, data, len);
-    sph_keccak512_close(&ctx, out);
-}
-
-static void hash_skein512(const uint8_t* data, size_t len, uint8_t* out) {
-    sph_skein512_context ctx;
-    sph_skein512_init(&ctx);
-    sph_skein512(&ctx, data, len);
-    sph_skein512_close(&ctx, out);
-}
-
-static void hash_luffa512(const uint8_t* data, size_t len, uint8_t* out) {
-    sph_luffa512_context ctx;
-    sph_luffa512_init(&ctx);
-    sph_luffa512(&ctx, data, len);
-    sph_luffa512_close(&ctx, out);
-}
-
-static void hash_cubehash512(const uint8_t* data, size_t len, uint8_t* out) {
-    sph_cubehash512_context ctx;
-    sph_cubehash512_init(&ctx);
-    sph_cubehash512(&ctx, data, len);
-    sph_cubehash512_close(&ctx, out);
-}
-
-static void hash_shavite512(const uint8_t* data, size_t len, uint8_t* out) {
-    sph_shavite512_context ctx;
-    sph_shavite512_init(&ctx);
-    sph_shavite512(&ctx, data, len);
-    sph_shavite512_close(&ctx, out);
-}
+/* ---- SPH-512 core hashes ---- */
+
+/* Context large enough for any of the core hashes.  SPH contexts hold no
+ * pointers, so a partially absorbed context can be copied and resumed. */
+typedef union {
+    sph_blake512_context blake;
+    sph_bmw512_context bmw;
+    sph_groestl512_context groestl;
+    sph_jh512_context jh;
+    sph_keccak512_context keccak;
+    sph_skein512_context skein;
+    sph_luffa512_context luffa;
+    sph_cubehash512_context cubehash;
+    sph_shavite512_context shavite;
+    sph_simd512_context simd;
+    sph_echo512_context echo;
+    sph_hamsi512_context hamsi;
+    sph_fugue512_context fugue;
+    sph_shabal512_context shabal;
+    sph_whirlpool_context whirlpool;
+} core_hash_context;
+
+typedef struct {
+    size_t ctx_size;
+    void (*init)(void *cc);
+    void (*update)(void *cc, const void *data, size_t len);
+    void (*close)(void *cc, void *dst);
+    sph_x4_hash64_fn x4;  /* 4-way kernel for 64-byte inputs, or NULL */
+    int x4_features;      /* SPH_X4_* bits the kernel needs */
+} core_hash_ops;
+
+#define CORE_HASH(name, x4) \
+    { sizeof(sph_##name##_context), sph_##name##_init, sph_##name, sph_##name##_close, x4 }
+
+#ifdef SPH_X4_HAVE_AVX2
+#define CORE_X4(name) sph_##name##_x4_64, SPH_X4_AVX2
+#define CORE_X4_AES(name) sph_##name##_x4_64, SPH_X4_AVX2 | SPH_X4_AES
+#else
+#define CORE_X4(name) NULL, 0
+#define CORE_X4_AES(name) NULL, 0
+#endif
+#define CORE_NO_X4 NULL, 0
+
+static const core_hash_ops core_hashes[NUM_CORE_HASHES] = {
+    CORE_HASH(blake512, CORE_X4(blake512)),          /*  0 */
+    CORE_HASH(bmw512, CORE_X4(bmw512)),              /*  1 */
+    CORE_HASH(groestl512, CORE_X4_AES(groestl512)),  /*  2 */
+    CORE_HASH(jh512, CORE_NO_X4),                    /*  3 */
+    CORE_HASH(keccak512, CORE_X4(keccak512)),        /*  4 */
+    CORE_HASH(skein512, CORE_X4(skein512)),          /*  5 */
+    CORE_HASH(luffa512, CORE_X4(luffa512)),          /*  6 */
+    CORE_HASH(cubehash512, CORE_X4(cubehash512)),    /*  7 */
+    CORE_HASH(shavite512, CORE_X4_AES(shavite512)),  /*  8 */
+    CORE_HASH(simd512, CORE_NO_X4),                  /*  9 */
+    CORE_HASH(echo512, CORE_X4_AES(echo512)),        /* 10 */
+    CORE_HASH(hamsi512, CORE_NO_X4),                 /* 11 */
+    CORE_HASH(fugue512, CORE_NO_X4),                 /* 12 */
+    CORE_HASH(shabal512, CORE_X4(shabal512)),        /* 13 */
+    CORE_HASH(whirlpool, CORE_NO_X4),                /* 14 */
+};
 
-static void hash_simd512(const uint8_t* data, size_t len, uint8_t* out) {
-    sph_simd512_context ctx;
-    sph_simd512_init(&ctx);
-    sph_simd512(&ctx, data, len);
-    sph_simd512_close(&ctx, out);
+/* The 4-way kernel of ops if this CPU can run it, else NULL */
+static sph_x4_hash64_fn core_x4(const core_hash_ops *ops, int features)
+{
+    if (!ops->x4 || (ops->x4_features & ~features)) {
+        return NULL;
+    }
+    return ops->x4;
 }
 
-static void hash_echo512(const uint8_t* data, size_t len, uint8_t* out) {
-    sph_echo512_context ctx;
-    sph_echo512_init(&ctx);
-    sph_echo512(&ctx, data, len);
-    sph_echo512_close(&ctx, out);
+static void core_hash(const core_hash_ops *ops, const uint8_t *data, size_t len,
+                      uint8_t *out)
+{
+    core_hash_context cc;
+    ops->init(&cc);
+    ops->update(&cc, data, len);
+    ops->close(&cc, out);
 }
 
-static void hash_hamsi512(const uint8_t* data, size_t len, uint8_t* out) {
-    sph_hamsi512_context ctx;
-    sph_hamsi512_init(&ctx);
-    sph_hamsi512(&ctx, data, len);
-    sph_hamsi512_close(&ctx, out);
-}
+/*
+ * Hash n (1..4) 64-byte inputs with a 4-way kernel.  Unused lanes repeat
+ * lane 0 into a scratch buffer.  The kernels read all inputs before writing,
+ * so data[j] may alias out[j].
+ */
+static void core_hash_x4(sph_x4_hash64_fn fn, const uint8_t *const data[],
+                         uint8_t (*out)[HASH_BUF_SIZE], int n)
+{
+    uint8_t scratch[HASH_BUF_SIZE];
+    const uint8_t *in4[SPH_X4_LANES];
+    uint8_t *out4[SPH_X4_LANES];
 
-static void hash_fugue512(const uint8_t* data, size_t len, uint8_t* out) {
-    sph_fugue512_context ctx;
-    sph_fugue512_init(&ctx);
-    sph_fugue512(&ctx, data, len);
-    sph_fugue512_close(&ctx, out);
+    for (int j = 0; j < SPH_X4_LANES; j++) {
+        in4[j] = data[j < n ? j : 0];
+        out4[j] = j < n ? out[j] : scratch;
+    }
+    fn(in4, out4);
 }
 
-static void hash_shabal512(const uint8_t* data, size_t len, uint8_t* out) {
-    sph_shabal512_context ctx;
-    sph_shabal512_init(&ctx);
-    sph_shabal512(&ctx, data, len);
-    sph_shabal512_close(&ctx, out);
+/*
+ * Prefix contexts: absorb the nonce-independent bytes once, then finish a
+ * copy of that context per nonce.  Only ctx_size bytes of the union are
+ * live, so resuming copies no more than the selected hash's context.
+ */
+static void core_hash_prefix(const core_hash_ops *ops, core_hash_context *prefix,
+                             const uint8_t *data, size_t len)
+{
+    ops->init(prefix);
+    ops->update(prefix, data, len);
 }
 
-static void hash_whirlpool(const uint8_t* data, size_t len, uint8_t* out) {
-    sph_whirlpool_context ctx;
-    sph_whirlpool_init(&ctx);
-    sph_whirlpool(&ctx, data, len);
-    sph_whirlpool_close(&ctx, out);
+static void core_hash_resume(const core_hash_ops *ops,
+                             const core_hash_context *prefix,
+                             const uint8_t nonce_le[4],
+                             const uint8_t *rest, size_t rest_len, uint8_t *out)
+{
+    core_hash_context cc;
+    memcpy(&cc, prefix, ops->ctx_size);
+    ops->update(&cc, nonce_le, 4);
+    ops->update(&cc, rest, rest_len);
+    ops->close(&cc, out);
 }
 
-typedef void (*core_hash_fn)(const uint8_t*, size_t, uint8_t*);
-
-static const core_hash_fn core_hashes[NUM_CORE_HASHES] = {
-    hash_blake512,     /*  0 */
-    hash_bmw512,       /*  1 */
-    hash_groestl512,   /*  2 */
-    hash_jh512,        /*  3 */
-    hash_keccak512,    /*  4 */
-    hash_skein512,     /*  5 */
-    hash_luffa512,     /*  6 */
-    hash_cubehash512,  /*  7 */
-    hash_shavite512,   /*  8 */
-    hash_simd512,      /*  9 */
-    hash_echo512,      /* 10 */
-    hash_hamsi512,     /* 11 */
-    hash_fugue512,     /* 12 */
-    hash_shabal512,    /* 13 */
-    hash_whirlpool,    /* 14 */
-};
-
 /* ---- Index selection (matching XMRig ghostrider.cpp select_indices) ---- */
 
 /*
@@ -208,8 +204,102 @@ void ghostrider_free_ctx(void *ctx)
     cn_free_ctx((cn_ctx *)ctx);
 }
 
+/* ---- Per-block schedule ---- */
+
+/*
+ * The SPH and CryptoNight order derives from the seed only, so it is fixed
+ * for every nonce of a job.
+ */
+typedef struct {
+    const core_hash_ops *core[NUM_CORE_HASHES];
+    sph_x4_hash64_fn core_x4[NUM_CORE_HASHES];  /* NULL: no kernel for this CPU */
+    int cn_variants[3];
+} gr_schedule;
+
+static void build_schedule(gr_schedule *sched, const uint8_t *seed)
+{
+    uint32_t core_indices[NUM_CORE_HASHES];
+    uint32_t cn_indices[NUM_CN_VARIANTS];
+    select_indices(core_indices, NUM_CORE_HASHES, seed);
+    select_indices(cn_indices, NUM_CN_VARIANTS, seed);
+
+    const int x4_features = sph_x4_available();
+    for (int i = 0; i < NUM_CORE_HASHES; i++) {
+        sched->core[i] = &core_hashes[core_indices[i]];
+        sched->core_x4[i] = core_x4(sched->core[i], x4_features);
+    }
+    for (int part = 0; part < 3; part++) {
+        sched->cn_variants[part] = (int)cn_indices[part];
+    }
+}
+
 /* ---- Full GhostRider hash ---- */
 
+/*
+ * Hash n inputs of input_len bytes that share the same schedule, so all
+ * lanes run the same variants and their CryptoNight rounds can be
+ * interleaved.  The first `skip` core hashes are taken as already applied:
+ * the inputs are then their 64-byte results.
+ */
+static void ghostrider_hash_lanes(const gr_schedule *sched,
+                                  const uint8_t *const inputs[], size_t input_len,
+                                  uint8_t *const outputs[], cn_ctx *const ctxs[],
+                                  int n, int skip)
+{
+    uint8_t tmp[CN_MAX_LANES][HASH_BUF_SIZE];
+    const uint8_t *data[CN_MAX_LANES];
+
+    /* 3-part pipeline: each part = 5 SPH core hashes + 1 CryptoNight hash */
+    for (int part = 0; part < 3; part++) {
+        size_t data_size = part == 0 ? input_len : HASH_BUF_SIZE;
+        for (int j = 0; j < n; j++) {
+            data[j] = part == 0 ? inputs[j] : tmp[j];
+        }
+
+        /* Chain 5 SPH-512 core hashes, all lanes at once where a kernel exists */
+        for (int i = part == 0 ? skip : 0; i < 5; i++) {
+            const int k = part * 5 + i;
+            if (n > 1 && data_size == HASH_BUF_SIZE && sched->core_x4[k]) {
+                core_hash_x4(sched->core_x4[k], data, tmp, n);
+            } else {
+                for (int j = 0; j < n; j++) {
+                    uint8_t next[HASH_BUF_SIZE];
+                    core_hash(sched->core[k], data[j], data_size, next);
+                    memcpy(tmp[j], next, HASH_BUF_SIZE);
+                }
+            }
+            for (int j = 0; j < n; j++) {
+                data[j] = tmp[j];
+            }
+            data_size = HASH_BUF_SIZE;
+        }
+
+        /* 1 CryptoNight hash per lane: 64 bytes in → 32 bytes out */
+        cryptonight_hash_multi(data, HASH_BUF_SIZE, outputs, ctxs, n,
+                               sched->cn_variants[part]);
+
+        /* Prepare input for next part: 32 bytes of CN output + 32 zero bytes */
+        for (int j = 0; j < n; j++) {
+            memcpy(tmp[j], outputs[j], 32);
+            memset(tmp[j] + 32, 0, 32);
+        }
+    }
+}
+
+/*
+ * The interleaved CryptoNight rounds run one set of AES kernels for all
+ * lanes, so every context of a batch must use the same AES implementation.
+ */
+static int same_aes_impl(cn_ctx *const ctxs[], size_t n)
+{
+    for (size_t j = 1; j < n; j++) {
+        if (ctxs[j]->aes_impl != ctxs[0]->aes_impl) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
 int ghostrider_hash(const uint8_t *input, size_t input_len,
                     uint8_t *output, void *ctx)
 {
@@ -218,40 +308,160 @@ int ghostrider_hash(const uint8_t *input, size_t input_len,
     }
 
     /* Seed is the PrevBlockHash at input[4..36] */
-    const uint8_t *seed = input + 4;
+    gr_schedule sched;
+    build_schedule(&sched, input + 4);
 
-    /* Select permutation for 15 core hashes and 6 CN variants */
-    uint32_t core_indices[NUM_CORE_HASHES];
-    uint32_t cn_indices[NUM_CN_VARIANTS];
-    select_indices(core_indices, NUM_CORE_HASHES, seed);
-    select_indices(cn_indices, NUM_CN_VARIANTS, seed);
+    cn_ctx *cn = (cn_ctx *)ctx;
+    ghostrider_hash_lanes(&sched, &input, input_len, &output, &cn, 1, 0);
+    return 0;
+}
+
+int ghostrider_hash_multi(const uint8_t *inputs, size_t input_len, size_t n,
+                          uint8_t *outputs, void *const *ctx)
+{
+    if (!inputs || !outputs || !ctx || input_len < 43 || n < 1 || n > CN_MAX_LANES) {
+        return -1;
+    }
 
-    uint8_t tmp[HASH_BUF_SIZE];
-    const uint8_t *data = input;
-    size_t data_size = input_len;
+    const uint8_t *lane_inputs[CN_MAX_LANES];
+    uint8_t *lane_outputs[CN_MAX_LANES];
+    cn_ctx *lane_ctxs[CN_MAX_LANES];
 
-    /* 3-part pipeline: each part = 5 SPH core hashes + 1 CryptoNight hash */
-    for (int part = 0; part < 3; part++) {
-        /* Chain 5 SPH-512 core hashes */
-        for (int i = 0; i < 5; i++) {
-            uint8_t next[HASH_BUF_SIZE];
-            core_hashes[core_indices[part * 5 + i]](data, data_size, next);
-            memcpy(tmp, next, HASH_BUF_SIZE);
-            data = tmp;
-            data_size = HASH_BUF_SIZE;
+    for (size_t j = 0; j < n; j++) {
+        lane_inputs[j] = inputs + j * input_len;
+        lane_outputs[j] = outputs + j * 32;
+        lane_ctxs[j] = (cn_ctx *)ctx[j];
+        if (!lane_ctxs[j] || memcmp(lane_inputs[j] + 4, inputs + 4, 32) != 0) {
+            return -1;
         }
+    }
+    if (!same_aes_impl(lane_ctxs, n)) {
+        return -1;
+    }
 
-        /* 1 CryptoNight hash: 64 bytes in → 32 bytes out */
-        cryptonight_hash(tmp, HASH_BUF_SIZE, output, (cn_ctx *)ctx,
-                         (int)cn_indices[part]);
+    gr_schedule sched;
+    build_schedule(&sched, inputs + 4);
+    ghostrider_hash_lanes(&sched, lane_inputs, input_len, lane_outputs, lane_ctxs,
+                          (int)n, 0);
+    return 0;
+}
 
-        /* Prepare input for next part: 32 bytes of CN output + 32 zero bytes */
-        memcpy(tmp, output, 32);
-        memset(tmp + 32, 0, 32);
-        data = tmp;
-        data_size = HASH_BUF_SIZE;
+/* ---- Job-level hashing ---- */
+
+/*
+ * Everything about a job that does not depend on the nonce: the resolved
+ * schedule and the first core hash after absorbing the blob up to the nonce.
+ */
+struct gr_job {
+    gr_schedule sched;
+    core_hash_context midstate;
+    size_t nonce_offset;
+    size_t input_len;
+    uint8_t input[];
+};
+
+gr_job *ghostrider_prepare_job(const uint8_t *input, size_t input_len,
+                               size_t nonce_offset)
+{
+    if (!input || input_len < 43 || nonce_offset > input_len - 4) {
+        return NULL;
+    }
+
+    /* The schedule is fixed per job, so the nonce must not touch the seed */
+    if (nonce_offset + 4 > 4 && nonce_offset < 36) {
+        return NULL;
+    }
+
+    gr_job *job = (gr_job *)malloc(sizeof(gr_job) + input_len);
+    if (!job) {
+        return NULL;
+    }
+
+    build_schedule(&job->sched, input + 4);
+    core_hash_prefix(job->sched.core[0], &job->midstate, input, nonce_offset);
+    job->nonce_offset = nonce_offset;
+    job->input_len = input_len;
+    memcpy(job->input, input, input_len);
+    return job;
+}
+
+static void store_nonce_le(uint8_t out[4], uint32_t nonce)
+{
+    out[0] = (uint8_t)nonce;
+    out[1] = (uint8_t)(nonce >> 8);
+    out[2] = (uint8_t)(nonce >> 16);
+    out[3] = (uint8_t)(nonce >> 24);
+}
+
+int ghostrider_hash_job(const gr_job *job, uint32_t nonce, uint8_t *output,
+                        void *ctx)
+{
+    uint32_t nonces[1] = { nonce };
+    void *ctxs[1] = { ctx };
+    return ghostrider_hash_job_multi(job, nonces, 1, output, ctxs);
+}
+
+int ghostrider_hash_job_multi(const gr_job *job, const uint32_t *nonces, size_t n,
+                              uint8_t *outputs, void *const *ctx)
+{
+    if (!job || !nonces || !outputs || !ctx || n < 1 || n > CN_MAX_LANES) {
+        return -1;
+    }
+
+    const size_t rest = job->nonce_offset + 4;
+    uint8_t hashes[CN_MAX_LANES][HASH_BUF_SIZE];
+    const uint8_t *lane_inputs[CN_MAX_LANES];
+    uint8_t *lane_outputs[CN_MAX_LANES];
+    cn_ctx *lane_ctxs[CN_MAX_LANES];
+
+    for (size_t j = 0; j < n; j++) {
+        lane_ctxs[j] = (cn_ctx *)ctx[j];
+        if (!lane_ctxs[j]) {
+            return -1;
+        }
+    }
+    if (!same_aes_impl(lane_ctxs, n)) {
+        return -1;
     }
 
+    /* Finish the first core hash of each lane from the job's prefix context */
+    for (size_t j = 0; j < n; j++) {
+        uint8_t nonce_le[4];
+        store_nonce_le(nonce_le, nonces[j]);
+        core_hash_resume(job->sched.core[0], &job->midstate, nonce_le,
+                         job->input + rest, job->input_len - rest, hashes[j]);
+        lane_inputs[j] = hashes[j];
+        lane_outputs[j] = outputs + j * 32;
+    }
+
+    ghostrider_hash_lanes(&job->sched, lane_inputs, HASH_BUF_SIZE, lane_outputs,
+                          lane_ctxs, (int)n, 1);
+    return 0;
+}
+
+void ghostrider_free_job(gr_job *job)
+{
+    free(job);
+}
+
+/* ---- CryptoNight AES implementation and single CN hash (for testing) ---- */
+
+int ghostrider_set_aes_impl(void *ctx, int impl)
+{
+    if (!ctx) {
+        return -1;
+    }
+    return cn_set_aes_impl((cn_ctx *)ctx, impl);
+}
+
+int ghostrider_cn_hash(int variant, const uint8_t *input, size_t input_len,
+                       uint8_t *output, void *ctx)
+{
+    if (variant < 0 || variant >= NUM_CN_VARIANTS || !input || !output || !ctx ||
+        input_len < 43) {
+        return -1;
+    }
+    cryptonight_hash(input, input_len, output, (cn_ctx *)ctx, variant);
     return 0;
 }
 
@@ -263,6 +473,29 @@ int ghostrider_sph_hash(int algo_index, const uint8_t *input,
     if (algo_index < 0 || algo_index >= NUM_CORE_HASHES || !input || !output) {
         return -1;
     }
-    core_hashes[algo_index](input, input_len, output);
+    core_hash(&core_hashes[algo_index], input, input_len, output);
+    return 0;
+}
+
+int ghostrider_sph_hash_x4(int algo_index, const uint8_t *inputs, uint8_t *outputs)
+{
+    if (algo_index < 0 || algo_index >= NUM_CORE_HASHES || !inputs || !outputs) {
+        return -1;
+    }
+    const sph_x4_hash64_fn fn = core_x4(&core_hashes[algo_index], sph_x4_available());
+    if (!fn) {
+        return -1;
+    }
+
+    const uint8_t *data[SPH_X4_LANES];
+    for (int j = 0; j < SPH_X4_LANES; j++) {
+        data[j] = inputs + j * HASH_BUF_SIZE;
+    }
+    core_hash_x4(fn, data, (uint8_t (*)[HASH_BUF_SIZE])outputs, SPH_X4_LANES);
     return 0;
 }
+
+int ghostrider_sph_x4_features(void)
+{
+    return sph_x4_available();
+}
@@ -38,6 +38,103 @@ void ghostrider_free_ctx(void *ctx);
 int ghostrider_hash(const uint8_t *input, size_t input_len,
                     uint8_t *output, void *ctx);
 
+/**
+ * Compute n GhostRider hashes with interleaved CryptoNight rounds.
+ *
+ * All inputs must share the same seed (bytes 4..36, the PrevBlockHash),
+ * which fixes the algorithm order for every lane; mining nonces of one job
+ * qualifies.  Results match n calls to ghostrider_hash().
+ *
+ * @param inputs    n input blobs of input_len bytes each, back to back.
+ * @param input_len Length of each input in bytes (must be >= 43).
+ * @param n         Number of hashes, 1 to 4.
+ * @param outputs   n * 32-byte output buffer.
+ * @param ctx       n distinct contexts from ghostrider_alloc_ctx(), all with
+ *                  the same AES implementation (ghostrider_set_aes_impl()).
+ * @return          0 on success, non-zero on error (including mismatched seeds
+ *                  or AES implementations).
+ */
+int ghostrider_hash_multi(const uint8_t *inputs, size_t input_len, size_t n,
+                          uint8_t *outputs, void *const *ctx);
+
+/** Opaque per-job state, see ghostrider_prepare_job(). */
+typedef struct gr_job gr_job;
+
+/**
+ * Prepare a job for repeated hashing with different nonces.
+ *
+ * Resolves the algorithm order from the seed (bytes 4..36) once and
+ * absorbs the blob bytes before the nonce into the first core hash.
+ * For an 80-byte stratum header the nonce is at offset 76.
+ *
+ * @param input        Job blob (nonce bytes are ignored).
+ * @param input_len    Length of input in bytes (must be >= 43).
+ * @param nonce_offset Offset of the little-endian 32-bit nonce in input.
+ *                     The nonce must not overlap the seed (bytes 4..36).
+ * @return             Job handle, or NULL on error or allocation failure.
+ *                     Free with ghostrider_free_job().
+ */
+gr_job *ghostrider_prepare_job(const uint8_t *input, size_t input_len,
+                               size_t nonce_offset);
+
+/**
+ * Compute the GhostRider hash of a prepared job with the given nonce.
+ * Matches ghostrider_hash() on the blob with the nonce written in.
+ *
+ * @param job    Job from ghostrider_prepare_job().
+ * @param nonce  Nonce value, stored little-endian at the job's nonce offset.
+ * @param output 32-byte output buffer for the final hash.
+ * @param ctx    Context from ghostrider_alloc_ctx().
+ * @return       0 on success, non-zero on error.
+ */
+int ghostrider_hash_job(const gr_job *job, uint32_t nonce, uint8_t *output,
+                        void *ctx);
+
+/**
+ * Compute n GhostRider hashes of a prepared job with interleaved
+ * CryptoNight rounds.  Results match n calls to ghostrider_hash_job().
+ *
+ * @param job     Job from ghostrider_prepare_job().
+ * @param nonces  n nonce values.
+ * @param n       Number of hashes, 1 to 4.
+ * @param outputs n * 32-byte output buffer.
+ * @param ctx     n distinct contexts from ghostrider_alloc_ctx(), all with
+ *                the same AES implementation (ghostrider_set_aes_impl()).
+ * @return        0 on success, non-zero on error (including mismatched AES
+ *                implementations).
+ */
+int ghostrider_hash_job_multi(const gr_job *job, const uint32_t *nonces, size_t n,
+                              uint8_t *outputs, void *const *ctx);
+
+/**
+ * Free a job previously returned by ghostrider_prepare_job().
+ */
+void ghostrider_free_job(gr_job *job);
+
+/**
+ * Select the AES implementation used by a context's CryptoNight rounds.
+ * New contexts use hardware AES when the CPU supports it.
+ *
+ * @param ctx  Context from ghostrider_alloc_ctx().
+ * @param impl 0 = software (T-tables), 1 = hardware (AES-NI / ARMv8 CE).
+ * @return     0 on success, non-zero if the implementation is not available.
+ */
+int ghostrider_set_aes_impl(void *ctx, int impl);
+
+/**
+ * Compute a single CryptoNight hash of one GhostRider variant (for testing).
+ *
+ * @param variant   CN variant (0=dark, 1=dark-lite, 2=fast, 3=lite,
+ *                  4=turtle, 5=turtle-lite).
+ * @param input     Input data.
+ * @param input_len Length of input in bytes (must be >= 43).
+ * @param output    32-byte output buffer.
+ * @param ctx       Context from ghostrider_alloc_ctx().
+ * @return          0 on success, non-zero on error.
+ */
+int ghostrider_cn_hash(int variant, const uint8_t *input, size_t input_len,
+                       uint8_t *output, void *ctx);
+
 /**
  * Compute individual SPH-512 hash (for testing/verification).
  *
@@ -50,6 +147,26 @@ int ghostrider_hash(const uint8_t *input, size_t input_len,
 int ghostrider_sph_hash(int algo_index, const uint8_t *input,
                         size_t input_len, uint8_t *output);
 
+/**
+ * Compute four SPH-512 hashes of 64-byte inputs with the multi-buffer
+ * kernel (for testing/verification against ghostrider_sph_hash()).
+ *
+ * @param algo_index Hash algorithm index (0=blake, 1=bmw, ... 14=whirlpool)
+ * @param inputs     4 * 64-byte inputs, back to back.
+ * @param outputs    4 * 64-byte output buffer.
+ * @return           0 on success, non-zero if the algorithm has no
+ *                   multi-buffer kernel or the CPU lacks its features.
+ */
+int ghostrider_sph_hash_x4(int algo_index, const uint8_t *inputs, uint8_t *outputs);
+
+/**
+ * CPU features usable by the multi-buffer kernels (for testing).
+ *
+ * @return Bit 0: AVX2 (blake, bmw, keccak, skein, luffa, cubehash, shabal).
+ *         Bit 1: AES-NI (with AVX2: groestl, shavite, echo).  0 if none.
+ */
+int ghostrider_sph_x4_features(void);
+
 #ifdef __cplusplus
 }
 #endif
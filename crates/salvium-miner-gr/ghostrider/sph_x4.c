@@ -0,0 +1,1430 @@
+/*
+ * 4-way multi-buffer SPH-512 kernels (AVX2, AES-NI) for 64-byte messages.
+ *
+ * Each 256-bit register holds the same state word of four independent
+ * hashes, so the round functions are the scalar ones with every operation
+ * widened to four lanes.  Messages are always exactly 64 bytes, which
+ * fixes the padding and length blocks at compile time.
+ *
+ * Reference: sph_blake.c, sph_bmw.c, sph_keccak.c, sph_skein.c,
+ *            sph_cubehash.c, sph_luffa.c, sph_shabal.c, sph_echo.c,
+ *            sph_groestl.c, sph_shavite.c (same algorithms, same outputs)
+ */
+
+#include "sph_x4.h"
+
+#ifdef SPH_X4_HAVE_AVX2
+
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#include <stdatomic.h>
+#endif
+
+#if defined(_MSC_VER)
+#define SPH_X4_INLINE __forceinline
+#define SPH_X4_TARGET
+#define SPH_X4_TARGET_AES
+#else
+#define SPH_X4_INLINE inline __attribute__((always_inline))
+#define SPH_X4_TARGET __attribute__((target("avx2")))
+#define SPH_X4_TARGET_AES __attribute__((target("avx2,aes")))
+#endif
+
+/*
+ * Fully unroll the loops over state words so every index is a constant and
+ * the state stays in registers instead of an array on the stack.
+ */
+#if defined(__clang__)
+#define SPH_X4_UNROLL _Pragma("unroll")
+#elif defined(__GNUC__) && __GNUC__ >= 8
+#define SPH_X4_UNROLL _Pragma("GCC unroll 32")
+#else
+#define SPH_X4_UNROLL
+#endif
+
+/* ── CPU feature detection ── */
+
+static int sph_x4_detect(void)
+{
+    int features;
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    if (!((info[2] >> 27) & 1) || !((info[2] >> 28) & 1)) return 0;  /* OSXSAVE, AVX */
+    if ((_xgetbv(0) & 6) != 6) return 0;                              /* XMM + YMM state */
+    features = ((info[2] >> 25) & 1) ? SPH_X4_AES : 0;                /* AES-NI */
+    __cpuidex(info, 7, 0);
+    if (!((info[1] >> 5) & 1)) return 0;                              /* AVX2 */
+#else
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return 0;
+    if (!((ecx >> 27) & 1) || !((ecx >> 28) & 1)) return 0;          /* OSXSAVE, AVX */
+    features = ((ecx >> 25) & 1) ? SPH_X4_AES : 0;                    /* AES-NI */
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    if ((eax & 6) != 6) return 0;                                     /* XMM + YMM state */
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) return 0;
+    if (!((ebx >> 5) & 1)) return 0;                                  /* AVX2 */
+#endif
+    return features | SPH_X4_AVX2;
+}
+
+/*
+ * Called once per GhostRider schedule.  CPUID traps to the hypervisor in
+ * virtual machines, so the result is cached in an atomic; racing first
+ * calls store the same value, so relaxed ordering is enough.
+ */
+#if defined(_MSC_VER)
+static volatile long sph_x4_cached = -1;
+#define SPH_X4_CACHED_LOAD()   _InterlockedOr(&sph_x4_cached, 0)
+#define SPH_X4_CACHED_STORE(v) _InterlockedExchange(&sph_x4_cached, (v))
+#else
+static _Atomic int sph_x4_cached = -1;
+#define SPH_X4_CACHED_LOAD()   atomic_load_explicit(&sph_x4_cached, memory_order_relaxed)
+#define SPH_X4_CACHED_STORE(v) atomic_store_explicit(&sph_x4_cached, (v), memory_order_relaxed)
+#endif
+
+int sph_x4_available(void)
+{
+    int features = (int)SPH_X4_CACHED_LOAD();
+    if (features < 0) {
+        features = sph_x4_detect();
+        SPH_X4_CACHED_STORE(features);
+    }
+    return features;
+}
+
+/* ── Lane helpers ── */
+
+static SPH_X4_TARGET SPH_X4_INLINE __m256i x4_set1(uint64_t v)
+{
+    return _mm256_set1_epi64x((long long)v);
+}
+
+static SPH_X4_TARGET SPH_X4_INLINE __m256i x4_add(__m256i a, __m256i b)
+{
+    return _mm256_add_epi64(a, b);
+}
+
+static SPH_X4_TARGET SPH_X4_INLINE __m256i x4_sub(__m256i a, __m256i b)
+{
+    return _mm256_sub_epi64(a, b);
+}
+
+static SPH_X4_TARGET SPH_X4_INLINE __m256i x4_xor(__m256i a, __m256i b)
+{
+    return _mm256_xor_si256(a, b);
+}
+
+static SPH_X4_TARGET SPH_X4_INLINE __m256i x4_shl(__m256i x, int n)
+{
+    return _mm256_sll_epi64(x, _mm_cvtsi32_si128(n));
+}
+
+static SPH_X4_TARGET SPH_X4_INLINE __m256i x4_shr(__m256i x, int n)
+{
+    return _mm256_srl_epi64(x, _mm_cvtsi32_si128(n));
+}
+
+static SPH_X4_TARGET SPH_X4_INLINE __m256i x4_rol(__m256i x, int n)
+{
+    return _mm256_or_si256(x4_shl(x, n), x4_shr(x, 64 - n));
+}
+
+static SPH_X4_TARGET SPH_X4_INLINE __m256i x4_bswap(__m256i x)
+{
+    const __m256i mask = _mm256_set_epi8(
+        8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7,
+        8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7);
+    return _mm256_shuffle_epi8(x, mask);
+}
+
+/* 4x4 transpose of 64-bit words: row r of the input is lane r's words */
+static SPH_X4_TARGET SPH_X4_INLINE void x4_transpose(__m256i a, __m256i b, __m256i c,
+                                                     __m256i d, __m256i w[4])
+{
+    const __m256i t0 = _mm256_unpacklo_epi64(a, b);
+    const __m256i t1 = _mm256_unpackhi_epi64(a, b);
+    const __m256i t2 = _mm256_unpacklo_epi64(c, d);
+    const __m256i t3 = _mm256_unpackhi_epi64(c, d);
+    w[0] = _mm256_permute2x128_si256(t0, t2, 0x20);
+    w[1] = _mm256_permute2x128_si256(t1, t3, 0x20);
+    w[2] = _mm256_permute2x128_si256(t0, t2, 0x31);
+    w[3] = _mm256_permute2x128_si256(t1, t3, 0x31);
+}
+
+/* Load the 8 little-endian 64-bit words of each lane's message */
+static SPH_X4_TARGET SPH_X4_INLINE void x4_load_le64(const uint8_t *const in[4], __m256i w[8])
+{
+    SPH_X4_UNROLL
+    for (int k = 0; k < 2; k++) {
+        x4_transpose(_mm256_loadu_si256((const __m256i *)(in[0] + 32 * k)),
+                     _mm256_loadu_si256((const __m256i *)(in[1] + 32 * k)),
+                     _mm256_loadu_si256((const __m256i *)(in[2] + 32 * k)),
+                     _mm256_loadu_si256((const __m256i *)(in[3] + 32 * k)),
+                     w + 4 * k);
+    }
+}
+
+static SPH_X4_TARGET SPH_X4_INLINE void x4_store_le64(uint8_t *const out[4], const __m256i w[8])
+{
+    SPH_X4_UNROLL
+    for (int k = 0; k < 2; k++) {
+        __m256i rows[4];
+        x4_transpose(w[4 * k], w[4 * k + 1], w[4 * k + 2], w[4 * k + 3], rows);
+        SPH_X4_UNROLL
+        for (int j = 0; j < 4; j++) {
+            _mm256_storeu_si256((__m256i *)(out[j] + 32 * k), rows[j]);
+        }
+    }
+}
+
+/* ── 32-bit lane helpers (four words per 128-bit register) ── */
+
+static SPH_X4_TARGET SPH_X4_INLINE __m128i x4_rol32(__m128i x, int n)
+{
+    return _mm_or_si128(_mm_sll_epi32(x, _mm_cvtsi32_si128(n)),
+                        _mm_srl_epi32(x, _mm_cvtsi32_si128(32 - n)));
+}
+
+static SPH_X4_TARGET SPH_X4_INLINE __m128i x4_not32(__m128i x)
+{
+    return _mm_xor_si128(x, _mm_set1_epi32(-1));
+}
+
+static SPH_X4_TARGET SPH_X4_INLINE __m128i x4_bswap32(__m128i x)
+{
+    const __m128i mask = _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    return _mm_shuffle_epi8(x, mask);
+}
+
+/* 4x4 transpose of 32-bit words */
+static SPH_X4_TARGET SPH_X4_INLINE void x4_transpose32(__m128i a, __m128i b, __m128i c,
+                                                       __m128i d, __m128i w[4])
+{
+    const __m128i t0 = _mm_unpacklo_epi32(a, b);
+    const __m128i t1 = _mm_unpackhi_epi32(a, b);
+    const __m128i t2 = _mm_unpacklo_epi32(c, d);
+    const __m128i t3 = _mm_unpackhi_epi32(c, d);
+    w[0] = _mm_unpacklo_epi64(t0, t2);
+    w[1] = _mm_unpackhi_epi64(t0, t2);
+    w[2] = _mm_unpacklo_epi64(t1, t3);
+    w[3] = _mm_unpackhi_epi64(t1, t3);
+}
+
+/* Load the 16 little-endian 32-bit words of each lane's message */
+static SPH_X4_TARGET SPH_X4_INLINE void x4_load_le32(const uint8_t *const in[4], __m128i w[16])
+{
+    SPH_X4_UNROLL
+    for (int k = 0; k < 4; k++) {
+        x4_transpose32(_mm_loadu_si128((const __m128i *)(in[0] + 16 * k)),
+                       _mm_loadu_si128((const __m128i *)(in[1] + 16 * k)),
+                       _mm_loadu_si128((const __m128i *)(in[2] + 16 * k)),
+                       _mm_loadu_si128((const __m128i *)(in[3] + 16 * k)),
+                       w + 4 * k);
+    }
+}
+
+static SPH_X4_TARGET SPH_X4_INLINE void x4_store_le32(uint8_t *const out[4], const __m128i w[16])
+{
+    SPH_X4_UNROLL
+    for (int k = 0; k < 4; k++) {
+        __m128i rows[4];
+        x4_transpose32(w[4 * k], w[4 * k + 1], w[4 * k + 2], w[4 * k + 3], rows);
+        SPH_X4_UNROLL
+        for (int j = 0; j < 4; j++) {
+            _mm_storeu_si128((__m128i *)(out[j] + 16 * k), rows[j]);
+        }
+    }
+}
+
+/* ── BLAKE-512 ── */
+
+static const uint64_t blake_iv[8] = {
+    0x6A09E667F3BCC908ULL, 0xBB67AE8584CAA73BULL, 0x3C6EF372FE94F82BULL, 0xA54FF53A5F1D36F1ULL,
+    0x510E527FADE682D1ULL, 0x9B05688C2B3E6C1FULL, 0x1F83D9ABFB41BD6BULL, 0x5BE0CD19137E2179ULL,
+};
+
+static const uint64_t blake_cb[16] = {
+    0x243F6A8885A308D3ULL, 0x13198A2E03707344ULL, 0xA4093822299F31D0ULL, 0x082EFA98EC4E6C89ULL,
+    0x452821E638D01377ULL, 0xBE5466CF34E90C6CULL, 0xC0AC29B7C97C50DDULL, 0x3F84D5B5B5470917ULL,
+    0x9216D5D98979FB1BULL, 0xD1310BA698DFB5ACULL, 0x2FFD72DBD01ADFB7ULL, 0xB8E1AFED6A267E96ULL,
+    0xBA7C9045F12C7F99ULL, 0x24A19947B3916CF7ULL, 0x0801F2E2858EFC16ULL, 0x636920D871574E69ULL,
+};
+
+static const uint8_t blake_sigma[16][16] = {
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+    { 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 },
+    { 11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4 },
+    {  7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8 },
+    {  9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13 },
+    {  2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9 },
+    { 12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11 },
+    { 13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10 },
+    {  6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5 },
+    { 10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13,  0 },
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+    { 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 },
+    { 11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4 },
+    {  7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8 },
+    {  9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13 },
+    {  2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9 },
+};
+
+static SPH_X4_TARGET SPH_X4_INLINE void blake_g(__m256i v[16], const __m256i m[16],
+                                                const uint8_t *s, int a, int b, int c, int d)
+{
+    v[a] = x4_add(x4_add(v[a], v[b]), x4_xor(m[s[0]], x4_set1(blake_cb[s[1]])));
+    v[d] = _mm256_shuffle_epi32(x4_xor(v[d], v[a]), 0xB1);  /* ror 32 */
+    v[c] = x4_add(v[c], v[d]);
+    v[b] = x4_rol(x4_xor(v[b], v[c]), 64 - 25);
+    v[a] = x4_add(x4_add(v[a], v[b]), x4_xor(m[s[1]], x4_set1(blake_cb[s[0]])));
+    v[d] = x4_rol(x4_xor(v[d], v[a]), 64 - 16);
+    v[c] = x4_add(v[c], v[d]);
+    v[b] = x4_rol(x4_xor(v[b], v[c]), 64 - 11);
+}
+
+SPH_X4_TARGET void sph_blake512_x4_64(const uint8_t *const in[4], uint8_t *const out[4])
+{
+    __m256i m[16], v[16], h[8];
+
+    /* One 128-byte block: message, 0x80, final-bit 1, 128-bit length 512 */
+    x4_load_le64(in, m);
+    SPH_X4_UNROLL
+    for (int i = 0; i < 8; i++) {
+        m[i] = x4_bswap(m[i]);
+    }
+    SPH_X4_UNROLL
+    for (int i = 8; i < 16; i++) {
+        m[i] = _mm256_setzero_si256();
+    }
+    m[8] = x4_set1(0x8000000000000000ULL);
+    m[13] = x4_set1(1);
+    m[15] = x4_set1(512);
+
+    SPH_X4_UNROLL
+    for (int i = 0; i < 8; i++) {
+        v[i] = x4_set1(blake_iv[i]);
+        v[i + 8] = x4_set1(blake_cb[i]);
+    }
+    v[12] = x4_xor(v[12], x4_set1(512));
+    v[13] = x4_xor(v[13], x4_set1(512));
+
+    SPH_X4_UNROLL
+    for (int r = 0; r < 16; r++) {
+        const uint8_t *s = blake_sigma[r];
+        blake_g(v, m, s + 0,  0, 4,  8, 12);
+        blake_g(v, m, s + 2,  1, 5,  9, 13);
+        blake_g(v, m, s + 4,  2, 6, 10, 14);
+        blake_g(v, m, s + 6,  3, 7, 11, 15);
+        blake_g(v, m, s + 8,  0, 5, 10, 15);
+        blake_g(v, m, s + 10, 1, 6, 11, 12);
+        blake_g(v, m, s + 12, 2, 7,  8, 13);
+        blake_g(v, m, s + 14, 3, 4,  9, 14);
+    }
+
+    SPH_X4_UNROLL
+    for (int i = 0; i < 8; i++) {
+        h[i] = x4_bswap(x4_xor(x4_set1(blake_iv[i]), x4_xor(v[i], v[i + 8])));
+    }
+    x4_store_le64(out, h);
+}
+
+/* ── BMW-512 ── */
+
+static const uint64_t bmw_iv[16] = {
+    0x8081828384858687ULL, 0x88898A8B8C8D8E8FULL, 0x9091929394959697ULL, 0x98999A9B9C9D9E9FULL,
+    0xA0A1A2A3A4A5A6A7ULL, 0xA8A9AAABACADAEAFULL, 0xB0B1B2B3B4B5B6B7ULL, 0xB8B9BABBBCBDBEBFULL,
+    0xC0C1C2C3C4C5C6C7ULL, 0xC8C9CACBCCCDCECFULL, 0xD0D1D2D3D4D5D6D7ULL, 0xD8D9DADBDCDDDEDFULL,
+    0xE0E1E2E3E4E5E6E7ULL, 0xE8E9EAEBECEDEEEFULL, 0xF0F1F2F3F4F5F6F7ULL, 0xF8F9FAFBFCFDFEFFULL,
+};
+
+static const uint64_t bmw_final[16] = {
+    0xaaaaaaaaaaaaaaa0ULL, 0xaaaaaaaaaaaaaaa1ULL, 0xaaaaaaaaaaaaaaa2ULL, 0xaaaaaaaaaaaaaaa3ULL,
+    0xaaaaaaaaaaaaaaa4ULL, 0xaaaaaaaaaaaaaaa5ULL, 0xaaaaaaaaaaaaaaa6ULL, 0xaaaaaaaaaaaaaaa7ULL,
+    0xaaaaaaaaaaaaaaa8ULL, 0xaaaaaaaaaaaaaaa9ULL, 0xaaaaaaaaaaaaaaaaULL, 0xaaaaaaaaaaaaaaabULL,
+    0xaaaaaaaaaaaaaaacULL, 0xaaaaaaaaaaaaaaadULL, 0xaaaaaaaaaaaaaaaeULL, 0xaaaaaaaaaaaaaaafULL,
+};
+
+/* W[i] = (M ^ H)[idx[0]] op (M ^ H)[idx[1]] op ... with op = + or - (sign < 0) */
+static const uint8_t bmw_w_idx[16][5] = {
+    {  5,  7, 10, 13, 14 }, {  6,  8, 11, 14, 15 }, {  0,  7,  9, 12, 15 }, {  0,  1,  8, 10, 13 },
+    {  1,  2,  9, 11, 14 }, {  3,  2, 10, 12, 15 }, {  4,  0,  3, 11, 13 }, {  1,  4,  5, 12, 14 },
+    {  2,  5,  6, 13, 15 }, {  0,  3,  6,  7, 14 }, {  8,  1,  4,  7, 15 }, {  8,  0,  2,  5,  9 },
+    {  1,  3,  6,  9, 10 }, {  2,  4,  7, 10, 11 }, {  3,  5,  8, 11, 12 }, { 12,  4,  6,  9, 13 },
+};
+
+static const int8_t bmw_w_sign[16][4] = {
+    { -1, +1, +1, +1 }, { -1, +1, +1, -1 }, { +1, +1, -1, +1 }, { -1, +1, -1, +1 },
+    { +1, +1, -1, -1 }, { -1, +1, -1, +1 }, { -1, -1, -1, +1 }, { -1, -1, -1, -1 },
+    { -1, -1, +1, -1 }, { -1, +1, -1, +1 }, { -1, -1, -1, +1 }, { -1, -1, -1, +1 },
+    { +1, -1, -1, +1 }, { +1, +1, +1, +1 }, { -1, +1, -1, -1 }, { -1, -1, -1, +1 },
+};
+
+static SPH_X4_TARGET SPH_X4_INLINE __m256i bmw_s(__m256i x, int i)
+{
+    switch (i) {
+    case 0:  return x4_xor(x4_xor(x4_shr(x, 1), x4_shl(x, 3)), x4_xor(x4_rol(x, 4), x4_rol(x, 37)));
+    case 1:  return x4_xor(x4_xor(x4_shr(x, 1), x4_shl(x, 2)), x4_xor(x4_rol(x, 13), x4_rol(x, 43)));
+    case 2:  return x4_xor(x4_xor(x4_shr(x, 2), x4_shl(x, 1)), x4_xor(x4_rol(x, 19), x4_rol(x, 53)));
+    case 3:  return x4_xor(x4_xor(x4_shr(x, 2), x4_shl(x, 2)), x4_xor(x4_rol(x, 28), x4_rol(x, 59)));
+    case 4:  return x4_xor(x4_shr(x, 1), x);
+    default: return x4_xor(x4_shr(x, 2), x);
+    }
+}
+
+static SPH_X4_TARGET SPH_X4_INLINE __m256i bmw_add_elt(const __m256i m[16], const __m256i h[16],
+                                                       int j)
+{
+    const int j0 = j & 15, j3 = (j + 3) & 15, j10 = (j + 10) & 15;
+    __m256i t = x4_add(x4_rol(m[j0], j0 + 1), x4_rol(m[j3], j3 + 1));
+    t = x4_sub(t, x4_rol(m[j10], j10 + 1));
+    t = x4_add(t, x4_set1((uint64_t)(j + 16) * 0x0555555555555555ULL));
+    return x4_xor(t, h[(j + 7) & 15]);
+}
+
+static SPH_X4_TARGET void bmw_compress(const __m256i m[16], const __m256i h[16], __m256i dh[16])
+{
+    static const int rb[7] = { 5, 11, 27, 32, 37, 43, 53 };
+    __m256i mh[16], q[32], xl, xh;
+
+    SPH_X4_UNROLL
+    for (int i = 0; i < 16; i++) {
+        mh[i] = x4_xor(m[i], h[i]);
+    }
+    SPH_X4_UNROLL
+    for (int i = 0; i < 16; i++) {
+        __m256i w = mh[bmw_w_idx[i][0]];
+        SPH_X4_UNROLL
+        for (int k = 0; k < 4; k++) {
+            const __m256i t = mh[bmw_w_idx[i][k + 1]];
+            w = bmw_w_sign[i][k] < 0 ? x4_sub(w, t) : x4_add(w, t);
+        }
+        q[i] = x4_add(bmw_s(w, i % 5), h[(i + 1) & 15]);
+    }
+    SPH_X4_UNROLL
+    for (int i = 16; i < 18; i++) {
+        __m256i t = bmw_add_elt(m, h, i - 16);
+        SPH_X4_UNROLL
+        for (int k = 0; k < 16; k++) {
+            t = x4_add(t, bmw_s(q[i - 16 + k], (k + 1) & 3));
+        }
+        q[i] = t;
+    }
+    SPH_X4_UNROLL
+    for (int i = 18; i < 32; i++) {
+        __m256i t = bmw_add_elt(m, h, i - 16);
+        SPH_X4_UNROLL
+        for (int k = 0; k < 14; k += 2) {
+            t = x4_add(t, x4_add(q[i - 16 + k], x4_rol(q[i - 15 + k], rb[k / 2])));
+        }
+        t = x4_add(t, bmw_s(q[i - 2], 4));
+        t = x4_add(t, bmw_s(q[i - 1], 5));
+        q[i] = t;
+    }
+
+    xl = q[16];
+    SPH_X4_UNROLL
+    for (int i = 17; i < 24; i++) {
+        xl = x4_xor(xl, q[i]);
+    }
+    xh = xl;
+    SPH_X4_UNROLL
+    for (int i = 24; i < 32; i++) {
+        xh = x4_xor(xh, q[i]);
+    }
+
+#define BMW_LO(i, hx, qx) \
+    dh[i] = x4_add(x4_xor(x4_xor(hx, qx), m[i]), x4_xor(x4_xor(xl, q[24 + (i)]), q[i]))
+    BMW_LO(0, x4_shl(xh, 5),  x4_shr(q[16], 5));
+    BMW_LO(1, x4_shr(xh, 7),  x4_shl(q[17], 8));
+    BMW_LO(2, x4_shr(xh, 5),  x4_shl(q[18], 5));
+    BMW_LO(3, x4_shr(xh, 1),  x4_shl(q[19], 5));
+    BMW_LO(4, x4_shr(xh, 3),  q[20]);
+    BMW_LO(5, x4_shl(xh, 6),  x4_shr(q[21], 6));
+    BMW_LO(6, x4_shr(xh, 4),  x4_shl(q[22], 6));
+    BMW_LO(7, x4_shr(xh, 11), x4_shl(q[23], 2));
+#undef BMW_LO
+
+#define BMW_HI(i, xlx, qx) \
+    dh[i] = x4_add(x4_add(x4_rol(dh[(i) - 4 - ((i) >= 12) * 8], (i) + 1), \
+                          x4_xor(x4_xor(xh, q[16 + (i)]), m[i])), \
+                   x4_xor(x4_xor(xlx, qx), q[i]))
+    BMW_HI(8,  x4_shl(xl, 8), q[23]);
+    BMW_HI(9,  x4_shr(xl, 6), q[16]);
+    BMW_HI(10, x4_shl(xl, 6), q[17]);
+    BMW_HI(11, x4_shl(xl, 4), q[18]);
+    BMW_HI(12, x4_shr(xl, 3), q[19]);
+    BMW_HI(13, x4_shr(xl, 4), q[20]);
+    BMW_HI(14, x4_shr(xl, 7), q[21]);
+    BMW_HI(15, x4_shr(xl, 2), q[22]);
+#undef BMW_HI
+}
+
+SPH_X4_TARGET void sph_bmw512_x4_64(const uint8_t *const in[4], uint8_t *const out[4])
+{
+    __m256i m[16], h[16], h2[16];
+
+    /* One 128-byte block: message, 0x80, 64-bit length 512 */
+    x4_load_le64(in, m);
+    SPH_X4_UNROLL
+    for (int i = 8; i < 16; i++) {
+        m[i] = _mm256_setzero_si256();
+    }
+    m[8] = x4_set1(0x80);
+    m[15] = x4_set1(512);
+
+    SPH_X4_UNROLL
+    for (int i = 0; i < 16; i++) {
+        h[i] = x4_set1(bmw_iv[i]);
+    }
+    bmw_compress(m, h, h2);
+
+    SPH_X4_UNROLL
+    for (int i = 0; i < 16; i++) {
+        h[i] = x4_set1(bmw_final[i]);
+    }
+    bmw_compress(h2, h, m);
+    x4_store_le64(out, m + 8);
+}
+
+/* ── Keccak-512 ── */
+
+static const uint64_t keccak_rc[24] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808AULL, 0x8000000080008000ULL,
+    0x000000000000808BULL, 0x0000000080000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+    0x000000000000008AULL, 0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000AULL,
+    0x000000008000808BULL, 0x800000000000008BULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
+    0x8000000000008002ULL, 0x8000000000000080ULL, 0x000000000000800AULL, 0x800000008000000AULL,
+    0x8000000080008081ULL, 0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL,
+};
+
+/* Rotation of lane x + 5y */
+static const uint8_t keccak_rho[25] = {
+     0,  1, 62, 28, 27,
+    36, 44,  6, 55, 20,
+     3, 10, 43, 25, 39,
+    41, 45, 15, 21,  8,
+    18,  2, 61, 56, 14,
+};
+
+SPH_X4_TARGET void sph_keccak512_x4_64(const uint8_t *const in[4], uint8_t *const out[4])
+{
+    __m256i a[25], b[25], c[5], d[5];
+
+    /* One 72-byte rate block: message, Keccak padding 0x01 ... 0x80 */
+    x4_load_le64(in, a);
+    a[8] = x4_set1(0x8000000000000001ULL);
+    SPH_X4_UNROLL
+    for (int i = 9; i < 25; i++) {
+        a[i] = _mm256_setzero_si256();
+    }
+
+    for (int r = 0; r < 24; r++) {
+        SPH_X4_UNROLL
+        for (int x = 0; x < 5; x++) {
+            c[x] = x4_xor(x4_xor(a[x], a[x + 5]), x4_xor(x4_xor(a[x + 10], a[x + 15]), a[x + 20]));
+        }
+        SPH_X4_UNROLL
+        for (int x = 0; x < 5; x++) {
+            d[x] = x4_xor(c[(x + 4) % 5], x4_rol(c[(x + 1) % 5], 1));
+        }
+        SPH_X4_UNROLL
+        for (int y = 0; y < 5; y++) {
+            SPH_X4_UNROLL
+            for (int x = 0; x < 5; x++) {
+                const int i = x + 5 * y;
+                const __m256i t = x4_xor(a[i], d[x]);
+                b[y + 5 * ((2 * x + 3 * y) % 5)] = keccak_rho[i] ? x4_rol(t, keccak_rho[i]) : t;
+            }
+        }
+        SPH_X4_UNROLL
+        for (int y = 0; y < 25; y += 5) {
+            SPH_X4_UNROLL
+            for (int x = 0; x < 5; x++) {
+                a[y + x] = x4_xor(b[y + x],
+                                  _mm256_andnot_si256(b[y + (x + 1) % 5], b[y + (x + 2) % 5]));
+            }
+        }
+        a[0] = x4_xor(a[0], x4_set1(keccak_rc[r]));
+    }
+
+    x4_store_le64(out, a);
+}
+
+/* ── Skein-512 ── */
+
+static const uint64_t skein_iv[8] = {
+    0x4903ADFF749C51CEULL, 0x0D95DE399746DF03ULL, 0x8FD1934127C79BCEULL, 0x9A255629FF352CB1ULL,
+    0x5DB62599DF6CA7B0ULL, 0xEABE394CA9D5C3F4ULL, 0x991112C71A75B523ULL, 0xAE18A40B660FCC33ULL,
+};
+
+static const uint8_t skein_rot[8][4] = {
+    { 46, 36, 19, 37 }, { 33, 27, 14, 42 }, { 17, 49, 36, 39 }, { 44,  9, 54, 56 },
+    { 39, 30, 34, 24 }, { 13, 50, 10, 17 }, { 25, 29, 39, 43 }, {  8, 35, 56, 22 },
+};
+
+/* Word pairs mixed in each of four consecutive rounds */
+static const uint8_t skein_perm[4][8] = {
+    { 0, 1, 2, 3, 4, 5, 6, 7 },
+    { 2, 1, 4, 7, 6, 5, 0, 3 },
+    { 4, 1, 6, 3, 0, 5, 2, 7 },
+    { 6, 1, 0, 7, 2, 5, 4, 3 },
+};
+
+/* One UBI block: h = Threefish-512(key h, tweak t0/t1, msg) ^ msg */
+static SPH_X4_TARGET void skein_ubi(__m256i h[8], const __m256i msg[8], uint64_t t0, uint64_t t1)
+{
+    const uint64_t ts[3] = { t0, t1, t0 ^ t1 };
+    __m256i ks[9], x[8];
+
+    ks[8] = x4_set1(0x1BD11BDAA9FC1A22ULL);
+    SPH_X4_UNROLL
+    for (int i = 0; i < 8; i++) {
+        ks[i] = h[i];
+        ks[8] = x4_xor(ks[8], h[i]);
+        x[i] = msg[i];
+    }
+
+    SPH_X4_UNROLL
+    for (int s = 0; s <= 18; s++) {
+        SPH_X4_UNROLL
+        for (int i = 0; i < 8; i++) {
+            x[i] = x4_add(x[i], ks[(s + i) % 9]);
+        }
+        x[5] = x4_add(x[5], x4_set1(ts[s % 3]));
+        x[6] = x4_add(x[6], x4_set1(ts[(s + 1) % 3]));
+        x[7] = x4_add(x[7], x4_set1((uint64_t)s));
+        if (s == 18) {
+            break;
+        }
+        SPH_X4_UNROLL
+        for (int r = 0; r < 4; r++) {
+            const uint8_t *p = skein_perm[r];
+            const uint8_t *rot = skein_rot[(s & 1) * 4 + r];
+            SPH_X4_UNROLL
+            for (int k = 0; k < 4; k++) {
+                const int a = p[2 * k], b = p[2 * k + 1];
+                x[a] = x4_add(x[a], x[b]);
+                x[b] = x4_xor(x4_rol(x[b], rot[k]), x[a]);
+            }
+        }
+    }
+
+    SPH_X4_UNROLL
+    for (int i = 0; i < 8; i++) {
+        h[i] = x4_xor(x[i], msg[i]);
+    }
+}
+
+SPH_X4_TARGET void sph_skein512_x4_64(const uint8_t *const in[4], uint8_t *const out[4])
+{
+    __m256i h[8], msg[8];
+
+    SPH_X4_UNROLL
+    for (int i = 0; i < 8; i++) {
+        h[i] = x4_set1(skein_iv[i]);
+    }
+
+    /* Message: one final block of 64 bytes (type MSG, first | final) */
+    x4_load_le64(in, msg);
+    skein_ubi(h, msg, 64, 0xF000000000000000ULL);
+
+    /* Output: counter 0 (type OUT, first | final, 8 bytes) */
+    SPH_X4_UNROLL
+    for (int i = 0; i < 8; i++) {
+        msg[i] = _mm256_setzero_si256();
+    }
+    skein_ubi(h, msg, 8, 0xFF00000000000000ULL);
+
+    x4_store_le64(out, h);
+}
+
+/* ── CubeHash-512 (32-bit words, four per 128-bit register) ── */
+
+static const uint32_t cubehash_iv[32] = {
+    0x2AEA2A61, 0x50F494D4, 0x2D538B8B, 0x4167D83E, 0x3FEE2313, 0xC701CF8C, 0xCC39968E, 0x50AC5695,
+    0x4D42C787, 0xA647A8B3, 0x97CF0BEF, 0x825B4537, 0xEEF864D2, 0xF22090C4, 0xD0E5CD33, 0xA23911AE,
+    0xFCD398D9, 0x148FE485, 0x1B017BEF, 0xB6444532, 0x6A536159, 0x2FF5781C, 0x91FA7934, 0x0DBADEA9,
+    0xD65C8A2B, 0xA5A70E75, 0xB1C62456, 0xBC796576, 0x1921C8F7, 0xE7989AF1, 0x7795D246, 0xD43E3B44,
+};
+
+static SPH_X4_TARGET SPH_X4_INLINE void cubehash_swap(__m128i x[32], int i, int j)
+{
+    const __m128i t = x[i];
+    x[i] = x[j];
+    x[j] = t;
+}
+
+static SPH_X4_TARGET void cubehash_rounds(__m128i x[32], int rounds)
+{
+    for (int r = 0; r < rounds; r++) {
+        SPH_X4_UNROLL
+        for (int i = 0; i < 16; i++) {
+            x[i + 16] = _mm_add_epi32(x[i + 16], x[i]);
+            x[i] = x4_rol32(x[i], 7);
+        }
+        SPH_X4_UNROLL
+        for (int i = 0; i < 8; i++) {
+            cubehash_swap(x, i, i + 8);
+        }
+        SPH_X4_UNROLL
+        for (int i = 0; i < 16; i++) {
+            x[i] = _mm_xor_si128(x[i], x[i + 16]);
+        }
+        SPH_X4_UNROLL
+        for (int i = 16; i < 32; i++) {
+            if (!(i & 2)) cubehash_swap(x, i, i + 2);
+        }
+        SPH_X4_UNROLL
+        for (int i = 0; i < 16; i++) {
+            x[i + 16] = _mm_add_epi32(x[i + 16], x[i]);
+            x[i] = x4_rol32(x[i], 11);
+        }
+        SPH_X4_UNROLL
+        for (int i = 0; i < 16; i++) {
+            if (!(i & 4)) cubehash_swap(x, i, i + 4);
+        }
+        SPH_X4_UNROLL
+        for (int i = 0; i < 16; i++) {
+            x[i] = _mm_xor_si128(x[i], x[i + 16]);
+        }
+        SPH_X4_UNROLL
+        for (int i = 16; i < 32; i++) {
+            if (!(i & 1)) cubehash_swap(x, i, i + 1);
+        }
+    }
+}
+
+SPH_X4_TARGET void sph_cubehash512_x4_64(const uint8_t *const in[4], uint8_t *const out[4])
+{
+    __m128i x[32], m[16];
+
+    SPH_X4_UNROLL
+    for (int i = 0; i < 32; i++) {
+        x[i] = _mm_set1_epi32((int)cubehash_iv[i]);
+    }
+    x4_load_le32(in, m);
+
+    /* Two 32-byte message blocks, then the padding block 0x80 */
+    SPH_X4_UNROLL
+    for (int blk = 0; blk < 2; blk++) {
+        SPH_X4_UNROLL
+        for (int i = 0; i < 8; i++) {
+            x[i] = _mm_xor_si128(x[i], m[8 * blk + i]);
+        }
+        cubehash_rounds(x, 16);
+    }
+    x[0] = _mm_xor_si128(x[0], _mm_set1_epi32(0x80));
+    cubehash_rounds(x, 16);
+
+    /* Finalization: flip the last state bit, 10 x 16 rounds */
+    x[31] = _mm_xor_si128(x[31], _mm_set1_epi32(1));
+    cubehash_rounds(x, 160);
+
+    x4_store_le32(out, x);
+}
+
+/* ── Luffa-512 (32-bit words, four per 128-bit register) ── */
+
+static const uint32_t luffa_iv[5][8] = {
+    { 0x6D251E69, 0x44B051E0, 0x4EAA6FB4, 0xDBF78465, 0x6E292011, 0x90152DF4, 0xEE058139, 0xDEF610BB },
+    { 0xC3B44B95, 0xD9D2F256, 0x70EEE9A0, 0xDE099FA3, 0x5D9B0557, 0x8FC944B3, 0xCF1CCF0E, 0x746CD581 },
+    { 0xF7EFC89D, 0x5DBA5781, 0x04016CE5, 0xAD659C05, 0x0306194F, 0x666D1836, 0x24AA230A, 0x8B264AE7 },
+    { 0x858075D5, 0x36D79CCE, 0xE571F7D7, 0x204B1F67, 0x35870C6A, 0x57E9E923, 0x14BCB808, 0x7CDE72CE },
+    { 0x6C68E9BE, 0x5EC41E22, 0xC825B7C7, 0xAFFB4363, 0xF5DF3999, 0x0FC688F1, 0xB07224CC, 0x03E86CEA },
+};
+
+/* Round constants of sub-permutation j, added to words 0 and 4 */
+static const uint32_t luffa_rc[5][2][8] = {
+    { { 0x303994A6, 0xC0E65299, 0x6CC33A12, 0xDC56983E, 0x1E00108F, 0x7800423D, 0x8F5B7882, 0x96E1DB12 },
+      { 0xE0337818, 0x441BA90D, 0x7F34D442, 0x9389217F, 0xE5A8BCE6, 0x5274BAF4, 0x26889BA7, 0x9A226E9D } },
+    { { 0xB6DE10ED, 0x70F47AAE, 0x0707A3D4, 0x1C1E8F51, 0x707A3D45, 0xAEB28562, 0xBACA1589, 0x40A46F3E },
+      { 0x01685F3D, 0x05A17CF4, 0xBD09CACA, 0xF4272B28, 0x144AE5CC, 0xFAA7AE2B, 0x2E48F1C1, 0xB923C704 } },
+    { { 0xFC20D9D2, 0x34552E25, 0x7AD8818F, 0x8438764A, 0xBB6DE032, 0xEDB780C8, 0xD9847356, 0xA2C78434 },
+      { 0xE25E72C1, 0xE623BB72, 0x5C58A4A4, 0x1E38E2E7, 0x78E38B9D, 0x27586719, 0x36EDA57F, 0x703AACE7 } },
+    { { 0xB213AFA5, 0xC84EBE95, 0x4E608A22, 0x56D858FE, 0x343B138F, 0xD0EC4E3D, 0x2CEB4882, 0xB3AD2208 },
+      { 0xE028C9BF, 0x44756F91, 0x7E8FCE32, 0x956548BE, 0xFE191BE2, 0x3CB226E5, 0x5944A28E, 0xA1C4C355 } },
+    { { 0xF0D2E9E3, 0xAC11D7FA, 0x1BCB66F2, 0x6F2D9BC9, 0x78602649, 0x8EDAE952, 0x3B6BA548, 0xEDAE9520 },
+      { 0x5090D577, 0x2D1925AB, 0xB46496AC, 0xD1925AB0, 0x29131AB6, 0x0FC053C3, 0x3F014F0C, 0xFC053C31 } },
+};
+
+/* d = s * x in the ring of 8-word vectors; d may alias s */
+static SPH_X4_TARGET SPH_X4_INLINE void luffa_m2(__m128i d[8], const __m128i s[8])
+{
+    const __m128i t = s[7];
+    d[7] = s[6];
+    d[6] = s[5];
+    d[5] = s[4];
+    d[4] = _mm_xor_si128(s[3], t);
+    d[3] = _mm_xor_si128(s[2], t);
+    d[2] = s[1];
+    d[1] = _mm_xor_si128(s[0], t);
+    d[0] = t;
+}
+
+static SPH_X4_TARGET SPH_X4_INLINE void luffa_xor8(__m128i d[8], const __m128i s[8])
+{
+    SPH_X4_UNROLL
+    for (int i = 0; i < 8; i++) {
+        d[i] = _mm_xor_si128(d[i], s[i]);
+    }
+}
+
+/* Message injection; msg is NULL for the blank blocks of the output phase */
+static SPH_X4_TARGET void luffa_mi(__m128i v[5][8], const __m128i *msg)
+{
+    __m128i a[8], b[8], m[8];
+
+    SPH_X4_UNROLL
+    for (int i = 0; i < 8; i++) {
+        a[i] = _mm_xor_si128(_mm_xor_si128(v[0][i], v[1][i]),
+                             _mm_xor_si128(_mm_xor_si128(v[2][i], v[3][i]), v[4][i]));
+    }
+    luffa_m2(a, a);
+    SPH_X4_UNROLL
+    for (int j = 0; j < 5; j++) {
+        luffa_xor8(v[j], a);
+    }
+
+    luffa_m2(b, v[0]);
+    luffa_xor8(b, v[1]);
+    luffa_m2(v[1], v[1]);
+    luffa_xor8(v[1], v[2]);
+    luffa_m2(v[2], v[2]);
+    luffa_xor8(v[2], v[3]);
+    luffa_m2(v[3], v[3]);
+    luffa_xor8(v[3], v[4]);
+    luffa_m2(v[4], v[4]);
+    luffa_xor8(v[4], v[0]);
+    luffa_m2(v[0], b);
+    luffa_xor8(v[0], v[4]);
+    luffa_m2(v[4], v[4]);
+    luffa_xor8(v[4], v[3]);
+    luffa_m2(v[3], v[3]);
+    luffa_xor8(v[3], v[2]);
+    luffa_m2(v[2], v[2]);
+    luffa_xor8(v[2], v[1]);
+    luffa_m2(v[1], v[1]);
+    luffa_xor8(v[1], b);
+
+    if (msg) {
+        SPH_X4_UNROLL
+        for (int i = 0; i < 8; i++) {
+            m[i] = msg[i];
+        }
+        SPH_X4_UNROLL
+        for (int j = 0; j < 5; j++) {
+            if (j) {
+                luffa_m2(m, m);
+            }
+            luffa_xor8(v[j], m);
+        }
+    }
+}
+
+static SPH_X4_TARGET SPH_X4_INLINE void luffa_sub_crumb(__m128i x[8], int i0, int i1, int i2,
+                                                        int i3)
+{
+    __m128i a0 = x[i0], a1 = x[i1], a2 = x[i2], a3 = x[i3];
+    __m128i t = a0;
+
+    a0 = _mm_or_si128(a0, a1);
+    a2 = _mm_xor_si128(a2, a3);
+    a1 = x4_not32(a1);
+    a0 = _mm_xor_si128(a0, a3);
+    a3 = _mm_and_si128(a3, t);
+    a1 = _mm_xor_si128(a1, a3);
+    a3 = _mm_xor_si128(a3, a2);
+    a2 = _mm_and_si128(a2, a0);
+    a0 = x4_not32(a0);
+    a2 = _mm_xor_si128(a2, a1);
+    a1 = _mm_or_si128(a1, a3);
+    t = _mm_xor_si128(t, a1);
+    a3 = _mm_xor_si128(a3, a2);
+    a2 = _mm_and_si128(a2, a1);
+    a1 = _mm_xor_si128(a1, a0);
+
+    x[i0] = t;
+    x[i1] = a1;
+    x[i2] = a2;
+    x[i3] = a3;
+}
+
+static SPH_X4_TARGET SPH_X4_INLINE void luffa_mix_word(__m128i x[8], int i, int j)
+{
+    __m128i u = x[i], v = x[j];
+
+    v = _mm_xor_si128(v, u);
+    u = _mm_xor_si128(x4_rol32(u, 2), v);
+    v = _mm_xor_si128(x4_rol32(v, 14), u);
+    u = _mm_xor_si128(x4_rol32(u, 10), v);
+    x[i] = u;
+    x[j] = x4_rol32(v, 1);
+}
+
+/* Sub-permutation j: tweak, then 8 steps */
+static SPH_X4_TARGET void luffa_perm(__m128i x[8], int j)
+{
+    if (j) {
+        SPH_X4_UNROLL
+        for (int i = 4; i < 8; i++) {
+            x[i] = x4_rol32(x[i], j);
+        }
+    }
+    SPH_X4_UNROLL
+    for (int r = 0; r < 8; r++) {
+        luffa_sub_crumb(x, 0, 1, 2, 3);
+        luffa_sub_crumb(x, 5, 6, 7, 4);
+        luffa_mix_word(x, 0, 4);
+        luffa_mix_word(x, 1, 5);
+        luffa_mix_word(x, 2, 6);
+        luffa_mix_word(x, 3, 7);
+        x[0] = _mm_xor_si128(x[0], _mm_set1_epi32((int)luffa_rc[j][0][r]));
+        x[4] = _mm_xor_si128(x[4], _mm_set1_epi32((int)luffa_rc[j][1][r]));
+    }
+}
+
+SPH_X4_TARGET void sph_luffa512_x4_64(const uint8_t *const in[4], uint8_t *const out[4])
+{
+    __m128i v[5][8], m[16], h[16];
+
+    SPH_X4_UNROLL
+    for (int j = 0; j < 5; j++) {
+        SPH_X4_UNROLL
+        for (int i = 0; i < 8; i++) {
+            v[j][i] = _mm_set1_epi32((int)luffa_iv[j][i]);
+        }
+    }
+    x4_load_le32(in, m);
+    SPH_X4_UNROLL
+    for (int i = 0; i < 16; i++) {
+        m[i] = x4_bswap32(m[i]);
+    }
+
+    /* Two 32-byte message blocks (big-endian words), then the padding block 0x80 */
+    for (int blk = 0; blk < 3; blk++) {
+        if (blk == 2) {
+            SPH_X4_UNROLL
+            for (int i = 0; i < 8; i++) {
+                m[i] = _mm_setzero_si128();
+            }
+            m[0] = _mm_set1_epi32((int)0x80000000);
+        }
+        luffa_mi(v, m + 8 * (blk & 1));
+        for (int j = 0; j < 5; j++) {
+            luffa_perm(v[j], j);
+        }
+    }
+
+    /* Output: two blank blocks, each squeezing 32 bytes */
+    for (int k = 0; k < 2; k++) {
+        luffa_mi(v, NULL);
+        for (int j = 0; j < 5; j++) {
+            luffa_perm(v[j], j);
+        }
+        SPH_X4_UNROLL
+        for (int i = 0; i < 8; i++) {
+            h[8 * k + i] = x4_bswap32(_mm_xor_si128(
+                _mm_xor_si128(_mm_xor_si128(v[0][i], v[1][i]), _mm_xor_si128(v[2][i], v[3][i])),
+                v[4][i]));
+        }
+    }
+    x4_store_le32(out, h);
+}
+
+/* ── Shabal-512 (32-bit words, four per 128-bit register) ── */
+
+static const uint32_t shabal_a_iv[12] = {
+    0x20728DFD, 0x46C0BD53, 0xE782B699, 0x55304632, 0x71B4EF90, 0x0EA9E82C, 0xDBB930F1, 0xFAD06B8B,
+    0xBE0CAE40, 0x8BD14410, 0x76D2ADAC, 0x28ACAB7F,
+};
+
+static const uint32_t shabal_b_iv[16] = {
+    0xC1099CB7, 0x07B385F3, 0xE7442C26, 0xCC8AD640, 0xEB6F56C7, 0x1EA81AA9, 0x73B9D314, 0x1DE85D08,
+    0x48910A5A, 0x893B22DB, 0xC5A0DF44, 0xBBC4324E, 0x72D2F240, 0x75941D99, 0x6D8BDE82, 0xA1A7502B,
+};
+
+static const uint32_t shabal_c_iv[16] = {
+    0xD9BF68D1, 0x58BAD750, 0x56028CB2, 0x8134F359, 0xB5D469D8, 0x941A8CC2, 0x418B2A6E, 0x04052780,
+    0x7F07D787, 0x5194358F, 0x3C60D665, 0xBE97D79A, 0x950C3434, 0xAED9A06D, 0x2537DC8D, 0x7CDB5969,
+};
+
+/* Keyed permutation P: three passes of 16 steps over A, then the C feed-forward */
+static SPH_X4_TARGET void shabal_apply_p(__m128i a[12], __m128i b[16], const __m128i c[16],
+                                         const __m128i m[16])
+{
+    SPH_X4_UNROLL
+    for (int i = 0; i < 16; i++) {
+        b[i] = x4_rol32(b[i], 17);
+    }
+    SPH_X4_UNROLL
+    for (int k = 0; k < 48; k++) {
+        const int i = k & 15;
+        __m128i t = x4_rol32(a[(k + 11) % 12], 15);
+        t = _mm_add_epi32(_mm_slli_epi32(t, 2), t);                  /* * 5 */
+        t = _mm_xor_si128(_mm_xor_si128(a[k % 12], t), c[(24 - i) & 15]);
+        t = _mm_add_epi32(_mm_slli_epi32(t, 1), t);                  /* * 3 */
+        t = _mm_xor_si128(_mm_xor_si128(t, b[(i + 13) & 15]),
+                          _mm_xor_si128(_mm_andnot_si128(b[(i + 6) & 15], b[(i + 9) & 15]), m[i]));
+        a[k % 12] = t;
+        b[i] = x4_not32(_mm_xor_si128(x4_rol32(b[i], 1), t));
+    }
+    SPH_X4_UNROLL
+    for (int k = 0; k < 36; k++) {
+        a[11 - k % 12] = _mm_add_epi32(a[11 - k % 12], c[(38 - k) & 15]);
+    }
+}
+
+static SPH_X4_TARGET SPH_X4_INLINE void shabal_swap_bc(__m128i b[16], __m128i c[16])
+{
+    SPH_X4_UNROLL
+    for (int i = 0; i < 16; i++) {
+        const __m128i t = b[i];
+        b[i] = c[i];
+        c[i] = t;
+    }
+}
+
+SPH_X4_TARGET void sph_shabal512_x4_64(const uint8_t *const in[4], uint8_t *const out[4])
+{
+    __m128i a[12], b[16], c[16], m[16];
+
+    SPH_X4_UNROLL
+    for (int i = 0; i < 12; i++) {
+        a[i] = _mm_set1_epi32((int)shabal_a_iv[i]);
+    }
+    SPH_X4_UNROLL
+    for (int i = 0; i < 16; i++) {
+        b[i] = _mm_set1_epi32((int)shabal_b_iv[i]);
+        c[i] = _mm_set1_epi32((int)shabal_c_iv[i]);
+    }
+
+    /* Message block, counter W = 1 */
+    x4_load_le32(in, m);
+    SPH_X4_UNROLL
+    for (int i = 0; i < 16; i++) {
+        b[i] = _mm_add_epi32(b[i], m[i]);
+    }
+    a[0] = _mm_xor_si128(a[0], _mm_set1_epi32(1));
+    shabal_apply_p(a, b, c, m);
+    SPH_X4_UNROLL
+    for (int i = 0; i < 16; i++) {
+        c[i] = _mm_sub_epi32(c[i], m[i]);
+    }
+    shabal_swap_bc(b, c);
+
+    /* Padding block 0x80 with W = 2, then three more rounds on it */
+    SPH_X4_UNROLL
+    for (int i = 0; i < 16; i++) {
+        m[i] = _mm_setzero_si128();
+    }
+    m[0] = _mm_set1_epi32(0x80);
+    b[0] = _mm_add_epi32(b[0], m[0]);
+    a[0] = _mm_xor_si128(a[0], _mm_set1_epi32(2));
+    shabal_apply_p(a, b, c, m);
+    for (int k = 0; k < 3; k++) {
+        shabal_swap_bc(b, c);
+        a[0] = _mm_xor_si128(a[0], _mm_set1_epi32(2));
+        shabal_apply_p(a, b, c, m);
+    }
+
+    x4_store_le32(out, b);
+}
+
+/*
+ * ── AES-round kernels (AES-NI) ──
+ *
+ * ECHO, Grøstl and SHAvite-3 are built from AES rounds on 128-bit words,
+ * so their lanes are not widened: each lane runs on AES-NI, which replaces
+ * the table lookups of the scalar code.  ECHO and Grøstl already have 16
+ * and 8 independent AES rounds per step; SHAvite-3 runs its four lanes
+ * interleaved to hide the AES latency of its serial round chain.
+ */
+
+static SPH_X4_TARGET_AES SPH_X4_INLINE __m128i x4_aes(__m128i x, __m128i key)
+{
+    return _mm_aesenc_si128(x, key);
+}
+
+/* Multiply every byte by 2 in GF(2^8) */
+static SPH_X4_TARGET_AES SPH_X4_INLINE __m128i x4_xtime(__m128i x)
+{
+    const __m128i carry = _mm_cmpgt_epi8(_mm_setzero_si128(), x);
+    return _mm_xor_si128(_mm_add_epi8(x, x), _mm_and_si128(carry, _mm_set1_epi8(0x1B)));
+}
+
+/* ── ECHO-512 ── */
+
+static SPH_X4_TARGET_AES SPH_X4_INLINE void echo_mix_column(__m128i w[16], int i)
+{
+    const __m128i a = w[i], b = w[i + 1], c = w[i + 2], d = w[i + 3];
+    const __m128i ab = _mm_xor_si128(a, b);
+    const __m128i bc = _mm_xor_si128(b, c);
+    const __m128i cd = _mm_xor_si128(c, d);
+    const __m128i abx = x4_xtime(ab);
+    const __m128i bcx = x4_xtime(bc);
+    const __m128i cdx = x4_xtime(cd);
+
+    w[i] = _mm_xor_si128(abx, _mm_xor_si128(bc, d));
+    w[i + 1] = _mm_xor_si128(bcx, _mm_xor_si128(a, cd));
+    w[i + 2] = _mm_xor_si128(cdx, _mm_xor_si128(ab, d));
+    w[i + 3] = _mm_xor_si128(_mm_xor_si128(abx, bcx), _mm_xor_si128(_mm_xor_si128(cdx, ab), c));
+}
+
+static SPH_X4_TARGET_AES void echo512_lane(const __m128i msg[4], uint8_t *out)
+{
+    const __m128i v = _mm_set_epi64x(0, 512);  /* chaining value words: output size */
+    const __m128i zero = _mm_setzero_si128();
+    __m128i w[16], t;
+    uint32_t k = 512;  /* AES key: message bit counter, +1 per word */
+
+    /* One 128-byte block: message, 0x80, output size 512, bit count 512 */
+    SPH_X4_UNROLL
+    for (int i = 0; i < 8; i++) {
+        w[i] = v;
+    }
+    SPH_X4_UNROLL
+    for (int i = 0; i < 4; i++) {
+        w[8 + i] = msg[i];
+    }
+    w[12] = _mm_set_epi64x(0, 0x80);
+    w[13] = zero;
+    w[14] = _mm_set_epi64x(0x0200000000000000LL, 0);
+    w[15] = _mm_set_epi64x(0, 512);
+
+    for (int r = 0; r < 10; r++) {
+        SPH_X4_UNROLL
+        for (int i = 0; i < 16; i++) {
+            w[i] = x4_aes(x4_aes(w[i], _mm_cvtsi32_si128((int)k++)), zero);
+        }
+
+        /* BIG.ShiftRows: rotate rows 1..3 of the 4x4 word matrix */
+        t = w[1];
+        w[1] = w[5];
+        w[5] = w[9];
+        w[9] = w[13];
+        w[13] = t;
+        t = w[2];
+        w[2] = w[10];
+        w[10] = t;
+        t = w[6];
+        w[6] = w[14];
+        w[14] = t;
+        t = w[15];
+        w[15] = w[11];
+        w[11] = w[7];
+        w[7] = w[3];
+        w[3] = t;
+
+        SPH_X4_UNROLL
+        for (int i = 0; i < 16; i += 4) {
+            echo_mix_column(w, i);
+        }
+    }
+
+    SPH_X4_UNROLL
+    for (int i = 0; i < 4; i++) {
+        const __m128i h = _mm_xor_si128(_mm_xor_si128(v, msg[i]), _mm_xor_si128(w[i], w[i + 8]));
+        _mm_storeu_si128((__m128i *)(out + 16 * i), h);
+    }
+}
+
+SPH_X4_TARGET_AES void sph_echo512_x4_64(const uint8_t *const in[4], uint8_t *const out[4])
+{
+    __m128i msg[4][4];
+
+    /* Read every input first: out[j] may alias in[j] */
+    SPH_X4_UNROLL
+    for (int j = 0; j < 4; j++) {
+        SPH_X4_UNROLL
+        for (int i = 0; i < 4; i++) {
+            msg[j][i] = _mm_loadu_si128((const __m128i *)(in[j] + 16 * i));
+        }
+    }
+    for (int j = 0; j < 4; j++) {
+        echo512_lane(msg[j], out[j]);
+    }
+}
+
+/* ── Grøstl-512 (state as eight 16-byte rows) ── */
+
+/*
+ * pshufb masks for row i that fold the ShiftBytes rotation of P (resp. Q)
+ * with the inverse of AES ShiftRows, so that AESENCLAST with a zero key
+ * leaves only SubBytes and ShiftBytes.
+ */
+static const uint8_t groestl_shift[2][8][16] = {
+    {
+        {  0, 13, 10,  7,  4,  1, 14, 11,  8,  5,  2, 15, 12,  9,  6,  3 },
+        {  1, 14, 11,  8,  5,  2, 15, 12,  9,  6,  3,  0, 13, 10,  7,  4 },
+        {  2, 15, 12,  9,  6,  3,  0, 13, 10,  7,  4,  1, 14, 11,  8,  5 },
+        {  3,  0, 13, 10,  7,  4,  1, 14, 11,  8,  5,  2, 15, 12,  9,  6 },
+        {  4,  1, 14, 11,  8,  5,  2, 15, 12,  9,  6,  3,  0, 13, 10,  7 },
+        {  5,  2, 15, 12,  9,  6,  3,  0, 13, 10,  7,  4,  1, 14, 11,  8 },
+        {  6,  3,  0, 13, 10,  7,  4,  1, 14, 11,  8,  5,  2, 15, 12,  9 },
+        { 11,  8,  5,  2, 15, 12,  9,  6,  3,  0, 13, 10,  7,  4,  1, 14 },
+    },
+    {
+        {  1, 14, 11,  8,  5,  2, 15, 12,  9,  6,  3,  0, 13, 10,  7,  4 },
+        {  3,  0, 13, 10,  7,  4,  1, 14, 11,  8,  5,  2, 15, 12,  9,  6 },
+        {  5,  2, 15, 12,  9,  6,  3,  0, 13, 10,  7,  4,  1, 14, 11,  8 },
+        { 11,  8,  5,  2, 15, 12,  9,  6,  3,  0, 13, 10,  7,  4,  1, 14 },
+        {  0, 13, 10,  7,  4,  1, 14, 11,  8,  5,  2, 15, 12,  9,  6,  3 },
+        {  2, 15, 12,  9,  6,  3,  0, 13, 10,  7,  4,  1, 14, 11,  8,  5 },
+        {  4,  1, 14, 11,  8,  5,  2, 15, 12,  9,  6,  3,  0, 13, 10,  7 },
+        {  6,  3,  0, 13, 10,  7,  4,  1, 14, 11,  8,  5,  2, 15, 12,  9 },
+    },
+};
+
+/* 8x8 byte transpose: in[k] holds 8-byte rows 2k, 2k+1; out likewise */
+static SPH_X4_TARGET_AES SPH_X4_INLINE void x4_transpose8x8(const __m128i in[4], __m128i out[4])
+{
+    const __m128i pair = _mm_setr_epi8(0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13, 6, 14, 7, 15);
+    const __m128i t0 = _mm_shuffle_epi8(in[0], pair);
+    const __m128i t1 = _mm_shuffle_epi8(in[1], pair);
+    const __m128i t2 = _mm_shuffle_epi8(in[2], pair);
+    const __m128i t3 = _mm_shuffle_epi8(in[3], pair);
+    const __m128i u0 = _mm_unpacklo_epi16(t0, t1);
+    const __m128i u1 = _mm_unpackhi_epi16(t0, t1);
+    const __m128i u2 = _mm_unpacklo_epi16(t2, t3);
+    const __m128i u3 = _mm_unpackhi_epi16(t2, t3);
+    out[0] = _mm_unpacklo_epi32(u0, u2);
+    out[1] = _mm_unpackhi_epi32(u0, u2);
+    out[2] = _mm_unpacklo_epi32(u1, u3);
+    out[3] = _mm_unpackhi_epi32(u1, u3);
+}
+
+/* One round of P (q = 0) or Q (q = 1) */
+static SPH_X4_TARGET_AES SPH_X4_INLINE void groestl_round(__m128i x[8], int r, int q)
+{
+    const __m128i col = _mm_setr_epi8(0x00, 0x10, 0x20, 0x30, 0x40, 0x50, 0x60, 0x70,
+                                      (char)0x80, (char)0x90, (char)0xA0, (char)0xB0,
+                                      (char)0xC0, (char)0xD0, (char)0xE0, (char)0xF0);
+    const __m128i ones = _mm_set1_epi8(-1);
+    const __m128i rc = _mm_xor_si128(col, _mm_set1_epi8((char)r));
+    __m128i y[8];
+
+    /* AddRoundConstant */
+    if (!q) {
+        x[0] = _mm_xor_si128(x[0], rc);
+    } else {
+        SPH_X4_UNROLL
+        for (int i = 0; i < 7; i++) {
+            x[i] = _mm_xor_si128(x[i], ones);
+        }
+        x[7] = _mm_xor_si128(x[7], _mm_xor_si128(rc, ones));
+    }
+
+    /* SubBytes + ShiftBytes */
+    SPH_X4_UNROLL
+    for (int i = 0; i < 8; i++) {
+        const __m128i mask = _mm_loadu_si128((const __m128i *)groestl_shift[q][i]);
+        x[i] = _mm_aesenclast_si128(_mm_shuffle_epi8(x[i], mask), _mm_setzero_si128());
+    }
+
+    /*
+     * MixBytes: row i becomes sum_d b[d] * row[i + d] with
+     * b = (02, 02, 03, 04, 05, 03, 05, 07), split by coefficient bit.
+     */
+    SPH_X4_UNROLL
+    for (int i = 0; i < 8; i++) {
+#define GR_ROW(d) x[(i + (d)) & 7]
+        const __m128i b0 = _mm_xor_si128(_mm_xor_si128(GR_ROW(2), GR_ROW(4)),
+                                         _mm_xor_si128(_mm_xor_si128(GR_ROW(5), GR_ROW(6)), GR_ROW(7)));
+        const __m128i b1 = _mm_xor_si128(_mm_xor_si128(GR_ROW(0), GR_ROW(1)),
+                                         _mm_xor_si128(_mm_xor_si128(GR_ROW(2), GR_ROW(5)), GR_ROW(7)));
+        const __m128i b2 = _mm_xor_si128(_mm_xor_si128(GR_ROW(3), GR_ROW(4)),
+                                         _mm_xor_si128(GR_ROW(6), GR_ROW(7)));
+#undef GR_ROW
+        y[i] = _mm_xor_si128(b0, x4_xtime(_mm_xor_si128(b1, x4_xtime(b2))));
+    }
+    SPH_X4_UNROLL
+    for (int i = 0; i < 8; i++) {
+        x[i] = y[i];
+    }
+}
+
+static SPH_X4_TARGET_AES void groestl512_lane(const __m128i msg[4], uint8_t *out)
+{
+    __m128i rows[4], m[8], h[8], p[8];
+
+    /* One 128-byte block: message (columns 0..7), 0x80, block count 1 */
+    x4_transpose8x8(msg, rows);
+    SPH_X4_UNROLL
+    for (int i = 0; i < 4; i++) {
+        m[2 * i] = _mm_unpacklo_epi64(rows[i], _mm_setzero_si128());
+        m[2 * i + 1] = _mm_unpackhi_epi64(rows[i], _mm_setzero_si128());
+    }
+    m[0] = _mm_xor_si128(m[0], _mm_set_epi64x(0x80, 0));
+    m[7] = _mm_xor_si128(m[7], _mm_set_epi64x(0x0100000000000000LL, 0));
+
+    /* IV: output size 512 in the last two bytes */
+    SPH_X4_UNROLL
+    for (int i = 0; i < 8; i++) {
+        h[i] = _mm_setzero_si128();
+    }
+    h[6] = _mm_set_epi64x(0x0200000000000000LL, 0);
+
+    /* h = P(h ^ m) ^ Q(m) ^ h, with P and Q interleaved */
+    SPH_X4_UNROLL
+    for (int i = 0; i < 8; i++) {
+        p[i] = _mm_xor_si128(h[i], m[i]);
+    }
+    for (int r = 0; r < 14; r++) {
+        groestl_round(p, r, 0);
+        groestl_round(m, r, 1);
+    }
+    SPH_X4_UNROLL
+    for (int i = 0; i < 8; i++) {
+        h[i] = _mm_xor_si128(h[i], _mm_xor_si128(p[i], m[i]));
+        p[i] = h[i];
+    }
+
+    /* Output transform: P(h) ^ h, truncated to columns 8..15 */
+    for (int r = 0; r < 14; r++) {
+        groestl_round(p, r, 0);
+    }
+    SPH_X4_UNROLL
+    for (int i = 0; i < 4; i++) {
+        rows[i] = _mm_unpackhi_epi64(_mm_xor_si128(p[2 * i], h[2 * i]),
+                                     _mm_xor_si128(p[2 * i + 1], h[2 * i + 1]));
+    }
+    x4_transpose8x8(rows, m);
+    SPH_X4_UNROLL
+    for (int i = 0; i < 4; i++) {
+        _mm_storeu_si128((__m128i *)(out + 16 * i), m[i]);
+    }
+}
+
+SPH_X4_TARGET_AES void sph_groestl512_x4_64(const uint8_t *const in[4], uint8_t *const out[4])
+{
+    __m128i msg[4][4];
+
+    /* Read every input first: out[j] may alias in[j] */
+    SPH_X4_UNROLL
+    for (int j = 0; j < 4; j++) {
+        SPH_X4_UNROLL
+        for (int i = 0; i < 4; i++) {
+            msg[j][i] = _mm_loadu_si128((const __m128i *)(in[j] + 16 * i));
+        }
+    }
+    for (int j = 0; j < 4; j++) {
+        groestl512_lane(msg[j], out[j]);
+    }
+}
+
+/* ── SHAvite-3-512 ── */
+
+static const uint32_t shavite_iv[16] = {
+    0x72FCCDD8, 0x79CA4727, 0x128A077B, 0x40D55AEC, 0xD1901A06, 0x430AE307, 0xB29F5CD1, 0xDF07FBFC,
+    0x8E45D73D, 0x681AB538, 0xBDE86578, 0xDD577E47, 0xE275EADE, 0x502D9FCD, 0xB9357178, 0x022A4B9A,
+};
+
+/* Message expansion of the single block into 112 round-key words */
+static SPH_X4_TARGET_AES void shavite_expand(__m128i rk[112], const __m128i msg[4])
+{
+    const __m128i zero = _mm_setzero_si128();
+    int i;
+
+    /* Message, 0x80, bit count 512 at byte 110, output size 512 at 126 */
+    SPH_X4_UNROLL
+    for (i = 0; i < 4; i++) {
+        rk[i] = msg[i];
+    }
+    rk[4] = _mm_set_epi64x(0, 0x80);
+    rk[5] = zero;
+    rk[6] = _mm_set_epi64x(0x0200000000000000LL, 0);
+    rk[7] = _mm_set_epi64x(0x0200000000000000LL, 0);
+
+    i = 8;
+    for (;;) {
+        /* Nonlinear: AES round of the rotated word, counter mixed in 4 times */
+        SPH_X4_UNROLL
+        for (int s = 0; s < 8; s++, i++) {
+            __m128i x = x4_aes(_mm_shuffle_epi32(rk[i - 8], 0x39), zero);
+            x = _mm_xor_si128(x, rk[i - 1]);
+            switch (i) {
+            case 8:   x = _mm_xor_si128(x, _mm_set_epi32(-1, 0, 0, 512)); break;
+            case 41:  x = _mm_xor_si128(x, _mm_set_epi32(~512, 0, 0, 0)); break;
+            case 79:  x = _mm_xor_si128(x, _mm_set_epi32(-1, 512, 0, 0)); break;
+            case 110: x = _mm_xor_si128(x, _mm_set_epi32(-1, 0, 512, 0)); break;
+            default:  break;
+            }
+            rk[i] = x;
+        }
+        if (i == 112) {
+            break;
+        }
+        /* Linear: rk[i] = rk[i - 8] ^ (rk[i - 2], rk[i - 1]) shifted by one 32-bit word */
+        SPH_X4_UNROLL
+        for (int s = 0; s < 8; s++, i++) {
+            rk[i] = _mm_xor_si128(rk[i - 8], _mm_alignr_epi8(rk[i - 1], rk[i - 2], 4));
+        }
+    }
+}
+
+/* One round: two Feistel branches of four AES rounds, then a word rotation */
+static SPH_X4_TARGET_AES SPH_X4_INLINE void shavite_round(__m128i p[4], const __m128i *rk)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i x, t;
+
+    x = _mm_xor_si128(p[1], rk[0]);
+    x = x4_aes(x4_aes(x4_aes(x4_aes(x, rk[1]), rk[2]), rk[3]), zero);
+    p[0] = _mm_xor_si128(p[0], x);
+    x = _mm_xor_si128(p[3], rk[4]);
+    x = x4_aes(x4_aes(x4_aes(x4_aes(x, rk[5]), rk[6]), rk[7]), zero);
+    p[2] = _mm_xor_si128(p[2], x);
+
+    t = p[3];
+    p[3] = p[2];
+    p[2] = p[1];
+    p[1] = p[0];
+    p[0] = t;
+}
+
+SPH_X4_TARGET_AES void sph_shavite512_x4_64(const uint8_t *const in[4], uint8_t *const out[4])
+{
+    __m128i rk[4][112], p[4][4], iv[4];
+
+    SPH_X4_UNROLL
+    for (int i = 0; i < 4; i++) {
+        iv[i] = _mm_loadu_si128((const __m128i *)(shavite_iv + 4 * i));
+    }
+    for (int j = 0; j < 4; j++) {
+        __m128i msg[4];
+        SPH_X4_UNROLL
+        for (int i = 0; i < 4; i++) {
+            msg[i] = _mm_loadu_si128((const __m128i *)(in[j] + 16 * i));
+            p[j][i] = iv[i];
+        }
+        shavite_expand(rk[j], msg);
+    }
+
+    for (int r = 0; r < 14; r++) {
+        SPH_X4_UNROLL
+        for (int j = 0; j < 4; j++) {
+            shavite_round(p[j], rk[j] + 8 * r);
+        }
+    }
+
+    SPH_X4_UNROLL
+    for (int j = 0; j < 4; j++) {
+        SPH_X4_UNROLL
+        for (int i = 0; i < 4; i++) {
+            _mm_storeu_si128((__m128i *)(out[j] + 16 * i), _mm_xor_si128(p[j][i], iv[i]));
+        }
+    }
+}
+
+#else /* !SPH_X4_HAVE_AVX2 */
+
+int sph_x4_available(void)
+{
+    return 0;
+}
+
+#endif
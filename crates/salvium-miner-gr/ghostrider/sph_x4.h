@@ -0,0 +1,70 @@
+/*
+ * 4-way multi-buffer SPH-512 kernels for the GhostRider core hash chain.
+ *
+ * All lanes of a GhostRider batch run the same core hash order, and every
+ * core hash after the first one hashes a 64-byte message.  Each kernel
+ * here hashes four such messages at once, one message per SIMD lane, and
+ * produces the same 64-byte digests as the scalar sph_* functions.
+ *
+ * The kernels use AVX2, and the AES-round ones (ECHO, Grøstl, SHAvite-3)
+ * also AES-NI.  They are only built on x86; callers must check the
+ * features reported by sph_x4_available() before using them.
+ */
+
+#ifndef SPH_X4_H
+#define SPH_X4_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define SPH_X4_HAVE_AVX2 1
+#endif
+
+/* Number of messages hashed per call */
+#define SPH_X4_LANES 4
+
+/* Hash four 64-byte messages into four 64-byte digests */
+typedef void (*sph_x4_hash64_fn)(const uint8_t *const in[SPH_X4_LANES],
+                                 uint8_t *const out[SPH_X4_LANES]);
+
+/* Feature bits reported by sph_x4_available() */
+#define SPH_X4_AVX2 1  /* every kernel needs this */
+#define SPH_X4_AES  2  /* echo512, groestl512, shavite512 also need this */
+
+/* SPH_X4_* bits usable on this CPU (and OS), 0 when none */
+int sph_x4_available(void);
+
+#ifdef SPH_X4_HAVE_AVX2
+void sph_blake512_x4_64(const uint8_t *const in[SPH_X4_LANES],
+                        uint8_t *const out[SPH_X4_LANES]);
+void sph_bmw512_x4_64(const uint8_t *const in[SPH_X4_LANES],
+                      uint8_t *const out[SPH_X4_LANES]);
+void sph_keccak512_x4_64(const uint8_t *const in[SPH_X4_LANES],
+                         uint8_t *const out[SPH_X4_LANES]);
+void sph_skein512_x4_64(const uint8_t *const in[SPH_X4_LANES],
+                        uint8_t *const out[SPH_X4_LANES]);
+void sph_cubehash512_x4_64(const uint8_t *const in[SPH_X4_LANES],
+                           uint8_t *const out[SPH_X4_LANES]);
+void sph_luffa512_x4_64(const uint8_t *const in[SPH_X4_LANES],
+                        uint8_t *const out[SPH_X4_LANES]);
+void sph_shabal512_x4_64(const uint8_t *const in[SPH_X4_LANES],
+                         uint8_t *const out[SPH_X4_LANES]);
+
+/* AES-round kernels: also need SPH_X4_AES */
+void sph_echo512_x4_64(const uint8_t *const in[SPH_X4_LANES],
+                       uint8_t *const out[SPH_X4_LANES]);
+void sph_groestl512_x4_64(const uint8_t *const in[SPH_X4_LANES],
+                          uint8_t *const out[SPH_X4_LANES]);
+void sph_shavite512_x4_64(const uint8_t *const in[SPH_X4_LANES],
+                          uint8_t *const out[SPH_X4_LANES]);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPH_X4_H */
@@ -173,6 +173,55 @@ mod tests {
         }
     }
 
+    #[test]
+    fn test_sph_x4_matches_scalar() {
+        // Four different 64-byte messages, as in the core hash chain
+        let mut inputs = [0u8; 4 * 64];
+        for (i, b) in inputs.iter_mut().enumerate() {
+            *b = (i * 31 + 7) as u8;
+        }
+
+        let features = unsafe { ffi::ghostrider_sph_x4_features() };
+        if features == 0 {
+            eprintln!("skipping test_sph_x4_matches_scalar: no AVX2 on this CPU");
+            return;
+        }
+
+        // blake, bmw, keccak, skein, luffa, cubehash, shabal need AVX2;
+        // groestl, shavite, echo need AES-NI as well
+        let mut expected = vec![0, 1, 4, 5, 6, 7, 13];
+        if features & 2 != 0 {
+            expected.extend_from_slice(&[2, 8, 10]);
+        } else {
+            eprintln!("test_sph_x4_matches_scalar: no AES-NI, AES kernels not checked");
+        }
+
+        for algo in 0..15 {
+            let mut outputs = [0u8; 4 * 64];
+            let ret =
+                unsafe { ffi::ghostrider_sph_hash_x4(algo, inputs.as_ptr(), outputs.as_mut_ptr()) };
+            assert_eq!(
+                ret == 0,
+                expected.contains(&algo),
+                "algo {} kernel availability differs from the expected set",
+                algo
+            );
+            if ret != 0 {
+                continue;
+            }
+            for lane in 0..4 {
+                let expected = sph_hash(algo, &inputs[lane * 64..(lane + 1) * 64]);
+                assert_eq!(
+                    &outputs[lane * 64..(lane + 1) * 64],
+                    &expected[..],
+                    "algo {} lane {} differs from scalar",
+                    algo,
+                    lane
+                );
+            }
+        }
+    }
+
     // ── XMRig reference test vectors ─────────────────────────────────
     // XMRig verifies GhostRider via XOR-differential: for 8 slots (i=0..7):
     //   blob1: 80 zero-bytes with [0]=i, [4]=0x10, [5]=0x02
@@ -229,10 +278,7 @@ mod tests {
         );
     }
 
-    #[test]
-    fn test_ghostrider_xmrig_vectors_all_8_slots() {
-        let mut engine = GhostRiderEngine::new();
-
+    fn assert_xmrig_vectors(engine: &mut GhostRiderEngine) {
         for i in 0u8..8 {
             let mut blob1 = [0u8; 80];
             blob1[0] = i;
@@ -259,6 +305,236 @@ mod tests {
         }
     }
 
+    #[test]
+    fn test_ghostrider_xmrig_vectors_all_8_slots() {
+        let mut engine = GhostRiderEngine::new();
+        assert_xmrig_vectors(&mut engine);
+    }
+
+    #[test]
+    fn test_ghostrider_xmrig_vectors_soft_aes() {
+        let mut engine = GhostRiderEngine::new();
+        assert_eq!(unsafe { ffi::ghostrider_set_aes_impl(engine.ctx, 0) }, 0);
+        assert_xmrig_vectors(&mut engine);
+    }
+
+    // ── CryptoNight AES implementations ──────────────────────────────
+    // Each GR CryptoNight variant hashes the bytes 0..64; the expected
+    // values come from the software AES path. Hardware AES must match.
+
+    const CN_VARIANT_VECTORS: [&str; 6] = [
+        "1915e5344736aa3a2fd5ac5f3cd345ed1f54f5833fe24e0121a0b15e6251998d",
+        "1b611a59ba13c530279b45552370d045bc8c6e9fbce6cdc0a50bca1bc75d25ae",
+        "1408fe1c80a76a3cc8bf02c9165231e1a1ab0b5ffcaafab424dd872a110f8210",
+        "defd7ed613ef6238b21341bcede5fd7317bf3925dd968101eb80d4d0a2c29cd2",
+        "be3edde065e49d5345205b0ff58cd5cf31dda20c853e0374aa61ccf8e46dce4a",
+        "5ebde1d5a910fc1b84745d590cca2d54dfe64740f20c868f64db02a2f0bda0b3",
+    ];
+
+    fn assert_cn_variant_vectors(engine: &GhostRiderEngine) {
+        let input: Vec<u8> = (0u8..64).collect();
+        for (variant, expected) in CN_VARIANT_VECTORS.iter().enumerate() {
+            let mut output = [0u8; 32];
+            let ret = unsafe {
+                ffi::ghostrider_cn_hash(
+                    variant as i32,
+                    input.as_ptr(),
+                    input.len(),
+                    output.as_mut_ptr(),
+                    engine.ctx,
+                )
+            };
+            assert_eq!(ret, 0, "cn_hash({}) failed", variant);
+            assert_eq!(hex::encode(output), *expected, "CN variant {} mismatch", variant);
+        }
+    }
+
+    #[test]
+    fn test_cn_variants_soft_aes() {
+        let engine = GhostRiderEngine::new();
+        assert_eq!(unsafe { ffi::ghostrider_set_aes_impl(engine.ctx, 0) }, 0);
+        assert_cn_variant_vectors(&engine);
+    }
+
+    #[test]
+    fn test_cn_variants_hw_aes() {
+        let engine = GhostRiderEngine::new();
+        if unsafe { ffi::ghostrider_set_aes_impl(engine.ctx, 1) } != 0 {
+            eprintln!("hardware AES not available, skipping");
+            return;
+        }
+        assert_cn_variant_vectors(&engine);
+    }
+
+    // ── Multi-hash (interleaved CryptoNight) ─────────────────────────
+
+    #[test]
+    fn test_ghostrider_hash_multi_matches_single() {
+        let mut engines: Vec<GhostRiderEngine> = (0..4).map(|_| GhostRiderEngine::new()).collect();
+        let ctxs: Vec<*mut c_void> = engines.iter().map(|e| e.ctx).collect();
+
+        // Same seed (bytes 4..36) in every lane, different nonces
+        let mut inputs = [0u8; 4 * 80];
+        for (lane, blob) in inputs.chunks_mut(80).enumerate() {
+            blob[4] = 0x10;
+            blob[5] = 0x02;
+            blob[39] = lane as u8;
+        }
+        let expected: Vec<[u8; 32]> = inputs.chunks(80).map(|blob| engines[0].hash(blob)).collect();
+
+        for n in 2..=4 {
+            let mut outputs = [0u8; 4 * 32];
+            let ret = unsafe {
+                ffi::ghostrider_hash_multi(
+                    inputs.as_ptr(),
+                    80,
+                    n,
+                    outputs.as_mut_ptr(),
+                    ctxs.as_ptr(),
+                )
+            };
+            assert_eq!(ret, 0, "ghostrider_hash_multi(n={}) failed", n);
+            for lane in 0..n {
+                assert_eq!(
+                    &outputs[lane * 32..(lane + 1) * 32],
+                    &expected[lane][..],
+                    "lane {} of {} differs from ghostrider_hash",
+                    lane,
+                    n
+                );
+            }
+        }
+
+        // Lanes with different seeds cannot share the algorithm order
+        inputs[80 + 4] ^= 1;
+        let mut outputs = [0u8; 4 * 32];
+        let ret = unsafe {
+            ffi::ghostrider_hash_multi(inputs.as_ptr(), 80, 2, outputs.as_mut_ptr(), ctxs.as_ptr())
+        };
+        assert_ne!(ret, 0, "mismatched seeds must be rejected");
+    }
+
+    #[test]
+    fn test_ghostrider_hash_job_matches_hash() {
+        let engine = GhostRiderEngine::new();
+
+        // Stratum header (nonce at 76) and a blob with the nonce mid-input
+        for &(len, nonce_offset) in &[(80usize, 76usize), (80, 39)] {
+            let mut blob: Vec<u8> = (0..len).map(|i| (i * 13 + 1) as u8).collect();
+            let job = unsafe { ffi::ghostrider_prepare_job(blob.as_ptr(), len, nonce_offset) };
+            assert!(!job.is_null(), "ghostrider_prepare_job failed");
+
+            for &nonce in &[0u32, 1, 0x1234_5678, u32::MAX] {
+                blob[nonce_offset..nonce_offset + 4].copy_from_slice(&nonce.to_le_bytes());
+                let expected = engine.hash(&blob);
+                let mut output = [0u8; 32];
+                let ret = unsafe {
+                    ffi::ghostrider_hash_job(job, nonce, output.as_mut_ptr(), engine.ctx)
+                };
+                assert_eq!(ret, 0, "ghostrider_hash_job failed");
+                assert_eq!(
+                    output, expected,
+                    "job hash differs at offset {} nonce {:#x}",
+                    nonce_offset, nonce
+                );
+            }
+            unsafe { ffi::ghostrider_free_job(job) };
+        }
+
+        // Nonce must fit inside the blob
+        let blob = [0u8; 80];
+        let job = unsafe { ffi::ghostrider_prepare_job(blob.as_ptr(), 80, 77) };
+        assert!(job.is_null(), "out-of-range nonce offset must be rejected");
+
+        // Nonce must not overlap the seed (bytes 4..36) the schedule derives from
+        for nonce_offset in [1usize, 4, 20, 32, 35] {
+            let job = unsafe { ffi::ghostrider_prepare_job(blob.as_ptr(), 80, nonce_offset) };
+            assert!(
+                job.is_null(),
+                "nonce offset {} overlapping the seed must be rejected",
+                nonce_offset
+            );
+        }
+        for nonce_offset in [0usize, 36] {
+            let job = unsafe { ffi::ghostrider_prepare_job(blob.as_ptr(), 80, nonce_offset) };
+            assert!(
+                !job.is_null(),
+                "nonce offset {} outside the seed must be accepted",
+                nonce_offset
+            );
+            unsafe { ffi::ghostrider_free_job(job) };
+        }
+    }
+
+    #[test]
+    fn test_ghostrider_hash_job_multi_matches_hash() {
+        let mut engines: Vec<GhostRiderEngine> = (0..4).map(|_| GhostRiderEngine::new()).collect();
+        let ctxs: Vec<*mut c_void> = engines.iter().map(|e| e.ctx).collect();
+
+        let mut blob: Vec<u8> = (0..80).map(|i| (i * 29 + 3) as u8).collect();
+        let job = unsafe { ffi::ghostrider_prepare_job(blob.as_ptr(), 80, 76) };
+        assert!(!job.is_null(), "ghostrider_prepare_job failed");
+
+        let nonces = [7u32, 0x0100_0000, 0xdead_beef, 42];
+        let mut outputs = [0u8; 4 * 32];
+        let ret = unsafe {
+            ffi::ghostrider_hash_job_multi(
+                job,
+                nonces.as_ptr(),
+                4,
+                outputs.as_mut_ptr(),
+                ctxs.as_ptr(),
+            )
+        };
+        assert_eq!(ret, 0, "ghostrider_hash_job_multi failed");
+
+        for (lane, &nonce) in nonces.iter().enumerate() {
+            blob[76..80].copy_from_slice(&nonce.to_le_bytes());
+            assert_eq!(
+                &outputs[lane * 32..(lane + 1) * 32],
+                &engines[0].hash(&blob)[..],
+                "lane {} differs from ghostrider_hash",
+                lane
+            );
+        }
+        unsafe { ffi::ghostrider_free_job(job) };
+    }
+
+    #[test]
+    fn test_ghostrider_multi_rejects_mixed_aes_impls() {
+        let engines: Vec<GhostRiderEngine> = (0..2).map(|_| GhostRiderEngine::new()).collect();
+        let ctxs: Vec<*mut c_void> = engines.iter().map(|e| e.ctx).collect();
+        if unsafe { ffi::ghostrider_set_aes_impl(ctxs[0], 1) } != 0 {
+            eprintln!("hardware AES not available, skipping");
+            return;
+        }
+        assert_eq!(unsafe { ffi::ghostrider_set_aes_impl(ctxs[1], 0) }, 0);
+
+        let mut inputs = [0u8; 2 * 80];
+        inputs[80 + 39] = 1;
+        let mut outputs = [0u8; 2 * 32];
+        let ret = unsafe {
+            ffi::ghostrider_hash_multi(inputs.as_ptr(), 80, 2, outputs.as_mut_ptr(), ctxs.as_ptr())
+        };
+        assert_ne!(ret, 0, "lanes with different AES implementations must be rejected");
+
+        let job = unsafe { ffi::ghostrider_prepare_job(inputs.as_ptr(), 80, 76) };
+        assert!(!job.is_null(), "ghostrider_prepare_job failed");
+        let nonces = [1u32, 2];
+        let ret = unsafe {
+            ffi::ghostrider_hash_job_multi(job, nonces.as_ptr(), 2, outputs.as_mut_ptr(), ctxs.as_ptr())
+        };
+        assert_ne!(ret, 0, "lanes with different AES implementations must be rejected");
+        unsafe { ffi::ghostrider_free_job(job) };
+
+        // Software AES in every lane is accepted
+        assert_eq!(unsafe { ffi::ghostrider_set_aes_impl(ctxs[0], 0) }, 0);
+        let ret = unsafe {
+            ffi::ghostrider_hash_multi(inputs.as_ptr(), 80, 2, outputs.as_mut_ptr(), ctxs.as_ptr())
+        };
+        assert_eq!(ret, 0, "ghostrider_hash_multi failed");
+    }
+
     // ── Mining loop integration test ──────────────────────────────────
 
     #[test]
@@ -21,6 +21,71 @@ extern "C" {
         ctx: *mut c_void,
     ) -> i32;
 
+    /// Compute `n` (1..=4) GhostRider hashes with interleaved CryptoNight rounds.
+    ///
+    /// inputs: `n` blobs of `input_len` bytes back to back, all with the same
+    /// seed (bytes 4..36). outputs: `n * 32` bytes. ctx: `n` distinct contexts.
+    /// Returns 0 on success, non-zero on error (including mismatched seeds).
+    pub fn ghostrider_hash_multi(
+        inputs: *const u8,
+        input_len: usize,
+        n: usize,
+        outputs: *mut u8,
+        ctx: *const *mut c_void,
+    ) -> i32;
+
+    /// Prepare a job for repeated hashing: resolves the algorithm order from the
+    /// seed (bytes 4..36) and absorbs the bytes before `nonce_offset` once.
+    ///
+    /// Returns an opaque job handle, or null on error. Free with ghostrider_free_job().
+    pub fn ghostrider_prepare_job(
+        input: *const u8,
+        input_len: usize,
+        nonce_offset: usize,
+    ) -> *mut c_void;
+
+    /// Compute the GhostRider hash of a prepared job with a little-endian nonce.
+    ///
+    /// Returns 0 on success, non-zero on error.
+    pub fn ghostrider_hash_job(
+        job: *const c_void,
+        nonce: u32,
+        output: *mut u8,
+        ctx: *mut c_void,
+    ) -> i32;
+
+    /// Compute `n` (1..=4) hashes of a prepared job with interleaved CryptoNight rounds.
+    ///
+    /// nonces: `n` values. outputs: `n * 32` bytes. ctx: `n` distinct contexts.
+    /// Returns 0 on success, non-zero on error.
+    pub fn ghostrider_hash_job_multi(
+        job: *const c_void,
+        nonces: *const u32,
+        n: usize,
+        outputs: *mut u8,
+        ctx: *const *mut c_void,
+    ) -> i32;
+
+    /// Free a job previously returned by ghostrider_prepare_job().
+    pub fn ghostrider_free_job(job: *mut c_void);
+
+    /// Select the AES implementation used by the context's CryptoNight rounds
+    /// (0 = software, 1 = AES-NI / ARMv8 Crypto Extension).
+    ///
+    /// Returns 0 on success, non-zero if the implementation is not available.
+    pub fn ghostrider_set_aes_impl(ctx: *mut c_void, aes_impl: i32) -> i32;
+
+    /// Compute a single CryptoNight hash of one GhostRider variant (0..=5) for testing.
+    ///
+    /// input_len must be >= 43. output: 32-byte buffer
+    pub fn ghostrider_cn_hash(
+        variant: i32,
+        input: *const u8,
+        input_len: usize,
+        output: *mut u8,
+        ctx: *mut c_void,
+    ) -> i32;
+
     /// Compute an individual SPH-512 hash for testing.
     ///
     /// algo_index: 0=blake, 1=bmw, 2=groestl, 3=jh, 4=keccak, 5=skein,
@@ -33,4 +98,13 @@ extern "C" {
         input_len: usize,
         output: *mut u8,
     ) -> i32;
+
+    /// Compute four SPH-512 hashes of 64-byte inputs with the multi-buffer kernel.
+    ///
+    /// inputs, outputs: 4 * 64 bytes back to back.
+    /// Returns non-zero if the algorithm has no kernel or the CPU lacks its features.
+    pub fn ghostrider_sph_hash_x4(algo_index: i32, inputs: *const u8, outputs: *mut u8) -> i32;
+
+    /// CPU features usable by the multi-buffer kernels: bit 0 AVX2, bit 1 AES-NI.
+    pub fn ghostrider_sph_x4_features() -> i32;
 }
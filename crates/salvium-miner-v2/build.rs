@@ -2,11 +2,15 @@ use cmake::Config;
 
 fn main() {
     // Build vendored RandomX v2 using cmake
-    let dst = Config::new("randomx-v2")
+    let mut config = Config::new("randomx-v2");
+    config
         .define("CMAKE_BUILD_TYPE", "Release")
         // Build as static library
-        .build_target("randomx")
-        .build();
+        .build_target("randomx");
+    if std::env::var_os("CARGO_FEATURE_VM_STATS").is_some() {
+        config.define("RANDOMX_VM_STATS", "ON");
+    }
+    let dst = config.build();
 
     // Link the built library
     println!("cargo:rustc-link-search=native={}/build", dst.display());
@@ -30,6 +30,43 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <cstddef>
 
+//AesHash1R:
+//state0, state1, state2, state3 = Blake2b-512("RandomX AesHash1R state")
+//xkey0, xkey1 = Blake2b-256("RandomX AesHash1R xkeys")
+
+#define AES_HASH_1R_STATE0 0xd7983aad, 0xcc82db47, 0x9fa856de, 0x92b52c0d
+#define AES_HASH_1R_STATE1 0xace78057, 0xf59e125a, 0x15c7b798, 0x338d996e
+#define AES_HASH_1R_STATE2 0xe8a07ce4, 0x5079506b, 0xae62c7d0, 0x6a770017
+#define AES_HASH_1R_STATE3 0x7e994948, 0x79a10005, 0x07ad828d, 0x630a240c
+
+#define AES_HASH_1R_XKEY0 0x06890201, 0x90dc56bf, 0x8b24949f, 0xf6fa8389
+#define AES_HASH_1R_XKEY1 0xed18f99b, 0xee1043c6, 0x51f4e03c, 0x61b263d1
+
+//AesGenerator1R:
+//key0, key1, key2, key3 = Blake2b-512("RandomX AesGenerator1R keys")
+
+#define AES_GEN_1R_KEY0 0xb4f44917, 0xdbb5552b, 0x62716609, 0x6daca553
+#define AES_GEN_1R_KEY1 0x0da1dc4e, 0x1725d378, 0x846a710d, 0x6d7caf07
+#define AES_GEN_1R_KEY2 0x3e20e345, 0xf4c0794f, 0x9f947ec6, 0x3f1262f1
+#define AES_GEN_1R_KEY3 0x49169154, 0x16314c88, 0xb1ba317c, 0x6aef8135
+
+//AesGenerator4R:
+//key0, key1, key2, key3 = Blake2b-512("RandomX AesGenerator4R keys 0-3")
+//key4, key5, key6, key7 = Blake2b-512("RandomX AesGenerator4R keys 4-7")
+
+#define AES_GEN_4R_KEY0 0x99e5d23f, 0x2f546d2b, 0xd1833ddb, 0x6421aadd
+#define AES_GEN_4R_KEY1 0xa5dfcde5, 0x06f79d53, 0xb6913f55, 0xb20e3450
+#define AES_GEN_4R_KEY2 0x171c02bf, 0x0aa4679f, 0x515e7baf, 0x5c3ed904
+#define AES_GEN_4R_KEY3 0xd8ded291, 0xcd673785, 0xe78f5d08, 0x85623763
+#define AES_GEN_4R_KEY4 0x229effb4, 0x3d518b6d, 0xe3d6a7a6, 0xb5826f73
+#define AES_GEN_4R_KEY5 0xb272b7d2, 0xe9024d4e, 0x9c10b3d9, 0xc7566bf3
+#define AES_GEN_4R_KEY6 0xf63befa7, 0x2ba9660a, 0xf765a38b, 0xf273c9e7
+#define AES_GEN_4R_KEY7 0xc0b0762d, 0x0c06d1fd, 0x915839de, 0x7a7cd609
+
+//returns true if the VAES versions are compiled in and supported by the CPU
+bool hasVaesAesHash();
+bool vaesAesHashCompiled();
+
 template<bool softAes>
 void hashAes1Rx4(const void *input, size_t inputSize, void *hash);
 
@@ -41,3 +78,24 @@ void fillAes4Rx4(void *state, size_t outputSize, void *buffer);
 
 template<bool softAes>
 void hashAndFillAes1Rx4(void *scratchpad, size_t scratchpadSize, void *hash, void* fill_state);
+
+//VAES versions for hardware AES, each 256-bit register holds the two AES columns
+//that use the same instruction (aesenc or aesdec), so one VAES instruction does the
+//work of two AES-NI instructions. Only callable if hasVaesAesHash() returns true.
+//There are no VAES versions of fillAes1Rx4 and hashAndFillAes1Rx4: they are bound by
+//the scratchpad stores, and the extra shuffles made them slower than AES-NI.
+void hashAes1Rx4Vaes(const void *input, size_t inputSize, void *hash);
+void fillAes4Rx4Vaes(void *state, size_t outputSize, void *buffer);
+
+//ARMv8 Crypto Extension versions for hardware AES. They are used instead of the
+//generic code whenever the library is built for AArch64 with the crypto extension.
+#if (defined(__aarch64__) || defined(_M_ARM64)) && defined(__ARM_FEATURE_CRYPTO)
+#define RANDOMX_ARMV8_AES_HASH 1
+#else
+#define RANDOMX_ARMV8_AES_HASH 0
+#endif
+
+void hashAes1Rx4Armv8(const void *input, size_t inputSize, void *hash);
+void fillAes1Rx4Armv8(void *state, size_t outputSize, void *buffer);
+void fillAes4Rx4Armv8(void *state, size_t outputSize, void *buffer);
+void hashAndFillAes1Rx4Armv8(void *scratchpad, size_t scratchpadSize, void *hash, void* fill_state);
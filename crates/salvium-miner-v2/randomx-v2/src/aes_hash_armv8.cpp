@@ -0,0 +1,261 @@
+/*
+Copyright (c) 2026, The Salvium Project
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in the
+	  documentation and/or other materials provided with the distribution.
+	* Neither the name of the copyright holder nor the
+	  names of its contributors may be used to endorse or promote products
+	  derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include <cassert>
+#include <cstdint>
+#include "aes_hash.hpp"
+
+#if RANDOMX_ARMV8_AES_HASH
+
+#include <arm_neon.h>
+
+//AESE/AESD xor the round key *before* the S-box while aesenc/aesdec xor it
+//after MixColumns. Instead of emulating the x86 order with an extra EOR per
+//round (which sits on the dependency chain), each lane keeps its state
+//without the last round key and passes that key to the next AESE/AESD.
+//The key is only xored in explicitly when the state has to be stored,
+//so the critical path of each round is a single AESE+AESMC (or AESD+AESIMC)
+//pair that most cores fuse into one operation.
+
+#define AES_ENC(x, k) vaesmcq_u8(vaeseq_u8(x, k))
+#define AES_DEC(x, k) vaesimcq_u8(vaesdq_u8(x, k))
+
+static inline uint8x16_t setKey(uint32_t i3, uint32_t i2, uint32_t i1, uint32_t i0) {
+	const uint32_t data[4] = { i0, i1, i2, i3 };
+	return vreinterpretq_u8_u32(vld1q_u32(data));
+}
+
+static inline uint8x16_t load(const void* ptr, int i) {
+	return vld1q_u8((const uint8_t*)ptr + 16 * i);
+}
+
+static inline void store(void* ptr, int i, uint8x16_t x) {
+	vst1q_u8((uint8_t*)ptr + 16 * i, x);
+}
+
+void hashAes1Rx4Armv8(const void *input, size_t inputSize, void *hash) {
+	assert(inputSize % 64 == 0);
+	const uint8_t* inptr = (const uint8_t*)input;
+	const uint8_t* inputEnd = inptr + inputSize;
+
+	uint8x16_t state0 = setKey(AES_HASH_1R_STATE0);
+	uint8x16_t state1 = setKey(AES_HASH_1R_STATE1);
+	uint8x16_t state2 = setKey(AES_HASH_1R_STATE2);
+	uint8x16_t state3 = setKey(AES_HASH_1R_STATE3);
+	uint8x16_t key0 = vdupq_n_u8(0), key1 = key0, key2 = key0, key3 = key0;
+
+	while (inptr < inputEnd) {
+		state0 = AES_ENC(state0, key0);
+		state1 = AES_DEC(state1, key1);
+		state2 = AES_ENC(state2, key2);
+		state3 = AES_DEC(state3, key3);
+
+		key0 = load(inptr, 0);
+		key1 = load(inptr, 1);
+		key2 = load(inptr, 2);
+		key3 = load(inptr, 3);
+
+		inptr += 64;
+	}
+
+	const uint8x16_t xkey0 = setKey(AES_HASH_1R_XKEY0);
+	const uint8x16_t xkey1 = setKey(AES_HASH_1R_XKEY1);
+
+	state0 = AES_ENC(AES_ENC(state0, key0), xkey0);
+	state1 = AES_DEC(AES_DEC(state1, key1), xkey0);
+	state2 = AES_ENC(AES_ENC(state2, key2), xkey0);
+	state3 = AES_DEC(AES_DEC(state3, key3), xkey0);
+
+	store(hash, 0, veorq_u8(state0, xkey1));
+	store(hash, 1, veorq_u8(state1, xkey1));
+	store(hash, 2, veorq_u8(state2, xkey1));
+	store(hash, 3, veorq_u8(state3, xkey1));
+}
+
+void fillAes1Rx4Armv8(void *state, size_t outputSize, void *buffer) {
+	assert(outputSize % 64 == 0);
+	uint8_t* outptr = (uint8_t*)buffer;
+	const uint8_t* outputEnd = outptr + outputSize;
+
+	const uint8x16_t key0 = setKey(AES_GEN_1R_KEY0);
+	const uint8x16_t key1 = setKey(AES_GEN_1R_KEY1);
+	const uint8x16_t key2 = setKey(AES_GEN_1R_KEY2);
+	const uint8x16_t key3 = setKey(AES_GEN_1R_KEY3);
+
+	//pre-xor the key so the first AESE/AESD sees the plain state
+	uint8x16_t state0 = veorq_u8(load(state, 0), key0);
+	uint8x16_t state1 = veorq_u8(load(state, 1), key1);
+	uint8x16_t state2 = veorq_u8(load(state, 2), key2);
+	uint8x16_t state3 = veorq_u8(load(state, 3), key3);
+
+	while (outptr < outputEnd) {
+		state0 = AES_DEC(state0, key0);
+		state1 = AES_ENC(state1, key1);
+		state2 = AES_DEC(state2, key2);
+		state3 = AES_ENC(state3, key3);
+
+		store(outptr, 0, veorq_u8(state0, key0));
+		store(outptr, 1, veorq_u8(state1, key1));
+		store(outptr, 2, veorq_u8(state2, key2));
+		store(outptr, 3, veorq_u8(state3, key3));
+
+		outptr += 64;
+	}
+
+	store(state, 0, veorq_u8(state0, key0));
+	store(state, 1, veorq_u8(state1, key1));
+	store(state, 2, veorq_u8(state2, key2));
+	store(state, 3, veorq_u8(state3, key3));
+}
+
+void fillAes4Rx4Armv8(void *state, size_t outputSize, void *buffer) {
+	assert(outputSize % 64 == 0);
+	uint8_t* outptr = (uint8_t*)buffer;
+	const uint8_t* outputEnd = outptr + outputSize;
+
+	const uint8x16_t key0 = setKey(AES_GEN_4R_KEY0);
+	const uint8x16_t key1 = setKey(AES_GEN_4R_KEY1);
+	const uint8x16_t key2 = setKey(AES_GEN_4R_KEY2);
+	const uint8x16_t key3 = setKey(AES_GEN_4R_KEY3);
+	const uint8x16_t key4 = setKey(AES_GEN_4R_KEY4);
+	const uint8x16_t key5 = setKey(AES_GEN_4R_KEY5);
+	const uint8x16_t key6 = setKey(AES_GEN_4R_KEY6);
+	const uint8x16_t key7 = setKey(AES_GEN_4R_KEY7);
+
+	//the last key of each round group is carried into the next iteration
+	uint8x16_t state0 = veorq_u8(load(state, 0), key3);
+	uint8x16_t state1 = veorq_u8(load(state, 1), key3);
+	uint8x16_t state2 = veorq_u8(load(state, 2), key7);
+	uint8x16_t state3 = veorq_u8(load(state, 3), key7);
+
+	while (outptr < outputEnd) {
+		state0 = AES_DEC(state0, key3);
+		state1 = AES_ENC(state1, key3);
+		state2 = AES_DEC(state2, key7);
+		state3 = AES_ENC(state3, key7);
+
+		state0 = AES_DEC(state0, key0);
+		state1 = AES_ENC(state1, key0);
+		state2 = AES_DEC(state2, key4);
+		state3 = AES_ENC(state3, key4);
+
+		state0 = AES_DEC(state0, key1);
+		state1 = AES_ENC(state1, key1);
+		state2 = AES_DEC(state2, key5);
+		state3 = AES_ENC(state3, key5);
+
+		state0 = AES_DEC(state0, key2);
+		state1 = AES_ENC(state1, key2);
+		state2 = AES_DEC(state2, key6);
+		state3 = AES_ENC(state3, key6);
+
+		store(outptr, 0, veorq_u8(state0, key3));
+		store(outptr, 1, veorq_u8(state1, key3));
+		store(outptr, 2, veorq_u8(state2, key7));
+		store(outptr, 3, veorq_u8(state3, key7));
+
+		outptr += 64;
+	}
+}
+
+void hashAndFillAes1Rx4Armv8(void *scratchpad, size_t scratchpadSize, void *hash, void* fill_state) {
+	uint8_t* scratchpadPtr = (uint8_t*)scratchpad;
+	const uint8_t* scratchpadEnd = scratchpadPtr + scratchpadSize;
+
+	uint8x16_t hash_state0 = setKey(AES_HASH_1R_STATE0);
+	uint8x16_t hash_state1 = setKey(AES_HASH_1R_STATE1);
+	uint8x16_t hash_state2 = setKey(AES_HASH_1R_STATE2);
+	uint8x16_t hash_state3 = setKey(AES_HASH_1R_STATE3);
+	uint8x16_t hash_key0 = vdupq_n_u8(0), hash_key1 = hash_key0, hash_key2 = hash_key0, hash_key3 = hash_key0;
+
+	const uint8x16_t key0 = setKey(AES_GEN_1R_KEY0);
+	const uint8x16_t key1 = setKey(AES_GEN_1R_KEY1);
+	const uint8x16_t key2 = setKey(AES_GEN_1R_KEY2);
+	const uint8x16_t key3 = setKey(AES_GEN_1R_KEY3);
+
+	uint8x16_t fill_state0 = veorq_u8(load(fill_state, 0), key0);
+	uint8x16_t fill_state1 = veorq_u8(load(fill_state, 1), key1);
+	uint8x16_t fill_state2 = veorq_u8(load(fill_state, 2), key2);
+	uint8x16_t fill_state3 = veorq_u8(load(fill_state, 3), key3);
+
+	constexpr int PREFETCH_DISTANCE = 4096;
+	const char* prefetchPtr = ((const char*)scratchpad) + PREFETCH_DISTANCE;
+	scratchpadEnd -= PREFETCH_DISTANCE;
+
+	for (int i = 0; i < 2; ++i) {
+		while (scratchpadPtr < scratchpadEnd) {
+			hash_state0 = AES_ENC(hash_state0, hash_key0);
+			hash_state1 = AES_DEC(hash_state1, hash_key1);
+			hash_state2 = AES_ENC(hash_state2, hash_key2);
+			hash_state3 = AES_DEC(hash_state3, hash_key3);
+
+			hash_key0 = load(scratchpadPtr, 0);
+			hash_key1 = load(scratchpadPtr, 1);
+			hash_key2 = load(scratchpadPtr, 2);
+			hash_key3 = load(scratchpadPtr, 3);
+
+			fill_state0 = AES_DEC(fill_state0, key0);
+			fill_state1 = AES_ENC(fill_state1, key1);
+			fill_state2 = AES_DEC(fill_state2, key2);
+			fill_state3 = AES_ENC(fill_state3, key3);
+
+			store(scratchpadPtr, 0, veorq_u8(fill_state0, key0));
+			store(scratchpadPtr, 1, veorq_u8(fill_state1, key1));
+			store(scratchpadPtr, 2, veorq_u8(fill_state2, key2));
+			store(scratchpadPtr, 3, veorq_u8(fill_state3, key3));
+
+			__builtin_prefetch(prefetchPtr, 0, 3);
+
+			scratchpadPtr += 64;
+			prefetchPtr += 64;
+		}
+		prefetchPtr = (const char*) scratchpad;
+		scratchpadEnd += PREFETCH_DISTANCE;
+	}
+
+	store(fill_state, 0, veorq_u8(fill_state0, key0));
+	store(fill_state, 1, veorq_u8(fill_state1, key1));
+	store(fill_state, 2, veorq_u8(fill_state2, key2));
+	store(fill_state, 3, veorq_u8(fill_state3, key3));
+
+	const uint8x16_t xkey0 = setKey(AES_HASH_1R_XKEY0);
+	const uint8x16_t xkey1 = setKey(AES_HASH_1R_XKEY1);
+
+	hash_state0 = AES_ENC(AES_ENC(hash_state0, hash_key0), xkey0);
+	hash_state1 = AES_DEC(AES_DEC(hash_state1, hash_key1), xkey0);
+	hash_state2 = AES_ENC(AES_ENC(hash_state2, hash_key2), xkey0);
+	hash_state3 = AES_DEC(AES_DEC(hash_state3, hash_key3), xkey0);
+
+	store(hash, 0, veorq_u8(hash_state0, xkey1));
+	store(hash, 1, veorq_u8(hash_state1, xkey1));
+	store(hash, 2, veorq_u8(hash_state2, xkey1));
+	store(hash, 3, veorq_u8(hash_state3, xkey1));
+}
+
+#endif
@@ -0,0 +1,142 @@
+/*
+Copyright (c) 2026, The Salvium Project
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in the
+	  documentation and/or other materials provided with the distribution.
+	* Neither the name of the copyright holder nor the
+	  names of its contributors may be used to endorse or promote products
+	  derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include <cassert>
+#include <cstdint>
+#include <stdexcept>
+#include "aes_hash.hpp"
+
+#if (defined(__VAES__) || defined(_MSC_VER)) && defined(__AVX2__)
+
+#include <immintrin.h>
+#include "intrin_portable.h"
+
+//The columns are paired as (0, 2) and (1, 3) in memory order (low, high),
+//so columns 0 and 2 of each 64-byte block use one instruction and
+//columns 1 and 3 use the other.
+
+static FORCE_INLINE __m256i setPair(rx_vec_i128 lo, rx_vec_i128 hi) {
+	return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+}
+
+//128-bit halves are loaded with vinserti128 and stored with vextracti128,
+//which avoid the shuffle port unlike a full width load + vperm2i128
+static FORCE_INLINE void loadPairs(const void* ptr, __m256i& even, __m256i& odd) {
+	const rx_vec_i128* p = (const rx_vec_i128*)ptr;
+	even = setPair(_mm_loadu_si128(p + 0), _mm_loadu_si128(p + 2));
+	odd = setPair(_mm_loadu_si128(p + 1), _mm_loadu_si128(p + 3));
+}
+
+static FORCE_INLINE void storePairs(void* ptr, __m256i even, __m256i odd) {
+	rx_vec_i128* p = (rx_vec_i128*)ptr;
+	_mm_storeu_si128(p + 0, _mm256_castsi256_si128(even));
+	_mm_storeu_si128(p + 1, _mm256_castsi256_si128(odd));
+	_mm_storeu_si128(p + 2, _mm256_extracti128_si256(even, 1));
+	_mm_storeu_si128(p + 3, _mm256_extracti128_si256(odd, 1));
+}
+
+bool vaesAesHashCompiled() {
+	return true;
+}
+
+void hashAes1Rx4Vaes(const void *input, size_t inputSize, void *hash) {
+	assert(inputSize % 64 == 0);
+	const uint8_t* inptr = (uint8_t*)input;
+	const uint8_t* inputEnd = inptr + inputSize;
+
+	__m256i state02 = setPair(rx_set_int_vec_i128(AES_HASH_1R_STATE0), rx_set_int_vec_i128(AES_HASH_1R_STATE2));
+	__m256i state13 = setPair(rx_set_int_vec_i128(AES_HASH_1R_STATE1), rx_set_int_vec_i128(AES_HASH_1R_STATE3));
+	__m256i in02, in13;
+
+	while (inptr < inputEnd) {
+		loadPairs(inptr, in02, in13);
+		state02 = _mm256_aesenc_epi128(state02, in02);
+		state13 = _mm256_aesdec_epi128(state13, in13);
+		inptr += 64;
+	}
+
+	__m256i xkey0 = _mm256_broadcastsi128_si256(rx_set_int_vec_i128(AES_HASH_1R_XKEY0));
+	__m256i xkey1 = _mm256_broadcastsi128_si256(rx_set_int_vec_i128(AES_HASH_1R_XKEY1));
+
+	state02 = _mm256_aesenc_epi128(state02, xkey0);
+	state13 = _mm256_aesdec_epi128(state13, xkey0);
+
+	state02 = _mm256_aesenc_epi128(state02, xkey1);
+	state13 = _mm256_aesdec_epi128(state13, xkey1);
+
+	storePairs(hash, state02, state13);
+}
+
+void fillAes4Rx4Vaes(void *state, size_t outputSize, void *buffer) {
+	assert(outputSize % 64 == 0);
+	uint8_t* outptr = (uint8_t*)buffer;
+	const uint8_t* outputEnd = outptr + outputSize;
+
+	//columns 0 and 1 use keys 0-3, columns 2 and 3 use keys 4-7
+	const __m256i key04 = setPair(rx_set_int_vec_i128(AES_GEN_4R_KEY0), rx_set_int_vec_i128(AES_GEN_4R_KEY4));
+	const __m256i key15 = setPair(rx_set_int_vec_i128(AES_GEN_4R_KEY1), rx_set_int_vec_i128(AES_GEN_4R_KEY5));
+	const __m256i key26 = setPair(rx_set_int_vec_i128(AES_GEN_4R_KEY2), rx_set_int_vec_i128(AES_GEN_4R_KEY6));
+	const __m256i key37 = setPair(rx_set_int_vec_i128(AES_GEN_4R_KEY3), rx_set_int_vec_i128(AES_GEN_4R_KEY7));
+	__m256i state02, state13;
+
+	loadPairs(state, state02, state13);
+
+	while (outptr < outputEnd) {
+		state02 = _mm256_aesdec_epi128(state02, key04);
+		state13 = _mm256_aesenc_epi128(state13, key04);
+
+		state02 = _mm256_aesdec_epi128(state02, key15);
+		state13 = _mm256_aesenc_epi128(state13, key15);
+
+		state02 = _mm256_aesdec_epi128(state02, key26);
+		state13 = _mm256_aesenc_epi128(state13, key26);
+
+		state02 = _mm256_aesdec_epi128(state02, key37);
+		state13 = _mm256_aesenc_epi128(state13, key37);
+
+		storePairs(outptr, state02, state13);
+		outptr += 64;
+	}
+}
+
+#else
+
+bool vaesAesHashCompiled() {
+	return false;
+}
+
+void hashAes1Rx4Vaes(const void*, size_t, void*) {
+	throw std::runtime_error("VAES is not supported by this build");
+}
+
+void fillAes4Rx4Vaes(void*, size_t, void*) {
+	throw std::runtime_error("VAES is not supported by this build");
+}
+
+#endif
@@ -27,6 +27,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include <new>
+#include <mutex>
+#include <unordered_map>
 #include "allocator.hpp"
 #include "intrin_portable.h"
 #include "virtual_memory.h"
@@ -49,15 +51,87 @@ namespace randomx {
 
 	template struct AlignedAllocator<CacheLineSize>;
 
+	struct PagedAllocation {
+		size_t size;
+		randomx_page_type type;
+	};
+
+	//Huge page mappings are larger than requested and must be unmapped with their real size.
+	static std::mutex pagedAllocationsMutex;
+	static std::unordered_map<const void*, PagedAllocation> pagedAllocations;
+
+	static void registerPages(void* ptr, size_t size, randomx_page_type type) {
+		try {
+			std::lock_guard<std::mutex> lock(pagedAllocationsMutex);
+			pagedAllocations[ptr] = PagedAllocation{ size, type };
+		}
+		catch (...) {
+			freePagedMemory(ptr, size);
+			throw;
+		}
+	}
+
+	static void freePages(void* ptr, size_t count) {
+		{
+			std::lock_guard<std::mutex> lock(pagedAllocationsMutex);
+			auto it = pagedAllocations.find(ptr);
+			if (it != pagedAllocations.end()) {
+				count = it->second.size;
+				pagedAllocations.erase(it);
+			}
+		}
+		freePagedMemory(ptr, count);
+	}
+
+	randomx_page_type getPageType(const void* ptr) {
+		std::lock_guard<std::mutex> lock(pagedAllocationsMutex);
+		auto it = pagedAllocations.find(ptr);
+		if (it == pagedAllocations.end())
+			return RANDOMX_PAGES_SMALL;
+		return it->second.type;
+	}
+
 	void* LargePageAllocator::allocMemory(size_t count) {
-		void *mem = allocLargePagesMemory(count);
+		void *mem = nullptr;
+		size_t size;
+		randomx_page_type type;
+		if (count >= HugePageSize1GB) {
+			size = alignSize(count, HugePageSize1GB);
+			type = RANDOMX_PAGES_1GB;
+			mem = allocHugePagesMemory(size, HugePageSize1GB);
+		}
+		if (mem == nullptr) {
+			size = alignSize(count, HugePageSize2MB);
+			type = RANDOMX_PAGES_2MB;
+			mem = allocHugePagesMemory(size, HugePageSize2MB);
+		}
+		if (mem == nullptr) {
+			int advised;
+			size = alignSize(count, HugePageSize2MB);
+			mem = allocTransparentHugePagesMemory(size, &advised);
+			type = advised ? RANDOMX_PAGES_TRANSPARENT : RANDOMX_PAGES_SMALL;
+		}
 		if (mem == nullptr)
 			throw std::bad_alloc();
+		registerPages(mem, size, type);
 		return mem;
 	}
 
 	void LargePageAllocator::freeMemory(void* ptr, size_t count) {
-		freePagedMemory(ptr, count);
+		freePages(ptr, count);
 	};
 
+	void* NumaAllocator::allocMemory(size_t count, unsigned node, bool largePages) {
+		void *mem = allocNumaMemory(count, node, largePages ? 1 : 0);
+		if (mem == nullptr)
+			throw std::bad_alloc();
+		if (largePages)
+			registerPages(mem, alignSize(count, HugePageSize2MB), RANDOMX_PAGES_2MB);
+		return mem;
+	}
+
+	void NumaAllocator::freeMemory(void* ptr, size_t count) {
+		freePages(ptr, count);
+	}
+
 }
@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <cstddef>
+#include "randomx.h"
 
 namespace randomx {
 
@@ -43,4 +44,12 @@ namespace randomx {
 		static void freeMemory(void*, size_t);
 	};
 
+	struct NumaAllocator {
+		static void* allocMemory(size_t, unsigned node, bool largePages);
+		static void freeMemory(void*, size_t);
+	};
+
+	//Page type of memory returned by the allocators above (RANDOMX_PAGES_SMALL if unknown).
+	randomx_page_type getPageType(const void* ptr);
+
 }
\ No newline at end of file
@@ -56,8 +56,16 @@ randomx_argon2_impl* randomx_argon2_impl_avx2() {
 #include "blake2/blake2-impl.h"
 #include "blake2/blake2.h"
 
+/*
+ * The reference block of the following block is known as soon as the first
+ * word of next_block is final, which is after the first column round.  When
+ * lookahead is not NULL, that block is prefetched there so that its cache
+ * misses overlap the rest of the compression.  lookahead->index must already
+ * be the index of the following block.
+ */
 static void fill_block(__m256i* state, const block* ref_block,
-	block* next_block, int with_xor) {
+	block* next_block, int with_xor, const argon2_instance_t* instance,
+	const argon2_position_t* lookahead) {
 	__m256i block_XY[ARGON2_HWORDS_IN_BLOCK];
 	unsigned int i;
 
@@ -81,7 +89,22 @@ static void fill_block(__m256i* state, const block* ref_block,
 			state[8 * i + 2], state[8 * i + 6], state[8 * i + 3], state[8 * i + 7]);
 	}
 
-	for (i = 0; i < 4; ++i) {
+	BLAKE2_ROUND_2(state[0], state[4], state[8], state[12],
+		state[16], state[20], state[24], state[28]);
+
+	if (lookahead != NULL) {
+		uint64_t pseudo_rand;
+		const char* next_ref;
+		_mm_storel_epi64((__m128i*)&pseudo_rand, _mm256_castsi256_si128(
+			_mm256_xor_si256(state[0], block_XY[0])));
+		next_ref = (const char*)randomx_argon2_ref_block(instance, *lookahead,
+			pseudo_rand);
+		for (i = 0; i < ARGON2_BLOCK_SIZE; i += 64) {
+			_mm_prefetch(next_ref + i, _MM_HINT_T0);
+		}
+	}
+
+	for (i = 1; i < 4; ++i) {
 		BLAKE2_ROUND_2(state[0 + i], state[4 + i], state[8 + i], state[12 + i],
 			state[16 + i], state[20 + i], state[24 + i], state[28 + i]);
 	}
@@ -96,7 +119,6 @@ void randomx_argon2_fill_segment_avx2(const argon2_instance_t* instance,
 	argon2_position_t position) {
 	block* ref_block = NULL, * curr_block = NULL;
 	block address_block, input_block;
-	uint64_t pseudo_rand, ref_index, ref_lane;
 	uint32_t prev_offset, curr_offset;
 	uint32_t starting_index, i;
 	__m256i state[ARGON2_HWORDS_IN_BLOCK];
@@ -126,48 +148,39 @@ void randomx_argon2_fill_segment_avx2(const argon2_instance_t* instance,
 
 	memcpy(state, ((instance->memory + prev_offset)->v), ARGON2_BLOCK_SIZE);
 
-	for (i = starting_index; i < instance->segment_length;
-		++i, ++curr_offset, ++prev_offset) {
-		/*1.1 Rotating prev_offset if needed */
-		if (curr_offset % instance->lane_length == 1) {
-			prev_offset = curr_offset - 1;
-		}
-
-		/* 1.2 Computing the index of the reference block */
-		/* 1.2.1 Taking pseudo-random value from the previous block */
-		pseudo_rand = instance->memory[prev_offset].v[0];
+	/* 1.2 Computing the index of the reference block from the previous block */
+	position.index = starting_index;
+	ref_block = randomx_argon2_ref_block(instance, position,
+		instance->memory[prev_offset].v[0]);
 
-		/* 1.2.2 Computing the lane of the reference block */
-		ref_lane = ((pseudo_rand >> 32)) % instance->lanes;
-
-		if ((position.pass == 0) && (position.slice == 0)) {
-			/* Can not reference other lanes yet */
-			ref_lane = position.lane;
-		}
-
-		/* 1.2.3 Computing the number of possible reference block within the
-		 * lane.
-		 */
-		position.index = i;
-		ref_index = randomx_argon2_index_alpha(instance, &position, pseudo_rand & 0xFFFFFFFF,
-			ref_lane == position.lane);
+	for (i = starting_index; i < instance->segment_length;
+		++i, ++curr_offset) {
+		const argon2_position_t* lookahead = NULL;
 
 		/* 2 Creating a new block */
-		ref_block =
-			instance->memory + instance->lane_length * ref_lane + ref_index;
 		curr_block = instance->memory + curr_offset;
+		if (i + 1 < instance->segment_length) {
+			position.index = i + 1;
+			lookahead = &position;
+		}
 		if (ARGON2_VERSION_10 == instance->version) {
 			/* version 1.2.1 and earlier: overwrite, not XOR */
-			fill_block(state, ref_block, curr_block, 0);
+			fill_block(state, ref_block, curr_block, 0, instance, lookahead);
 		}
 		else {
 			if (0 == position.pass) {
-				fill_block(state, ref_block, curr_block, 0);
+				fill_block(state, ref_block, curr_block, 0, instance, lookahead);
 			}
 			else {
-				fill_block(state, ref_block, curr_block, 1);
+				fill_block(state, ref_block, curr_block, 1, instance, lookahead);
 			}
 		}
+
+		/* 1.2 Same reference block as the one fill_block prefetched */
+		if (lookahead != NULL) {
+			ref_block = randomx_argon2_ref_block(instance, position,
+				curr_block->v[0]);
+		}
 	}
 }
 
@@ -159,6 +159,27 @@ uint32_t randomx_argon2_index_alpha(const argon2_instance_t *instance,
 	return absolute_position;
 }
 
+block *randomx_argon2_ref_block(const argon2_instance_t *instance,
+	argon2_position_t position, uint64_t pseudo_rand) {
+	uint64_t ref_lane, ref_index;
+
+	/* 1.2.2 Computing the lane of the reference block */
+	ref_lane = ((pseudo_rand >> 32)) % instance->lanes;
+
+	if ((position.pass == 0) && (position.slice == 0)) {
+		/* Can not reference other lanes yet */
+		ref_lane = position.lane;
+	}
+
+	/* 1.2.3 Computing the number of possible reference block within the
+	 * lane.
+	 */
+	ref_index = randomx_argon2_index_alpha(instance, &position, pseudo_rand & 0xFFFFFFFF,
+		ref_lane == position.lane);
+
+	return instance->memory + instance->lane_length * ref_lane + ref_index;
+}
+
 /* Single-threaded version for p=1 case */
 static int fill_memory_blocks_st(argon2_instance_t *instance) {
 	uint32_t r, s, l;
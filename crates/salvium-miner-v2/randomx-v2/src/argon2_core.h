@@ -127,6 +127,16 @@ uint32_t randomx_argon2_index_alpha(const argon2_instance_t *instance,
 	const argon2_position_t *position, uint32_t pseudo_rand,
 	int same_lane);
 
+/*
+ * Finds the reference block of the block at @position
+ * @param instance Pointer to the current instance
+ * @param position Position of the block being constructed
+ * @param pseudo_rand First word of the block before it
+ * @pre All pointers must be valid
+ */
+block *randomx_argon2_ref_block(const argon2_instance_t *instance,
+	argon2_position_t position, uint64_t pseudo_rand);
+
 /*
  * Function that validates all inputs against predefined restrictions and return
  * an error code
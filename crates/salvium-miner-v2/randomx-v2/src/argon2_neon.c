@@ -0,0 +1,193 @@
+/*
+Copyright (c) 2026, The Salvium Project
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in the
+	  documentation and/or other materials provided with the distribution.
+	* Neither the name of the copyright holder nor the
+	  names of its contributors may be used to endorse or promote products
+	  derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* Original code from Argon2 reference source code package used under CC0 Licence
+ * https://github.com/P-H-C/phc-winner-argon2
+ * Copyright 2015
+ * Daniel Dinu, Dmitry Khovratovich, Jean-Philippe Aumasson, and Samuel Neves
+*/
+
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "argon2.h"
+
+void randomx_argon2_fill_segment_neon(const argon2_instance_t* instance,
+	argon2_position_t position);
+
+randomx_argon2_impl* randomx_argon2_impl_neon() {
+#if defined(__aarch64__) || defined(_M_ARM64)
+	return &randomx_argon2_fill_segment_neon;
+#endif
+	return NULL;
+}
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+
+#include <arm_neon.h>
+
+#include "argon2_core.h"
+
+#include "blake2/blamka-round-neon.h"
+#include "blake2/blake2-impl.h"
+#include "blake2/blake2.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define prefetch_block_line(p) __prefetch(p)
+#else
+#define prefetch_block_line(p) __builtin_prefetch(p)
+#endif
+
+/*
+ * The reference block of the following block is known as soon as the first
+ * word of next_block is final, which is after the eight row rounds and the
+ * first column round.  When lookahead is not NULL, that block is prefetched
+ * there so that its cache misses overlap the rest of the compression.
+ * lookahead->index must already be the index of the following block.
+ */
+static void fill_block(uint64x2_t* state, const block* ref_block,
+	block* next_block, int with_xor, const argon2_instance_t* instance,
+	const argon2_position_t* lookahead) {
+	uint64x2_t block_XY[ARGON2_OWORDS_IN_BLOCK];
+	unsigned int i;
+
+	if (with_xor) {
+		for (i = 0; i < ARGON2_OWORDS_IN_BLOCK; i++) {
+			state[i] = veorq_u64(state[i], vld1q_u64(ref_block->v + 2 * i));
+			block_XY[i] = veorq_u64(state[i], vld1q_u64(next_block->v + 2 * i));
+		}
+	}
+	else {
+		for (i = 0; i < ARGON2_OWORDS_IN_BLOCK; i++) {
+			block_XY[i] = state[i] = veorq_u64(state[i], vld1q_u64(ref_block->v + 2 * i));
+		}
+	}
+
+	for (i = 0; i < 8; ++i) {
+		BLAKE2_ROUND(state[8 * i + 0], state[8 * i + 1], state[8 * i + 2],
+			state[8 * i + 3], state[8 * i + 4], state[8 * i + 5],
+			state[8 * i + 6], state[8 * i + 7]);
+	}
+
+	BLAKE2_ROUND(state[8 * 0], state[8 * 1], state[8 * 2],
+		state[8 * 3], state[8 * 4], state[8 * 5],
+		state[8 * 6], state[8 * 7]);
+
+	if (lookahead != NULL) {
+		uint64_t pseudo_rand = vgetq_lane_u64(veorq_u64(state[0], block_XY[0]), 0);
+		const char* next_ref = (const char*)randomx_argon2_ref_block(instance,
+			*lookahead, pseudo_rand);
+		for (i = 0; i < ARGON2_BLOCK_SIZE; i += 64) {
+			prefetch_block_line(next_ref + i);
+		}
+	}
+
+	for (i = 1; i < 8; ++i) {
+		BLAKE2_ROUND(state[8 * 0 + i], state[8 * 1 + i], state[8 * 2 + i],
+			state[8 * 3 + i], state[8 * 4 + i], state[8 * 5 + i],
+			state[8 * 6 + i], state[8 * 7 + i]);
+	}
+
+	for (i = 0; i < ARGON2_OWORDS_IN_BLOCK; i++) {
+		state[i] = veorq_u64(state[i], block_XY[i]);
+		vst1q_u64(next_block->v + 2 * i, state[i]);
+	}
+}
+
+void randomx_argon2_fill_segment_neon(const argon2_instance_t* instance,
+	argon2_position_t position) {
+	block* ref_block = NULL, * curr_block = NULL;
+	block address_block, input_block;
+	uint32_t prev_offset, curr_offset;
+	uint32_t starting_index, i;
+	uint64x2_t state[ARGON2_OWORDS_IN_BLOCK];
+
+	if (instance == NULL) {
+		return;
+	}
+
+	starting_index = 0;
+
+	if ((0 == position.pass) && (0 == position.slice)) {
+		starting_index = 2; /* we have already generated the first two blocks */
+	}
+
+	/* Offset of the current block */
+	curr_offset = position.lane * instance->lane_length +
+		position.slice * instance->segment_length + starting_index;
+
+	if (0 == curr_offset % instance->lane_length) {
+		/* Last block in this lane */
+		prev_offset = curr_offset + instance->lane_length - 1;
+	}
+	else {
+		/* Previous block */
+		prev_offset = curr_offset - 1;
+	}
+
+	memcpy(state, ((instance->memory + prev_offset)->v), ARGON2_BLOCK_SIZE);
+
+	/* 1.2 Computing the index of the reference block from the previous block */
+	position.index = starting_index;
+	ref_block = randomx_argon2_ref_block(instance, position,
+		instance->memory[prev_offset].v[0]);
+
+	for (i = starting_index; i < instance->segment_length;
+		++i, ++curr_offset) {
+		const argon2_position_t* lookahead = NULL;
+
+		/* 2 Creating a new block */
+		curr_block = instance->memory + curr_offset;
+		if (i + 1 < instance->segment_length) {
+			position.index = i + 1;
+			lookahead = &position;
+		}
+		if (ARGON2_VERSION_10 == instance->version) {
+			/* version 1.2.1 and earlier: overwrite, not XOR */
+			fill_block(state, ref_block, curr_block, 0, instance, lookahead);
+		}
+		else {
+			if (0 == position.pass) {
+				fill_block(state, ref_block, curr_block, 0, instance, lookahead);
+			}
+			else {
+				fill_block(state, ref_block, curr_block, 1, instance, lookahead);
+			}
+		}
+
+		/* 1.2 Same reference block as the one fill_block prefetched */
+		if (lookahead != NULL) {
+			ref_block = randomx_argon2_ref_block(instance, position,
+				curr_block->v[0]);
+		}
+	}
+}
+
+#endif
@@ -84,7 +84,18 @@ extern "C" {
 		1 / !!(sizeof(blake2b_param) == sizeof(uint64_t) * CHAR_BIT)
 	};
 
+	/* Blake2b compression function implementations */
+	typedef enum {
+		BLAKE2B_IMPL_AUTO = 0,
+		BLAKE2B_IMPL_REF = 1,
+		BLAKE2B_IMPL_SSE41 = 2,
+		BLAKE2B_IMPL_AVX2 = 3,
+		BLAKE2B_IMPL_NEON = 4
+	} blake2b_impl;
+
 	//randomx namespace
+#define blake2b_set_impl    randomx_blake2b_set_impl
+#define blake2b_get_impl    randomx_blake2b_get_impl
 #define blake2b_init        randomx_blake2b_init
 #define blake2b_init_key    randomx_blake2b_init_key
 #define blake2b_init_param  randomx_blake2b_init_param
@@ -93,6 +104,13 @@ extern "C" {
 #define blake2b             randomx_blake2b
 #define blake2b_long        randomx_blake2b_long
 
+	/* Selects the compression function used by all of the functions below.
+	 * BLAKE2B_IMPL_AUTO picks the fastest one supported by the CPU, which is
+	 * also what happens on first use. Returns -1 if the implementation was not
+	 * compiled in or is not supported by the CPU. */
+	int blake2b_set_impl(blake2b_impl impl);
+	blake2b_impl blake2b_get_impl(void);
+
 	/* Streaming API */
 	int blake2b_init(blake2b_state *S, size_t outlen);
 	int blake2b_init_key(blake2b_state *S, size_t outlen, const void *key,
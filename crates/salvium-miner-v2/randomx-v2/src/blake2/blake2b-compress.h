@@ -0,0 +1,68 @@
+/*
+Copyright (c) 2026, The Salvium Project
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in the
+	  documentation and/or other materials provided with the distribution.
+	* Neither the name of the copyright holder nor the
+	  names of its contributors may be used to endorse or promote products
+	  derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifndef BLAKE2B_COMPRESS_H
+#define BLAKE2B_COMPRESS_H
+
+#include <stdint.h>
+
+#include "blake2.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#define blake2b_IV                    randomx_blake2b_IV
+#define blake2b_sigma                 randomx_blake2b_sigma
+#define blake2b_compress_ref          randomx_blake2b_compress_ref
+#define blake2b_compress_selected     randomx_blake2b_compress_selected
+#define blake2b_compress_sse41_impl   randomx_blake2b_compress_sse41_impl
+#define blake2b_compress_avx2_impl    randomx_blake2b_compress_avx2_impl
+#define blake2b_compress_neon_impl    randomx_blake2b_compress_neon_impl
+
+	typedef void blake2b_compress_fn(blake2b_state *S, const uint8_t *block);
+
+	extern const uint64_t blake2b_IV[8];
+	extern const unsigned int blake2b_sigma[12][16];
+
+	void blake2b_compress_ref(blake2b_state *S, const uint8_t *block);
+
+	/* The implementation chosen by blake2b_set_impl, BLAKE2B_IMPL_AUTO on first use */
+	blake2b_compress_fn *blake2b_compress_selected(void);
+
+	/* Return NULL if the implementation was not compiled in */
+	blake2b_compress_fn *blake2b_compress_sse41_impl(void);
+	blake2b_compress_fn *blake2b_compress_avx2_impl(void);
+	blake2b_compress_fn *blake2b_compress_neon_impl(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
@@ -0,0 +1,112 @@
+/*
+Copyright (c) 2026, The Salvium Project
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in the
+	  documentation and/or other materials provided with the distribution.
+	* Neither the name of the copyright holder nor the
+	  names of its contributors may be used to endorse or promote products
+	  derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include <stdint.h>
+#include <string.h>
+
+#include "blake2b-compress.h"
+
+#if defined(__AVX2__)
+
+#include <immintrin.h>
+
+#include "blake2-impl.h"
+
+/* One row of the 4x4 state per register, diagonalized with vpermq */
+
+#define ROTR32(x) _mm256_shuffle_epi32((x), _MM_SHUFFLE(2, 3, 0, 1))
+#define ROTR24(x) _mm256_shuffle_epi8((x), r24)
+#define ROTR16(x) _mm256_shuffle_epi8((x), r16)
+#define ROTR63(x) _mm256_or_si256(_mm256_srli_epi64((x), 63), _mm256_add_epi64((x), (x)))
+
+#define G(a, b, c, d, m0, m1)                                                  \
+    do {                                                                       \
+        a = _mm256_add_epi64(_mm256_add_epi64(a, b), m0);                      \
+        d = ROTR32(_mm256_xor_si256(d, a));                                    \
+        c = _mm256_add_epi64(c, d);                                            \
+        b = ROTR24(_mm256_xor_si256(b, c));                                    \
+        a = _mm256_add_epi64(_mm256_add_epi64(a, b), m1);                      \
+        d = ROTR16(_mm256_xor_si256(d, a));                                    \
+        c = _mm256_add_epi64(c, d);                                            \
+        b = ROTR63(_mm256_xor_si256(b, c));                                    \
+    } while ((void)0, 0)
+
+#define MSG(s, i0, i1, i2, i3) \
+    _mm256_set_epi64x((long long)m[s[i3]], (long long)m[s[i2]], (long long)m[s[i1]], (long long)m[s[i0]])
+
+static void blake2b_compress_avx2(blake2b_state *S, const uint8_t *block) {
+	const __m256i r16 = _mm256_setr_epi8(
+		2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9,
+		2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9);
+	const __m256i r24 = _mm256_setr_epi8(
+		3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10,
+		3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10);
+	uint64_t m[16];
+	unsigned int i, r;
+	__m256i a, b, c, d, h0, h1;
+
+	for (i = 0; i < 16; ++i) {
+		m[i] = load64(block + i * sizeof(m[i]));
+	}
+
+	h0 = _mm256_loadu_si256((const __m256i *)&S->h[0]);
+	h1 = _mm256_loadu_si256((const __m256i *)&S->h[4]);
+	a = h0;
+	b = h1;
+	c = _mm256_loadu_si256((const __m256i *)&blake2b_IV[0]);
+	d = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)&blake2b_IV[4]),
+		_mm256_set_epi64x((long long)S->f[1], (long long)S->f[0], (long long)S->t[1], (long long)S->t[0]));
+
+	for (r = 0; r < 12; ++r) {
+		const unsigned int *s = blake2b_sigma[r];
+		G(a, b, c, d, MSG(s, 0, 2, 4, 6), MSG(s, 1, 3, 5, 7));
+		b = _mm256_permute4x64_epi64(b, _MM_SHUFFLE(0, 3, 2, 1));
+		c = _mm256_permute4x64_epi64(c, _MM_SHUFFLE(1, 0, 3, 2));
+		d = _mm256_permute4x64_epi64(d, _MM_SHUFFLE(2, 1, 0, 3));
+		G(a, b, c, d, MSG(s, 8, 10, 12, 14), MSG(s, 9, 11, 13, 15));
+		b = _mm256_permute4x64_epi64(b, _MM_SHUFFLE(2, 1, 0, 3));
+		c = _mm256_permute4x64_epi64(c, _MM_SHUFFLE(1, 0, 3, 2));
+		d = _mm256_permute4x64_epi64(d, _MM_SHUFFLE(0, 3, 2, 1));
+	}
+
+	_mm256_storeu_si256((__m256i *)&S->h[0], _mm256_xor_si256(h0, _mm256_xor_si256(a, c)));
+	_mm256_storeu_si256((__m256i *)&S->h[4], _mm256_xor_si256(h1, _mm256_xor_si256(b, d)));
+}
+
+blake2b_compress_fn *blake2b_compress_avx2_impl(void) {
+	return &blake2b_compress_avx2;
+}
+
+#else
+
+blake2b_compress_fn *blake2b_compress_avx2_impl(void) {
+	return NULL;
+}
+
+#endif
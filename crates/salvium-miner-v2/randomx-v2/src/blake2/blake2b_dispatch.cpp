@@ -0,0 +1,106 @@
+/*
+Copyright (c) 2026, The Salvium Project
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in the
+	  documentation and/or other materials provided with the distribution.
+	* Neither the name of the copyright holder nor the
+	  names of its contributors may be used to endorse or promote products
+	  derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stddef.h>
+#include <atomic>
+
+#include "blake2.h"
+#include "blake2b-compress.h"
+#include "../cpu.hpp"
+
+namespace {
+
+	//Relaxed is enough: every implementation computes the same hash, so a thread
+	//that still sees the previous one after blake2b_set_impl returns is harmless
+	std::atomic<blake2b_compress_fn*> compressImpl(nullptr);
+	std::atomic<blake2b_impl> selectedImpl(BLAKE2B_IMPL_REF);
+
+	blake2b_compress_fn* findImpl(blake2b_impl impl) {
+		static const randomx::Cpu cpu;
+		switch (impl) {
+		case BLAKE2B_IMPL_REF:
+			return &blake2b_compress_ref;
+		case BLAKE2B_IMPL_SSE41:
+			return cpu.hasSse41() ? blake2b_compress_sse41_impl() : nullptr;
+		case BLAKE2B_IMPL_AVX2:
+			return cpu.hasAvx2() ? blake2b_compress_avx2_impl() : nullptr;
+		case BLAKE2B_IMPL_NEON:
+			return blake2b_compress_neon_impl();
+		default:
+			return nullptr;
+		}
+	}
+
+	void selectAuto() {
+		static const blake2b_impl preference[] = {
+			BLAKE2B_IMPL_AVX2, BLAKE2B_IMPL_SSE41, BLAKE2B_IMPL_NEON, BLAKE2B_IMPL_REF
+		};
+		for (auto impl : preference) {
+			blake2b_compress_fn* fn = findImpl(impl);
+			if (fn != nullptr) {
+				selectedImpl.store(impl, std::memory_order_relaxed);
+				compressImpl.store(fn, std::memory_order_relaxed);
+				return;
+			}
+		}
+	}
+
+}
+
+extern "C" {
+
+	int blake2b_set_impl(blake2b_impl impl) {
+		if (impl == BLAKE2B_IMPL_AUTO) {
+			selectAuto();
+			return 0;
+		}
+		blake2b_compress_fn* fn = findImpl(impl);
+		if (fn == nullptr) {
+			return -1;
+		}
+		selectedImpl.store(impl, std::memory_order_relaxed);
+		compressImpl.store(fn, std::memory_order_relaxed);
+		return 0;
+	}
+
+	blake2b_impl blake2b_get_impl(void) {
+		blake2b_compress_selected();
+		return selectedImpl.load(std::memory_order_relaxed);
+	}
+
+	blake2b_compress_fn* blake2b_compress_selected(void) {
+		blake2b_compress_fn* fn = compressImpl.load(std::memory_order_relaxed);
+		if (fn == nullptr) {
+			//Concurrent first calls all store the same values
+			selectAuto();
+			fn = compressImpl.load(std::memory_order_relaxed);
+		}
+		return fn;
+	}
+
+}
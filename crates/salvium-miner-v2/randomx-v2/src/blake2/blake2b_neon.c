@@ -0,0 +1,149 @@
+/*
+Copyright (c) 2026, The Salvium Project
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in the
+	  documentation and/or other materials provided with the distribution.
+	* Neither the name of the copyright holder nor the
+	  names of its contributors may be used to endorse or promote products
+	  derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include <stdint.h>
+#include <string.h>
+
+#include "blake2b-compress.h"
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+
+#include <arm_neon.h>
+
+#include "blake2-impl.h"
+
+/* Same layout as the SSE4.1 version: each row is split into a low and a high register */
+
+#define ROTR32(x) vreinterpretq_u64_u32(vrev64q_u32(vreinterpretq_u32_u64(x)))
+#define ROTR(x, n) vsriq_n_u64(vshlq_n_u64((x), 64 - (n)), (x), (n))
+
+#define G1(a, b, c, d, m)                                                      \
+    do {                                                                       \
+        a = vaddq_u64(vaddq_u64(a, b), m);                                     \
+        d = ROTR32(veorq_u64(d, a));                                           \
+        c = vaddq_u64(c, d);                                                   \
+        b = ROTR(veorq_u64(b, c), 24);                                         \
+    } while ((void)0, 0)
+
+#define G2(a, b, c, d, m)                                                      \
+    do {                                                                       \
+        a = vaddq_u64(vaddq_u64(a, b), m);                                     \
+        d = ROTR(veorq_u64(d, a), 16);                                         \
+        c = vaddq_u64(c, d);                                                   \
+        b = ROTR(veorq_u64(b, c), 63);                                         \
+    } while ((void)0, 0)
+
+#define G(m0l, m0h, m1l, m1h)                                                  \
+    do {                                                                       \
+        G1(row1l, row2l, row3l, row4l, m0l);                                   \
+        G1(row1h, row2h, row3h, row4h, m0h);                                   \
+        G2(row1l, row2l, row3l, row4l, m1l);                                   \
+        G2(row1h, row2h, row3h, row4h, m1h);                                   \
+    } while ((void)0, 0)
+
+#define DIAGONALIZE()                                                          \
+    do {                                                                       \
+        uint64x2_t t0 = vextq_u64(row2l, row2h, 1);                            \
+        uint64x2_t t1 = vextq_u64(row2h, row2l, 1);                            \
+        row2l = t0;                                                            \
+        row2h = t1;                                                            \
+        t0 = row3l;                                                            \
+        row3l = row3h;                                                         \
+        row3h = t0;                                                            \
+        t0 = vextq_u64(row4l, row4h, 1);                                       \
+        t1 = vextq_u64(row4h, row4l, 1);                                       \
+        row4l = t1;                                                            \
+        row4h = t0;                                                            \
+    } while ((void)0, 0)
+
+#define UNDIAGONALIZE()                                                        \
+    do {                                                                       \
+        uint64x2_t t0 = vextq_u64(row2h, row2l, 1);                            \
+        uint64x2_t t1 = vextq_u64(row2l, row2h, 1);                            \
+        row2l = t0;                                                            \
+        row2h = t1;                                                            \
+        t0 = row3l;                                                            \
+        row3l = row3h;                                                         \
+        row3h = t0;                                                            \
+        t0 = vextq_u64(row4h, row4l, 1);                                       \
+        t1 = vextq_u64(row4l, row4h, 1);                                       \
+        row4l = t1;                                                            \
+        row4h = t0;                                                            \
+    } while ((void)0, 0)
+
+#define MSG(s, i0, i1) vcombine_u64(vcreate_u64(m[s[i0]]), vcreate_u64(m[s[i1]]))
+
+static void blake2b_compress_neon(blake2b_state *S, const uint8_t *block) {
+	uint64_t m[16];
+	unsigned int i, r;
+	uint64x2_t row1l, row1h, row2l, row2h, row3l, row3h, row4l, row4h;
+	uint64x2_t h0, h1, h2, h3;
+
+	for (i = 0; i < 16; ++i) {
+		m[i] = load64(block + i * sizeof(m[i]));
+	}
+
+	h0 = vld1q_u64(&S->h[0]);
+	h1 = vld1q_u64(&S->h[2]);
+	h2 = vld1q_u64(&S->h[4]);
+	h3 = vld1q_u64(&S->h[6]);
+	row1l = h0;
+	row1h = h1;
+	row2l = h2;
+	row2h = h3;
+	row3l = vld1q_u64(&blake2b_IV[0]);
+	row3h = vld1q_u64(&blake2b_IV[2]);
+	row4l = veorq_u64(vld1q_u64(&blake2b_IV[4]), vld1q_u64(&S->t[0]));
+	row4h = veorq_u64(vld1q_u64(&blake2b_IV[6]), vld1q_u64(&S->f[0]));
+
+	for (r = 0; r < 12; ++r) {
+		const unsigned int *s = blake2b_sigma[r];
+		G(MSG(s, 0, 2), MSG(s, 4, 6), MSG(s, 1, 3), MSG(s, 5, 7));
+		DIAGONALIZE();
+		G(MSG(s, 8, 10), MSG(s, 12, 14), MSG(s, 9, 11), MSG(s, 13, 15));
+		UNDIAGONALIZE();
+	}
+
+	vst1q_u64(&S->h[0], veorq_u64(h0, veorq_u64(row1l, row3l)));
+	vst1q_u64(&S->h[2], veorq_u64(h1, veorq_u64(row1h, row3h)));
+	vst1q_u64(&S->h[4], veorq_u64(h2, veorq_u64(row2l, row4l)));
+	vst1q_u64(&S->h[6], veorq_u64(h3, veorq_u64(row2h, row4h)));
+}
+
+blake2b_compress_fn *blake2b_compress_neon_impl(void) {
+	return &blake2b_compress_neon;
+}
+
+#else
+
+blake2b_compress_fn *blake2b_compress_neon_impl(void) {
+	return NULL;
+}
+
+#endif
@@ -0,0 +1,153 @@
+/*
+Copyright (c) 2026, The Salvium Project
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in the
+	  documentation and/or other materials provided with the distribution.
+	* Neither the name of the copyright holder nor the
+	  names of its contributors may be used to endorse or promote products
+	  derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include <stdint.h>
+#include <string.h>
+
+#include "blake2b-compress.h"
+
+#if defined(__SSE4_1__) || (defined(_MSC_VER) && defined(_M_X64))
+
+#include <smmintrin.h>
+
+#include "blake2-impl.h"
+
+/* Each row of the 4x4 state is split into a low and a high register */
+
+#define ROTR32(x) _mm_shuffle_epi32((x), _MM_SHUFFLE(2, 3, 0, 1))
+#define ROTR24(x) _mm_shuffle_epi8((x), r24)
+#define ROTR16(x) _mm_shuffle_epi8((x), r16)
+#define ROTR63(x) _mm_or_si128(_mm_srli_epi64((x), 63), _mm_add_epi64((x), (x)))
+
+#define G1(a, b, c, d, m)                                                      \
+    do {                                                                       \
+        a = _mm_add_epi64(_mm_add_epi64(a, b), m);                             \
+        d = ROTR32(_mm_xor_si128(d, a));                                       \
+        c = _mm_add_epi64(c, d);                                               \
+        b = ROTR24(_mm_xor_si128(b, c));                                       \
+    } while ((void)0, 0)
+
+#define G2(a, b, c, d, m)                                                      \
+    do {                                                                       \
+        a = _mm_add_epi64(_mm_add_epi64(a, b), m);                             \
+        d = ROTR16(_mm_xor_si128(d, a));                                       \
+        c = _mm_add_epi64(c, d);                                               \
+        b = ROTR63(_mm_xor_si128(b, c));                                       \
+    } while ((void)0, 0)
+
+#define G(m0l, m0h, m1l, m1h)                                                  \
+    do {                                                                       \
+        G1(row1l, row2l, row3l, row4l, m0l);                                   \
+        G1(row1h, row2h, row3h, row4h, m0h);                                   \
+        G2(row1l, row2l, row3l, row4l, m1l);                                   \
+        G2(row1h, row2h, row3h, row4h, m1h);                                   \
+    } while ((void)0, 0)
+
+#define DIAGONALIZE()                                                          \
+    do {                                                                       \
+        __m128i t0 = _mm_alignr_epi8(row2h, row2l, 8);                         \
+        __m128i t1 = _mm_alignr_epi8(row2l, row2h, 8);                         \
+        row2l = t0;                                                            \
+        row2h = t1;                                                            \
+        t0 = row3l;                                                            \
+        row3l = row3h;                                                         \
+        row3h = t0;                                                            \
+        t0 = _mm_alignr_epi8(row4h, row4l, 8);                                 \
+        t1 = _mm_alignr_epi8(row4l, row4h, 8);                                 \
+        row4l = t1;                                                            \
+        row4h = t0;                                                            \
+    } while ((void)0, 0)
+
+#define UNDIAGONALIZE()                                                        \
+    do {                                                                       \
+        __m128i t0 = _mm_alignr_epi8(row2l, row2h, 8);                         \
+        __m128i t1 = _mm_alignr_epi8(row2h, row2l, 8);                         \
+        row2l = t0;                                                            \
+        row2h = t1;                                                            \
+        t0 = row3l;                                                            \
+        row3l = row3h;                                                         \
+        row3h = t0;                                                            \
+        t0 = _mm_alignr_epi8(row4l, row4h, 8);                                 \
+        t1 = _mm_alignr_epi8(row4h, row4l, 8);                                 \
+        row4l = t1;                                                            \
+        row4h = t0;                                                            \
+    } while ((void)0, 0)
+
+#define MSG(s, i0, i1) _mm_set_epi64x((long long)m[s[i1]], (long long)m[s[i0]])
+
+static void blake2b_compress_sse41(blake2b_state *S, const uint8_t *block) {
+	const __m128i r16 = _mm_setr_epi8(2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9);
+	const __m128i r24 = _mm_setr_epi8(3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10);
+	uint64_t m[16];
+	unsigned int i, r;
+	__m128i row1l, row1h, row2l, row2h, row3l, row3h, row4l, row4h;
+	__m128i h0, h1, h2, h3;
+
+	for (i = 0; i < 16; ++i) {
+		m[i] = load64(block + i * sizeof(m[i]));
+	}
+
+	h0 = _mm_loadu_si128((const __m128i *)&S->h[0]);
+	h1 = _mm_loadu_si128((const __m128i *)&S->h[2]);
+	h2 = _mm_loadu_si128((const __m128i *)&S->h[4]);
+	h3 = _mm_loadu_si128((const __m128i *)&S->h[6]);
+	row1l = h0;
+	row1h = h1;
+	row2l = h2;
+	row2h = h3;
+	row3l = _mm_loadu_si128((const __m128i *)&blake2b_IV[0]);
+	row3h = _mm_loadu_si128((const __m128i *)&blake2b_IV[2]);
+	row4l = _mm_xor_si128(_mm_loadu_si128((const __m128i *)&blake2b_IV[4]), _mm_loadu_si128((const __m128i *)&S->t[0]));
+	row4h = _mm_xor_si128(_mm_loadu_si128((const __m128i *)&blake2b_IV[6]), _mm_loadu_si128((const __m128i *)&S->f[0]));
+
+	for (r = 0; r < 12; ++r) {
+		const unsigned int *s = blake2b_sigma[r];
+		G(MSG(s, 0, 2), MSG(s, 4, 6), MSG(s, 1, 3), MSG(s, 5, 7));
+		DIAGONALIZE();
+		G(MSG(s, 8, 10), MSG(s, 12, 14), MSG(s, 9, 11), MSG(s, 13, 15));
+		UNDIAGONALIZE();
+	}
+
+	_mm_storeu_si128((__m128i *)&S->h[0], _mm_xor_si128(h0, _mm_xor_si128(row1l, row3l)));
+	_mm_storeu_si128((__m128i *)&S->h[2], _mm_xor_si128(h1, _mm_xor_si128(row1h, row3h)));
+	_mm_storeu_si128((__m128i *)&S->h[4], _mm_xor_si128(h2, _mm_xor_si128(row2l, row4l)));
+	_mm_storeu_si128((__m128i *)&S->h[6], _mm_xor_si128(h3, _mm_xor_si128(row2h, row4h)));
+}
+
+blake2b_compress_fn *blake2b_compress_sse41_impl(void) {
+	return &blake2b_compress_sse41;
+}
+
+#else
+
+blake2b_compress_fn *blake2b_compress_sse41_impl(void) {
+	return NULL;
+}
+
+#endif
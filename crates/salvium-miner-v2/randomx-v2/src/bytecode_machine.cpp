@@ -78,6 +78,249 @@ namespace randomx {
 		}
 	}
 
+//instructions that can be fused, with the index used in the dispatch code
+#define FUSED_FIRST(x) \
+	x(IADD_RS) x(ISUB_R) x(IMUL_R) x(IXOR_R) x(FADD_R) x(FSUB_R) x(FMUL_R) x(ISTORE)
+#define FUSED_SECOND(x, a) \
+	x(a, IADD_RS) x(a, ISUB_R) x(a, IMUL_R) x(a, IXOR_R) x(a, FADD_R) x(a, FSUB_R) x(a, FMUL_R) x(a, ISTORE)
+
+//operand-specialized variants, in dispatch code order
+#define SPECIALIZED_OPS(x) \
+	x(ISUB_I, exe_ISUB_I) \
+	x(IMUL_I, exe_IMUL_I) \
+	x(IXOR_I, exe_IXOR_I) \
+	x(IROR_I, exe_IROR_I) \
+	x(IROL_I, exe_IROL_I) \
+	SPECIALIZED_MEM_OPS(x, IADD_M) \
+	SPECIALIZED_MEM_OPS(x, ISUB_M) \
+	SPECIALIZED_MEM_OPS(x, IMUL_M) \
+	SPECIALIZED_MEM_OPS(x, IMULH_M) \
+	SPECIALIZED_MEM_OPS(x, ISMULH_M) \
+	SPECIALIZED_MEM_OPS(x, IXOR_M) \
+	SPECIALIZED_FLT_OPS(x, FADD_M) \
+	SPECIALIZED_FLT_OPS(x, FSUB_M) \
+	SPECIALIZED_FLT_OPS(x, FDIV_M) \
+	SPECIALIZED_MEM_OPS(x, ISTORE)
+#define SPECIALIZED_MEM_OPS(x, op) \
+	x(op ## _L1, exe_ ## op<ScratchpadL1Mask>) \
+	x(op ## _L2, exe_ ## op<ScratchpadL2Mask>) \
+	x(op ## _L3, exe_ ## op<ScratchpadL3Mask>)
+#define SPECIALIZED_FLT_OPS(x, op) \
+	x(op ## _L1, exe_ ## op<ScratchpadL1Mask>) \
+	x(op ## _L2, exe_ ## op<ScratchpadL2Mask>)
+
+#define SPECIALIZED_CODE(name, exe) code_ ## name,
+
+	enum SpecializedCode {
+		code_specialized = ThreadedSpecializedBase - 1,
+		SPECIALIZED_OPS(SPECIALIZED_CODE)
+		code_specializedEnd
+	};
+
+	static_assert(code_specializedEnd == ThreadedSpecializedBase + ThreadedSpecializedCount, "Invalid number of specialized instructions");
+
+	//the L1, L2 and L3 variants have consecutive codes
+	static uint8_t getLevelCode(const InstructionByteCode& ibc, int codeL1) {
+		if (ibc.memMask == ScratchpadL1Mask)
+			return codeL1;
+		if (ibc.memMask == ScratchpadL2Mask)
+			return codeL1 + 1;
+		return codeL1 + 2;
+	}
+
+	static uint8_t getDispatchCode(const InstructionByteCode& ibc) {
+		bool immediate = ibc.isrc == &ibc.imm;
+		switch (ibc.type)
+		{
+		case InstructionType::ISUB_R:
+			return immediate ? (uint8_t)code_ISUB_I : (uint8_t)ibc.type;
+		case InstructionType::IMUL_R:
+			return immediate ? (uint8_t)code_IMUL_I : (uint8_t)ibc.type;
+		case InstructionType::IXOR_R:
+			return immediate ? (uint8_t)code_IXOR_I : (uint8_t)ibc.type;
+		case InstructionType::IROR_R:
+			return immediate ? (uint8_t)code_IROR_I : (uint8_t)ibc.type;
+		case InstructionType::IROL_R:
+			return immediate ? (uint8_t)code_IROL_I : (uint8_t)ibc.type;
+		case InstructionType::IADD_M:
+			return getLevelCode(ibc, code_IADD_M_L1);
+		case InstructionType::ISUB_M:
+			return getLevelCode(ibc, code_ISUB_M_L1);
+		case InstructionType::IMUL_M:
+			return getLevelCode(ibc, code_IMUL_M_L1);
+		case InstructionType::IMULH_M:
+			return getLevelCode(ibc, code_IMULH_M_L1);
+		case InstructionType::ISMULH_M:
+			return getLevelCode(ibc, code_ISMULH_M_L1);
+		case InstructionType::IXOR_M:
+			return getLevelCode(ibc, code_IXOR_M_L1);
+		case InstructionType::FADD_M:
+			return getLevelCode(ibc, code_FADD_M_L1);
+		case InstructionType::FSUB_M:
+			return getLevelCode(ibc, code_FSUB_M_L1);
+		case InstructionType::FDIV_M:
+			return getLevelCode(ibc, code_FDIV_M_L1);
+		case InstructionType::ISTORE:
+			return getLevelCode(ibc, code_ISTORE_L1);
+		default:
+			return (uint8_t)ibc.type;
+		}
+	}
+
+#define FUSED_TYPE(x) InstructionType::x,
+
+	static const InstructionType fusedTypes[] = { FUSED_FIRST(FUSED_TYPE) };
+
+	static_assert(sizeof(fusedTypes) / sizeof(fusedTypes[0]) == ThreadedFusedOps, "Invalid number of fused instructions");
+
+	static int getFusedIndex(InstructionType type) {
+		for (int i = 0; i < ThreadedFusedOps; ++i) {
+			if (fusedTypes[i] == type)
+				return i;
+		}
+		return -1;
+	}
+
+	void BytecodeMachine::threadBytecode(const InstructionByteCode bytecode[RANDOMX_PROGRAM_SIZE], uint8_t dispatch[RANDOMX_PROGRAM_SIZE + 1]) {
+		for (int pc = 0; pc < RANDOMX_PROGRAM_SIZE; ++pc) {
+			dispatch[pc] = getDispatchCode(bytecode[pc]);
+		}
+		dispatch[RANDOMX_PROGRAM_SIZE] = ThreadedEnd;
+		for (int pc = 0; pc < RANDOMX_PROGRAM_SIZE - 1; ++pc) {
+			int first = getFusedIndex(bytecode[pc].type);
+			if (first < 0)
+				continue;
+			int second = getFusedIndex(bytecode[pc + 1].type);
+			if (second < 0)
+				continue;
+			dispatch[pc] = ThreadedFusedBase + first * ThreadedFusedOps + second;
+			++pc;
+		}
+	}
+
+#if RANDOMX_COMPUTED_GOTO
+
+#define DISPATCH goto *dispatchTable[dispatch[pc]]
+
+#define THREADED_LABEL(x) &&op_ ## x,
+#define THREADED_SPECIALIZED_LABEL(name, exe) &&op_ ## name,
+#define THREADED_PAIR_LABEL(a, b) &&op_ ## a ## _ ## b,
+#define THREADED_ROW_LABELS(a) FUSED_SECOND(THREADED_PAIR_LABEL, a)
+
+#define THREADED_CASE(x) op_ ## x: \
+	exe_ ## x(bytecode[pc], pc, scratchpad, config); \
+	++pc; \
+	DISPATCH;
+
+#define THREADED_SPECIALIZED_CASE(name, exe) op_ ## name: \
+	exe(bytecode[pc], pc, scratchpad, config); \
+	++pc; \
+	DISPATCH;
+
+#define THREADED_PAIR_CASE(a, b) op_ ## a ## _ ## b: \
+	exe_ ## a(bytecode[pc], pc, scratchpad, config); \
+	exe_ ## b(bytecode[pc + 1], pc, scratchpad, config); \
+	pc += 2; \
+	DISPATCH;
+#define THREADED_ROW_CASES(a) FUSED_SECOND(THREADED_PAIR_CASE, a)
+
+	void BytecodeMachine::executeBytecodeThreaded(InstructionByteCode bytecode[RANDOMX_PROGRAM_SIZE], const uint8_t dispatch[RANDOMX_PROGRAM_SIZE + 1], uint8_t* scratchpad, ProgramConfiguration& config) {
+		static const void* const dispatchTable[] = {
+			THREADED_LABEL(IADD_RS)
+			THREADED_LABEL(IADD_M)
+			THREADED_LABEL(ISUB_R)
+			THREADED_LABEL(ISUB_M)
+			THREADED_LABEL(IMUL_R)
+			THREADED_LABEL(IMUL_M)
+			THREADED_LABEL(IMULH_R)
+			THREADED_LABEL(IMULH_M)
+			THREADED_LABEL(ISMULH_R)
+			THREADED_LABEL(ISMULH_M)
+			&&op_invalid, //IMUL_RCP is executed as IMUL_R
+			THREADED_LABEL(INEG_R)
+			THREADED_LABEL(IXOR_R)
+			THREADED_LABEL(IXOR_M)
+			THREADED_LABEL(IROR_R)
+			THREADED_LABEL(IROL_R)
+			THREADED_LABEL(ISWAP_R)
+			THREADED_LABEL(FSWAP_R)
+			THREADED_LABEL(FADD_R)
+			THREADED_LABEL(FADD_M)
+			THREADED_LABEL(FSUB_R)
+			THREADED_LABEL(FSUB_M)
+			THREADED_LABEL(FSCAL_R)
+			THREADED_LABEL(FMUL_R)
+			THREADED_LABEL(FDIV_M)
+			THREADED_LABEL(FSQRT_R)
+			THREADED_LABEL(CBRANCH)
+			THREADED_LABEL(CFROUND)
+			THREADED_LABEL(ISTORE)
+			THREADED_LABEL(NOP)
+			&&op_invalid,
+			&&op_invalid,
+			SPECIALIZED_OPS(THREADED_SPECIALIZED_LABEL)
+			FUSED_FIRST(THREADED_ROW_LABELS)
+			&&op_end
+		};
+
+		static_assert(sizeof(dispatchTable) / sizeof(dispatchTable[0]) == ThreadedEnd + 1, "Invalid dispatch table size");
+		static_assert((int)InstructionType::NOP < ThreadedSpecializedBase, "Invalid dispatch code layout");
+
+		int pc = 0;
+		DISPATCH;
+
+		THREADED_CASE(IADD_RS)
+		THREADED_CASE(IADD_M)
+		THREADED_CASE(ISUB_R)
+		THREADED_CASE(ISUB_M)
+		THREADED_CASE(IMUL_R)
+		THREADED_CASE(IMUL_M)
+		THREADED_CASE(IMULH_R)
+		THREADED_CASE(IMULH_M)
+		THREADED_CASE(ISMULH_R)
+		THREADED_CASE(ISMULH_M)
+		THREADED_CASE(INEG_R)
+		THREADED_CASE(IXOR_R)
+		THREADED_CASE(IXOR_M)
+		THREADED_CASE(IROR_R)
+		THREADED_CASE(IROL_R)
+		THREADED_CASE(ISWAP_R)
+		THREADED_CASE(FSWAP_R)
+		THREADED_CASE(FADD_R)
+		THREADED_CASE(FADD_M)
+		THREADED_CASE(FSUB_R)
+		THREADED_CASE(FSUB_M)
+		THREADED_CASE(FSCAL_R)
+		THREADED_CASE(FMUL_R)
+		THREADED_CASE(FDIV_M)
+		THREADED_CASE(FSQRT_R)
+		THREADED_CASE(CBRANCH)
+		THREADED_CASE(CFROUND)
+		THREADED_CASE(ISTORE)
+
+		SPECIALIZED_OPS(THREADED_SPECIALIZED_CASE)
+
+		FUSED_FIRST(THREADED_ROW_CASES)
+
+	op_NOP:
+		++pc;
+		DISPATCH;
+
+	op_invalid:
+		UNREACHABLE;
+
+	op_end:
+		return;
+	}
+
+#else
+
+	void BytecodeMachine::executeBytecodeThreaded(InstructionByteCode bytecode[RANDOMX_PROGRAM_SIZE], const uint8_t dispatch[RANDOMX_PROGRAM_SIZE + 1], uint8_t* scratchpad, ProgramConfiguration& config) {
+		executeBytecode(bytecode, scratchpad, config);
+	}
+
+#endif
+
 	void BytecodeMachine::compileInstruction(RANDOMX_GEN_ARGS) {
 		int opcode = instr.opcode;
 
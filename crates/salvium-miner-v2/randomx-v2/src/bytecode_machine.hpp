@@ -98,6 +98,24 @@ namespace randomx {
 	OPCODE_CEIL_DECLARE(NOP, ISTORE);
 #undef OPCODE_CEIL_DECLARE
 
+//The threaded interpreter dispatches through a table of label addresses
+//(a GNU extension). Other compilers fall back to the switch interpreter.
+#if defined(__GNUC__) && !defined(RANDOMX_NO_COMPUTED_GOTO)
+#define RANDOMX_COMPUTED_GOTO 1
+#else
+#define RANDOMX_COMPUTED_GOTO 0
+#endif
+
+	//Dispatch codes used by the threaded interpreter. Codes below
+	//ThreadedSpecializedBase are InstructionType values. They are followed
+	//by the operand-specialized variants, one code per fused pair of
+	//ThreadedFusedOps instructions and the end marker.
+	constexpr int ThreadedSpecializedBase = 32;
+	constexpr int ThreadedSpecializedCount = 32;
+	constexpr int ThreadedFusedOps = 8;
+	constexpr int ThreadedFusedBase = ThreadedSpecializedBase + ThreadedSpecializedCount;
+	constexpr int ThreadedEnd = ThreadedFusedBase + ThreadedFusedOps * ThreadedFusedOps;
+
 #define RANDOMX_EXE_ARGS InstructionByteCode& ibc, int& pc, uint8_t* scratchpad, ProgramConfiguration& config
 #define RANDOMX_GEN_ARGS Instruction& instr, int i, InstructionByteCode& ibc
 
@@ -130,6 +148,15 @@ namespace randomx {
 			}
 		}
 
+		//Builds the dispatch codes for executeBytecodeThreaded. Instructions with
+		//an immediate source or a fixed scratchpad level get a specialized code.
+		//Adjacent pairs of common instructions are fused into one superinstruction.
+		//The second instruction keeps its own code, so branches may still land on it.
+		static void threadBytecode(const InstructionByteCode bytecode[RANDOMX_PROGRAM_SIZE], uint8_t dispatch[RANDOMX_PROGRAM_SIZE + 1]);
+
+		//Same result as executeBytecode, but each handler jumps directly to the next one.
+		static void executeBytecodeThreaded(InstructionByteCode bytecode[RANDOMX_PROGRAM_SIZE], const uint8_t dispatch[RANDOMX_PROGRAM_SIZE + 1], uint8_t* scratchpad, ProgramConfiguration& config);
+
 		void compileInstruction(RANDOMX_GEN_ARGS)
 #ifdef RANDOMX_GEN_TABLE
 		{
@@ -265,6 +292,84 @@ namespace randomx {
 		static void exe_ISTORE(RANDOMX_EXE_ARGS) {
 			store64(scratchpad + ((*ibc.idst + ibc.imm) & ibc.memMask), *ibc.isrc);
 		}
+
+		//Variants selected by threadBytecode: the _I forms read the immediate
+		//directly and the templates have the scratchpad mask built in.
+		static void exe_ISUB_I(RANDOMX_EXE_ARGS) {
+			*ibc.idst -= ibc.imm;
+		}
+
+		static void exe_IMUL_I(RANDOMX_EXE_ARGS) {
+			*ibc.idst *= ibc.imm;
+		}
+
+		static void exe_IXOR_I(RANDOMX_EXE_ARGS) {
+			*ibc.idst ^= ibc.imm;
+		}
+
+		static void exe_IROR_I(RANDOMX_EXE_ARGS) {
+			*ibc.idst = rotr(*ibc.idst, ibc.imm & 63);
+		}
+
+		static void exe_IROL_I(RANDOMX_EXE_ARGS) {
+			*ibc.idst = rotl(*ibc.idst, ibc.imm & 63);
+		}
+
+		template<uint32_t memMask>
+		static void exe_IADD_M(RANDOMX_EXE_ARGS) {
+			*ibc.idst += load64(getScratchpadAddress<memMask>(ibc, scratchpad));
+		}
+
+		template<uint32_t memMask>
+		static void exe_ISUB_M(RANDOMX_EXE_ARGS) {
+			*ibc.idst -= load64(getScratchpadAddress<memMask>(ibc, scratchpad));
+		}
+
+		template<uint32_t memMask>
+		static void exe_IMUL_M(RANDOMX_EXE_ARGS) {
+			*ibc.idst *= load64(getScratchpadAddress<memMask>(ibc, scratchpad));
+		}
+
+		template<uint32_t memMask>
+		static void exe_IMULH_M(RANDOMX_EXE_ARGS) {
+			*ibc.idst = mulh(*ibc.idst, load64(getScratchpadAddress<memMask>(ibc, scratchpad)));
+		}
+
+		template<uint32_t memMask>
+		static void exe_ISMULH_M(RANDOMX_EXE_ARGS) {
+			*ibc.idst = smulh(unsigned64ToSigned2sCompl(*ibc.idst), unsigned64ToSigned2sCompl(load64(getScratchpadAddress<memMask>(ibc, scratchpad))));
+		}
+
+		template<uint32_t memMask>
+		static void exe_IXOR_M(RANDOMX_EXE_ARGS) {
+			*ibc.idst ^= load64(getScratchpadAddress<memMask>(ibc, scratchpad));
+		}
+
+		template<uint32_t memMask>
+		static void exe_FADD_M(RANDOMX_EXE_ARGS) {
+			rx_vec_f128 fsrc = rx_cvt_packed_int_vec_f128(getScratchpadAddress<memMask>(ibc, scratchpad));
+			*ibc.fdst = rx_add_vec_f128(*ibc.fdst, fsrc);
+		}
+
+		template<uint32_t memMask>
+		static void exe_FSUB_M(RANDOMX_EXE_ARGS) {
+			rx_vec_f128 fsrc = rx_cvt_packed_int_vec_f128(getScratchpadAddress<memMask>(ibc, scratchpad));
+			*ibc.fdst = rx_sub_vec_f128(*ibc.fdst, fsrc);
+		}
+
+		template<uint32_t memMask>
+		static void exe_FDIV_M(RANDOMX_EXE_ARGS) {
+			rx_vec_f128 fsrc = maskRegisterExponentMantissa(
+				config,
+				rx_cvt_packed_int_vec_f128(getScratchpadAddress<memMask>(ibc, scratchpad))
+			);
+			*ibc.fdst = rx_div_vec_f128(*ibc.fdst, fsrc);
+		}
+
+		template<uint32_t memMask>
+		static void exe_ISTORE(RANDOMX_EXE_ARGS) {
+			store64(scratchpad + ((*ibc.idst + ibc.imm) & memMask), *ibc.isrc);
+		}
 	protected:
 		static rx_vec_f128 maskRegisterExponentMantissa(ProgramConfiguration& config, rx_vec_f128 x) {
 			const rx_vec_f128 xmantissaMask = rx_set_vec_f128(dynamicMantissaMask, dynamicMantissaMask);
@@ -284,6 +389,13 @@ namespace randomx {
 			return scratchpad + addr;
 		}
 
+		//loads from L3 only happen when src == dst, so the address is the immediate alone
+		template<uint32_t memMask>
+		static void* getScratchpadAddress(InstructionByteCode& ibc, uint8_t* scratchpad) {
+			uint64_t base = memMask == ScratchpadL3Mask ? 0 : *ibc.isrc;
+			return scratchpad + ((base + ibc.imm) & memMask);
+		}
+
 #ifdef RANDOMX_GEN_TABLE
 		static InstructionGenBytecode genTable[256];
 
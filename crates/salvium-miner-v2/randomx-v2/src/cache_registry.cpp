@@ -0,0 +1,180 @@
+/*
+Copyright (c) 2026, The Salvium Project
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in the
+	  documentation and/or other materials provided with the distribution.
+	* Neither the name of the copyright holder nor the
+	  names of its contributors may be used to endorse or promote products
+	  derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include <algorithm>
+#include <cassert>
+#include <tuple>
+#include "cache_registry.hpp"
+#include "common.hpp"
+
+randomx_cache_registry::randomx_cache_registry(randomx_flags flags, size_t memoryBudget, unsigned initThreads) :
+	flags(flags), maxCaches(std::max(memoryBudget / randomx::CacheSize, (size_t)1)), initThreads(std::max(initThreads, 1u)), useCounter(0) {
+}
+
+randomx_cache_registry::~randomx_cache_registry() {
+	std::unique_lock<std::mutex> lock(mutex);
+	readyCondition.wait(lock, [this] {
+		return std::all_of(entries.begin(), entries.end(), [](const EntryMap::value_type& item) { return item.second.ready; });
+	});
+	lock.unlock();
+	for (auto& item : entries) {
+		if (item.second.initializer.joinable()) {
+			item.second.initializer.join();
+		}
+		randomx_release_cache(item.second.cache);
+	}
+}
+
+bool randomx_cache_registry::prepare(const std::string& seed) {
+	std::lock_guard<std::mutex> lock(mutex);
+	return findOrCreate(seed) != entries.end();
+}
+
+randomx_cache* randomx_cache_registry::acquire(const std::string& seed) {
+	std::unique_lock<std::mutex> lock(mutex);
+	auto it = findOrCreate(seed);
+	if (it == entries.end()) {
+		return nullptr;
+	}
+	randomx::CacheEntry& entry = it->second;
+	entry.refs++;
+	readyCondition.wait(lock, [&entry] { return entry.ready; });
+	return entry.cache;
+}
+
+void randomx_cache_registry::release(randomx_cache* cache) {
+	std::lock_guard<std::mutex> lock(mutex);
+	for (auto& item : entries) {
+		if (item.second.cache == cache) {
+			assert(item.second.refs > 0);
+			item.second.refs--;
+			return;
+		}
+	}
+}
+
+bool randomx_cache_registry::attachVm(randomx_vm* vm, const std::string& seed) {
+	randomx_cache* cache = acquire(seed);
+	if (cache == nullptr) {
+		return false;
+	}
+	randomx_vm_set_cache(vm, cache);
+	randomx_cache* previous = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		randomx_cache*& current = vms[vm];
+		previous = current;
+		current = cache;
+	}
+	if (previous != nullptr) {
+		release(previous);
+	}
+	return true;
+}
+
+void randomx_cache_registry::detachVm(randomx_vm* vm) {
+	randomx_cache* cache;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto it = vms.find(vm);
+		if (it == vms.end()) {
+			return;
+		}
+		cache = it->second;
+		vms.erase(it);
+	}
+	release(cache);
+}
+
+size_t randomx_cache_registry::getCacheCount() {
+	std::lock_guard<std::mutex> lock(mutex);
+	return entries.size();
+}
+
+randomx_cache_registry::EntryMap::iterator randomx_cache_registry::findOrCreate(const std::string& seed) {
+	auto it = entries.find(seed);
+	if (it != entries.end()) {
+		it->second.lastUse = ++useCounter;
+		return it;
+	}
+	if (entries.size() >= maxCaches && !evictLeastRecentlyUsed()) {
+		return entries.end();
+	}
+	randomx_cache* cache = randomx_alloc_cache(flags);
+	if (cache == nullptr) {
+		return entries.end();
+	}
+	try {
+		it = entries.emplace(std::piecewise_construct, std::forward_as_tuple(seed), std::forward_as_tuple()).first;
+	}
+	catch (std::exception&) {
+		randomx_release_cache(cache);
+		return entries.end();
+	}
+	randomx::CacheEntry& entry = it->second;
+	entry.cache = cache;
+	entry.lastUse = ++useCounter;
+	try {
+		entry.initializer = std::thread(&randomx_cache_registry::initialize, this, &entry, seed);
+	}
+	catch (std::exception&) {
+		//initialize synchronously; the lock is already held
+		randomx_init_cache_parallel(cache, seed.data(), seed.size(), initThreads);
+		entry.ready = true;
+	}
+	return it;
+}
+
+bool randomx_cache_registry::evictLeastRecentlyUsed() {
+	auto victim = entries.end();
+	for (auto it = entries.begin(); it != entries.end(); ++it) {
+		if (it->second.ready && it->second.refs == 0 && (victim == entries.end() || it->second.lastUse < victim->second.lastUse)) {
+			victim = it;
+		}
+	}
+	if (victim == entries.end()) {
+		return false;
+	}
+	//the initializer has already finished because the entry is ready
+	if (victim->second.initializer.joinable()) {
+		victim->second.initializer.join();
+	}
+	randomx_release_cache(victim->second.cache);
+	entries.erase(victim);
+	return true;
+}
+
+void randomx_cache_registry::initialize(randomx::CacheEntry* entry, std::string seed) {
+	randomx_init_cache_parallel(entry->cache, seed.data(), seed.size(), initThreads);
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		entry->ready = true;
+	}
+	readyCondition.notify_all();
+}
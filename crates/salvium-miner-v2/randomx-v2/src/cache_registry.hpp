@@ -0,0 +1,77 @@
+/*
+Copyright (c) 2026, The Salvium Project
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in the
+	  documentation and/or other materials provided with the distribution.
+	* Neither the name of the copyright holder nor the
+	  names of its contributors may be used to endorse or promote products
+	  derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#pragma once
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "randomx.h"
+
+namespace randomx {
+
+	//A cache owned by the registry. The entry cannot be evicted while it is
+	//being initialized or referenced.
+	struct CacheEntry {
+		randomx_cache* cache = nullptr;
+		unsigned refs = 0;
+		uint64_t lastUse = 0;
+		bool ready = false;
+		std::thread initializer;
+	};
+}
+
+/* Global namespace for C binding */
+class randomx_cache_registry {
+public:
+	randomx_cache_registry(randomx_flags flags, size_t memoryBudget, unsigned initThreads);
+	~randomx_cache_registry();
+	bool prepare(const std::string& seed);
+	randomx_cache* acquire(const std::string& seed);
+	void release(randomx_cache* cache);
+	bool attachVm(randomx_vm* vm, const std::string& seed);
+	void detachVm(randomx_vm* vm);
+	size_t getCacheCount();
+private:
+	using EntryMap = std::map<std::string, randomx::CacheEntry>;
+	EntryMap::iterator findOrCreate(const std::string& seed);
+	bool evictLeastRecentlyUsed();
+	void initialize(randomx::CacheEntry* entry, std::string seed);
+
+	const randomx_flags flags;
+	const size_t maxCaches;
+	const unsigned initThreads;
+	std::mutex mutex; //protects entries, vms and useCounter
+	std::condition_variable readyCondition;
+	EntryMap entries;
+	std::map<randomx_vm*, randomx_cache*> vms;
+	uint64_t useCounter;
+};
@@ -26,6 +26,7 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <cstdint>
 #include "cpu.hpp"
 
 #if defined(_M_X64) || defined(__x86_64__)
@@ -33,11 +34,17 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 	#if defined(_MSC_VER)
 		#include <intrin.h>
 		#define cpuid(info, x) __cpuidex(info, x, 0)
+		#define xgetbv() _xgetbv(0)
 	#else //GCC
 		#include <cpuid.h>
 		void cpuid(int info[4], int InfoType) {
 			__cpuid_count(InfoType, 0, info[0], info[1], info[2], info[3]);
 		}
+		static uint64_t xgetbv() {
+			uint32_t eax, edx;
+			__asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+			return ((uint64_t)edx << 32) | eax;
+		}
 	#endif
 #endif
 
@@ -48,19 +55,31 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace randomx {
 
-	Cpu::Cpu() : aes_(false), ssse3_(false), avx2_(false) {
+	Cpu::Cpu() : aes_(false), ssse3_(false), sse41_(false), avx2_(false), avx512_(false), vaes_(false) {
 #ifdef HAVE_CPUID
 		int info[4];
 		cpuid(info, 0);
 		int nIds = info[0];
+		//YMM (and ZMM) registers must be enabled by the OS
+		bool osAvx = false, osAvx512 = false;
 		if (nIds >= 0x00000001) {
 			cpuid(info, 0x00000001);
 			ssse3_ = (info[2] & (1 << 9)) != 0;
+			sse41_ = (info[2] & (1 << 19)) != 0;
 			aes_ = (info[2] & (1 << 25)) != 0;
+			if ((info[2] & (1 << 27)) != 0) {
+				uint64_t xcr0 = xgetbv();
+				osAvx = (xcr0 & 0x06) == 0x06;
+				osAvx512 = (xcr0 & 0xe6) == 0xe6;
+			}
 		}
 		if (nIds >= 0x00000007) {
 			cpuid(info, 0x00000007);
-			avx2_ = (info[1] & (1 << 5)) != 0;
+			avx2_ = osAvx && (info[1] & (1 << 5)) != 0;
+			//AVX512F + AVX512DQ
+			avx512_ = osAvx512 && (info[1] & (1 << 16)) != 0 && (info[1] & (1 << 17)) != 0;
+			//256-bit VAES is VEX encoded, so it also needs AVX2
+			vaes_ = avx2_ && (info[2] & (1 << 9)) != 0;
 		}
 #elif defined(__aarch64__)
 	#if defined(HWCAP_AES)
@@ -39,11 +39,20 @@ namespace randomx {
 		bool hasSsse3() const {
 			return ssse3_;
 		}
+		bool hasSse41() const {
+			return sse41_;
+		}
 		bool hasAvx2() const {
 			return avx2_;
 		}
+		bool hasAvx512() const {
+			return avx512_;
+		}
+		bool hasVaes() const {
+			return vaes_;
+		}
 	private:
-		bool aes_, ssse3_, avx2_;
+		bool aes_, ssse3_, sse41_, avx2_, avx512_, vaes_;
 	};
 
 }
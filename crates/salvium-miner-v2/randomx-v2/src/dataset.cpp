@@ -39,6 +39,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <limits>
 #include <cstring>
 #include <cassert>
+#include <thread>
+#include <vector>
 
 #include "common.hpp"
 #include "dataset.hpp"
@@ -47,10 +49,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "blake2_generator.hpp"
 #include "reciprocal.h"
 #include "blake2/endian.h"
+#include "blake2/blake2.h"
 #include "argon2.h"
 #include "argon2_core.h"
 #include "jit_compiler.hpp"
 #include "intrin_portable.h"
+#include "cpu.hpp"
 
 static_assert(RANDOMX_ARGON_MEMORY % (RANDOMX_ARGON_LANES * ARGON2_SYNC_POINTS) == 0, "RANDOMX_ARGON_MEMORY - invalid value");
 static_assert(ARGON2_BLOCK_SIZE == randomx::ArgonBlockSize, "Unpexpected value of ARGON2_BLOCK_SIZE");
@@ -63,12 +67,13 @@ namespace randomx {
 			Allocator::freeMemory(cache->memory, CacheSize);
 		if (cache->jit != nullptr)
 			delete cache->jit;
+		delete cache->itemMemo;
 	}
 
 	template void deallocCache<DefaultAllocator>(randomx_cache* cache);
 	template void deallocCache<LargePageAllocator>(randomx_cache* cache);
 
-	void initCache(randomx_cache* cache, const void* key, size_t keySize) {
+	static void fillCache(randomx_cache* cache, const void* key, size_t keySize) {
 		uint32_t memory_blocks, segment_length;
 		argon2_instance_t instance;
 		argon2_context context;
@@ -123,7 +128,9 @@ namespace randomx {
 		randomx_argon2_initialize(&instance, &context);
 
 		randomx_argon2_fill_memory_blocks(&instance);
+	}
 
+	static void generateCachePrograms(randomx_cache* cache, const void* key, size_t keySize) {
 		cache->reciprocalCache.clear();
 		randomx::Blake2Generator gen(key, keySize);
 		for (int i = 0; i < RANDOMX_CACHE_ACCESSES; ++i) {
@@ -139,22 +146,133 @@ namespace randomx {
 		}
 	}
 
-	void initCacheCompile(randomx_cache* cache, const void* key, size_t keySize) {
-		initCache(cache, key, keySize);
+	static void compileCachePrograms(randomx_cache* cache) {
 		cache->jit->enableWriting();
 		cache->jit->generateSuperscalarHash(cache->programs, cache->reciprocalCache);
 		cache->jit->generateDatasetInitCode();
 		cache->jit->enableExecution();
 	}
 
-	constexpr uint64_t superscalarMul0 = 6364136223846793005ULL;
-	constexpr uint64_t superscalarAdd1 = 9298411001130361340ULL;
-	constexpr uint64_t superscalarAdd2 = 12065312585734608966ULL;
-	constexpr uint64_t superscalarAdd3 = 9306329213124626780ULL;
-	constexpr uint64_t superscalarAdd4 = 5281919268842080866ULL;
-	constexpr uint64_t superscalarAdd5 = 10536153434571861004ULL;
-	constexpr uint64_t superscalarAdd6 = 3398623926847679864ULL;
-	constexpr uint64_t superscalarAdd7 = 9549104520008361294ULL;
+	void initCache(randomx_cache* cache, const void* key, size_t keySize) {
+		fillCache(cache, key, keySize);
+		generateCachePrograms(cache, key, keySize);
+	}
+
+	void initCacheCompile(randomx_cache* cache, const void* key, size_t keySize) {
+		initCache(cache, key, keySize);
+		compileCachePrograms(cache);
+	}
+
+	static void touchCacheMemory(uint8_t* memory, size_t size) {
+		constexpr size_t pageSize = 4096;
+		for (size_t offset = 0; offset < size; offset += pageSize) {
+			((volatile uint8_t*)memory)[offset] = 0;
+		}
+	}
+
+	void initCacheParallel(randomx_cache* cache, const void* key, size_t keySize, unsigned threadCount) {
+		std::vector<std::thread> workers;
+		try {
+			//Argon2d with a single lane is strictly sequential, so the calling thread fills
+			//the cache while the other threads take the page faults of a freshly allocated
+			//cache and generate (and compile) the key-dependent SuperscalarHash programs.
+			if (!cache->isInitialized() && threadCount > 1) {
+				constexpr size_t pageSize = 4096;
+				const size_t pages = CacheSize / pageSize;
+				const size_t pagesPerThread = (pages + threadCount - 1) / threadCount;
+				size_t first = 0;
+				for (; first + pagesPerThread < pages; first += pagesPerThread) {
+					workers.emplace_back(&touchCacheMemory, cache->memory + first * pageSize, pagesPerThread * pageSize);
+				}
+				touchCacheMemory(cache->memory + first * pageSize, (pages - first) * pageSize);
+				for (auto& worker : workers) {
+					worker.join();
+				}
+				workers.clear();
+			}
+			workers.emplace_back([cache, key, keySize]() {
+				generateCachePrograms(cache, key, keySize);
+				if (cache->jit != nullptr) {
+					compileCachePrograms(cache);
+				}
+			});
+		}
+		catch (std::exception&) {
+			for (auto& worker : workers) {
+				worker.join();
+			}
+			cache->initialize(cache, key, keySize);
+			return;
+		}
+		fillCache(cache, key, keySize);
+		workers[0].join();
+	}
+
+	static const char datasetFileMagic[8] = { 'R', 'X', 'D', 'A', 'T', 'A', 'S', 'T' };
+
+	static void getConfigurationHash(uint8_t (&out)[32]) {
+		//all parameters that affect the contents of the dataset
+		const uint64_t configuration[] = {
+			DatasetFileVersion,
+			RANDOMX_ARGON_MEMORY,
+			RANDOMX_ARGON_ITERATIONS,
+			RANDOMX_ARGON_LANES,
+			RANDOMX_CACHE_ACCESSES,
+			RANDOMX_SUPERSCALAR_LATENCY,
+			RANDOMX_DATASET_BASE_SIZE,
+			RANDOMX_DATASET_EXTRA_SIZE,
+		};
+		blake2b_state state;
+		blake2b_init(&state, sizeof(out));
+		blake2b_update(&state, configuration, sizeof(configuration));
+		blake2b_update(&state, RANDOMX_ARGON_SALT, ArgonSaltSize);
+		blake2b_final(&state, out, sizeof(out));
+	}
+
+	uint64_t getDatasetChecksum(const uint8_t* dataset) {
+		//Fletcher-style sums over 4 independent lanes; detects truncated or corrupted files at memory speed
+		uint64_t sum1[4] = { 0 }, sum2[4] = { 0 };
+		for (uint64_t offset = 0; offset < DatasetSize; offset += 4 * sizeof(uint64_t)) {
+			for (unsigned i = 0; i < 4; ++i) {
+				sum1[i] += load64_native(dataset + offset + i * sizeof(uint64_t));
+				sum2[i] += sum1[i];
+			}
+		}
+		uint64_t checksum = 0;
+		for (unsigned i = 0; i < 4; ++i) {
+			checksum = rotl(checksum, 23) ^ sum1[i];
+			checksum = rotl(checksum, 23) ^ sum2[i];
+		}
+		return checksum;
+	}
+
+	void initDatasetFileHeader(DatasetFileHeader& header, const void* seed, size_t seedSize, const uint8_t* dataset) {
+		memset(&header, 0, sizeof(header));
+		memcpy(header.magic, datasetFileMagic, sizeof(header.magic));
+		header.version = DatasetFileVersion;
+		header.headerSize = DatasetFileHeaderSize;
+		header.datasetSize = DatasetSize;
+		getConfigurationHash(header.configHash);
+		blake2b(header.seedHash, sizeof(header.seedHash), seed, seedSize, nullptr, 0);
+		header.checksum = getDatasetChecksum(dataset);
+	}
+
+	bool checkDatasetFileHeader(const DatasetFileHeader& header, const void* seed, size_t seedSize) {
+		uint8_t configHash[32], seedHash[32];
+		getConfigurationHash(configHash);
+		blake2b(seedHash, sizeof(seedHash), seed, seedSize, nullptr, 0);
+		return memcmp(header.magic, datasetFileMagic, sizeof(header.magic)) == 0
+			&& header.version == DatasetFileVersion
+			&& header.headerSize == DatasetFileHeaderSize
+			&& header.datasetSize == DatasetSize
+			&& memcmp(header.configHash, configHash, sizeof(configHash)) == 0
+			&& memcmp(header.seedHash, seedHash, sizeof(seedHash)) == 0;
+	}
+
+	void deallocMappedDataset(randomx_dataset* dataset) {
+		if (dataset->memory != nullptr)
+			freeMappedFileMemory(dataset->memory - DatasetFileHeaderSize, DatasetFileHeaderSize + DatasetSize);
+	}
 
 	static inline uint8_t* getMixBlock(uint64_t registerValue, uint8_t *memory) {
 		constexpr uint32_t mask = CacheSize / CacheLineSize - 1;
@@ -193,4 +311,19 @@ namespace randomx {
 		for (uint32_t itemNumber = startItem; itemNumber < endItem; ++itemNumber, dataset += CacheLineSize)
 			initDatasetItem(cache, dataset, itemNumber);
 	}
+
+	DatasetInitFunc* selectDatasetInitImpl() {
+		static DatasetInitFunc* impl = []() {
+			Cpu cpu;
+			DatasetInitFunc* simd = nullptr;
+			if (cpu.hasAvx512() && (simd = datasetInitAvx512()) != nullptr)
+				return simd;
+			if (cpu.hasAvx2() && (simd = datasetInitAvx2()) != nullptr)
+				return simd;
+			if ((simd = datasetInitNeon()) != nullptr)
+				return simd;
+			return &initDataset;
+		}();
+		return impl;
+	}
 }
@@ -35,6 +35,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "superscalar_program.hpp"
 #include "allocator.hpp"
 #include "argon2.h"
+#include "dataset_memo.hpp"
 
 /* Global scope for C binding */
 struct randomx_dataset {
@@ -53,6 +54,7 @@ struct randomx_cache {
 	std::vector<uint64_t> reciprocalCache;
 	std::string cacheKey;
 	randomx_argon2_impl* argonImpl;
+	randomx::DatasetItemMemo* itemMemo = nullptr;
 
 	bool isInitialized() {
 		return programs[0].getSize() != 0;
@@ -86,10 +88,42 @@ namespace randomx {
 	template<class Allocator>
 	void deallocCache(randomx_cache* cache);
 
+	constexpr uint32_t DatasetFileVersion = 1;
+	constexpr size_t DatasetFileHeaderSize = 65536; //keeps the dataset aligned to the allocation granularity of all platforms
+
+	struct DatasetFileHeader {
+		char magic[8];
+		uint32_t version;
+		uint32_t headerSize;
+		uint64_t datasetSize;
+		uint8_t configHash[32];
+		uint8_t seedHash[32];
+		uint64_t checksum;
+	};
+
+	void initDatasetFileHeader(DatasetFileHeader& header, const void* seed, size_t seedSize, const uint8_t* dataset);
+	bool checkDatasetFileHeader(const DatasetFileHeader& header, const void* seed, size_t seedSize);
+	uint64_t getDatasetChecksum(const uint8_t* dataset);
+	void deallocMappedDataset(randomx_dataset* dataset);
+
+	constexpr uint64_t superscalarMul0 = 6364136223846793005ULL;
+	constexpr uint64_t superscalarAdd1 = 9298411001130361340ULL;
+	constexpr uint64_t superscalarAdd2 = 12065312585734608966ULL;
+	constexpr uint64_t superscalarAdd3 = 9306329213124626780ULL;
+	constexpr uint64_t superscalarAdd4 = 5281919268842080866ULL;
+	constexpr uint64_t superscalarAdd5 = 10536153434571861004ULL;
+	constexpr uint64_t superscalarAdd6 = 3398623926847679864ULL;
+	constexpr uint64_t superscalarAdd7 = 9549104520008361294ULL;
+
 	void initCache(randomx_cache*, const void*, size_t);
 	void initCacheCompile(randomx_cache*, const void*, size_t);
+	void initCacheParallel(randomx_cache*, const void*, size_t, unsigned);
 	void initDatasetItem(randomx_cache* cache, uint8_t* out, uint64_t blockNumber);
 	void initDataset(randomx_cache* cache, uint8_t* dataset, uint32_t startBlock, uint32_t endBlock);
+	DatasetInitFunc* datasetInitAvx2();
+	DatasetInitFunc* datasetInitAvx512();
+	DatasetInitFunc* datasetInitNeon();
+	DatasetInitFunc* selectDatasetInitImpl();
 
 	inline randomx_argon2_impl* selectArgonImpl(randomx_flags flags) {
 		if (flags & RANDOMX_FLAG_ARGON2_AVX2) {
@@ -98,6 +132,9 @@ namespace randomx {
 		if (flags & RANDOMX_FLAG_ARGON2_SSSE3) {
 			return randomx_argon2_impl_ssse3();
 		}
+		if (flags & RANDOMX_FLAG_ARGON2_NEON) {
+			return randomx_argon2_impl_neon();
+		}
 		return &randomx_argon2_fill_segment_ref;
 	}
 }
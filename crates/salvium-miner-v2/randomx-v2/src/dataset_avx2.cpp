@@ -0,0 +1,113 @@
+/*
+Copyright (c) 2026, The Salvium Project
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in the
+	  documentation and/or other materials provided with the distribution.
+	* Neither the name of the copyright holder nor the
+	  names of its contributors may be used to endorse or promote products
+	  derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "dataset.hpp"
+
+#if defined(__AVX2__)
+
+#include <immintrin.h>
+#include "dataset_simd.hpp"
+
+namespace randomx {
+
+	//AVX2 has no 64-bit multiplication, products are assembled from 32x32-bit partial products.
+	struct Avx2Simd {
+		using Vector = __m256i;
+		static constexpr unsigned Lanes = 4;
+
+		static Vector set1(uint64_t x) {
+			return _mm256_set1_epi64x((long long)x);
+		}
+		static Vector load(const uint64_t* p) {
+			return _mm256_load_si256((const __m256i*)p);
+		}
+		static void store(uint64_t* p, Vector x) {
+			_mm256_store_si256((__m256i*)p, x);
+		}
+		static Vector add(Vector a, Vector b) {
+			return _mm256_add_epi64(a, b);
+		}
+		static Vector sub(Vector a, Vector b) {
+			return _mm256_sub_epi64(a, b);
+		}
+		static Vector xor_(Vector a, Vector b) {
+			return _mm256_xor_si256(a, b);
+		}
+		static Vector and_(Vector a, Vector b) {
+			return _mm256_and_si256(a, b);
+		}
+		static Vector shl(Vector x, unsigned count) {
+			return _mm256_sll_epi64(x, _mm_cvtsi32_si128(count));
+		}
+		static Vector rotr(Vector x, unsigned count) {
+			return _mm256_or_si256(_mm256_srl_epi64(x, _mm_cvtsi32_si128(count)), _mm256_sll_epi64(x, _mm_cvtsi32_si128(64 - count)));
+		}
+		static Vector mul(Vector a, Vector b) {
+			Vector lo = _mm256_mul_epu32(a, b);
+			Vector cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b), _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+			return _mm256_add_epi64(lo, _mm256_slli_epi64(cross, 32));
+		}
+		static Vector mulh(Vector a, Vector b) {
+			const Vector lo32 = _mm256_set1_epi64x(0xffffffff);
+			Vector ah = _mm256_srli_epi64(a, 32);
+			Vector bh = _mm256_srli_epi64(b, 32);
+			Vector ll = _mm256_mul_epu32(a, b);
+			Vector lh = _mm256_mul_epu32(a, bh);
+			Vector hl = _mm256_mul_epu32(ah, b);
+			Vector hh = _mm256_mul_epu32(ah, bh);
+			Vector t = _mm256_add_epi64(hl, _mm256_srli_epi64(ll, 32));
+			Vector w = _mm256_add_epi64(_mm256_and_si256(t, lo32), lh);
+			return _mm256_add_epi64(_mm256_add_epi64(hh, _mm256_srli_epi64(t, 32)), _mm256_srli_epi64(w, 32));
+		}
+		static Vector smulh(Vector a, Vector b) {
+			const Vector zero = _mm256_setzero_si256();
+			Vector h = mulh(a, b);
+			h = _mm256_sub_epi64(h, _mm256_and_si256(_mm256_cmpgt_epi64(zero, a), b));
+			return _mm256_sub_epi64(h, _mm256_and_si256(_mm256_cmpgt_epi64(zero, b), a));
+		}
+		static Vector gather(const uint8_t* base, const uint64_t* offsets) {
+			return _mm256_i64gather_epi64((const long long*)base, load(offsets), 1);
+		}
+	};
+
+	DatasetInitFunc* datasetInitAvx2() {
+		return &initDatasetSimd<Avx2Simd>;
+	}
+}
+
+#else
+
+namespace randomx {
+
+	DatasetInitFunc* datasetInitAvx2() {
+		return nullptr;
+	}
+}
+
+#endif
@@ -0,0 +1,122 @@
+/*
+Copyright (c) 2026, The Salvium Project
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in the
+	  documentation and/or other materials provided with the distribution.
+	* Neither the name of the copyright holder nor the
+	  names of its contributors may be used to endorse or promote products
+	  derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "dataset.hpp"
+
+#if defined(__AVX512F__) && defined(__AVX512DQ__)
+
+#include <immintrin.h>
+#include "dataset_simd.hpp"
+
+namespace randomx {
+
+	struct Avx512Simd {
+		using Vector = __m512i;
+		static constexpr unsigned Lanes = 8;
+
+		static Vector set1(uint64_t x) {
+			return _mm512_set1_epi64((long long)x);
+		}
+		static Vector load(const uint64_t* p) {
+			return _mm512_load_si512(p);
+		}
+		static void store(uint64_t* p, Vector x) {
+			_mm512_store_si512(p, x);
+		}
+		static Vector add(Vector a, Vector b) {
+			return _mm512_add_epi64(a, b);
+		}
+		static Vector sub(Vector a, Vector b) {
+			return _mm512_sub_epi64(a, b);
+		}
+		static Vector xor_(Vector a, Vector b) {
+			return _mm512_xor_si512(a, b);
+		}
+		static Vector and_(Vector a, Vector b) {
+			return _mm512_and_si512(a, b);
+		}
+		//GCC implements the unmasked forms of these intrinsics by merging into
+		//_mm512_undefined_epi32(), which -Wextra reports as maybe-uninitialized.
+		//A zero source with a full mask compiles to the same instructions.
+		static Vector shl(Vector x, unsigned count) {
+			return _mm512_mask_sll_epi64(_mm512_setzero_si512(), 0xff, x, _mm_cvtsi32_si128(count));
+		}
+		static Vector rotr(Vector x, unsigned count) {
+			return _mm512_mask_rorv_epi64(_mm512_setzero_si512(), 0xff, x, _mm512_set1_epi64(count));
+		}
+		static Vector mul(Vector a, Vector b) {
+			return _mm512_mullo_epi64(a, b);
+		}
+		static Vector mulh(Vector a, Vector b) {
+			const Vector lo32 = _mm512_set1_epi64(0xffffffff);
+			Vector ah = hi32(a);
+			Vector bh = hi32(b);
+			Vector ll = mul32(a, b);
+			Vector lh = mul32(a, bh);
+			Vector hl = mul32(ah, b);
+			Vector hh = mul32(ah, bh);
+			Vector t = _mm512_add_epi64(hl, hi32(ll));
+			Vector w = _mm512_add_epi64(_mm512_and_si512(t, lo32), lh);
+			return _mm512_add_epi64(_mm512_add_epi64(hh, hi32(t)), hi32(w));
+		}
+		static Vector smulh(Vector a, Vector b) {
+			Vector h = mulh(a, b);
+			h = _mm512_sub_epi64(h, _mm512_and_si512(sign(a), b));
+			return _mm512_sub_epi64(h, _mm512_and_si512(sign(b), a));
+		}
+		static Vector gather(const uint8_t* base, const uint64_t* offsets) {
+			return _mm512_mask_i64gather_epi64(_mm512_setzero_si512(), 0xff, load(offsets), base, 1);
+		}
+	private:
+		static Vector hi32(Vector x) {
+			return _mm512_mask_srli_epi64(_mm512_setzero_si512(), 0xff, x, 32);
+		}
+		static Vector mul32(Vector a, Vector b) {
+			return _mm512_mask_mul_epu32(_mm512_setzero_si512(), 0xff, a, b);
+		}
+		static Vector sign(Vector x) {
+			return _mm512_mask_srai_epi64(_mm512_setzero_si512(), 0xff, x, 63);
+		}
+	};
+
+	DatasetInitFunc* datasetInitAvx512() {
+		return &initDatasetSimd<Avx512Simd>;
+	}
+}
+
+#else
+
+namespace randomx {
+
+	DatasetInitFunc* datasetInitAvx512() {
+		return nullptr;
+	}
+}
+
+#endif
@@ -0,0 +1,139 @@
+/*
+Copyright (c) 2026, The Salvium Project
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in the
+	  documentation and/or other materials provided with the distribution.
+	* Neither the name of the copyright holder nor the
+	  names of its contributors may be used to endorse or promote products
+	  derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include <new>
+#include "dataset_memo.hpp"
+
+namespace randomx {
+
+	constexpr uint64_t DatasetItemMemo::EmptySlot;
+	constexpr uint64_t DatasetItemMemo::VersionOne;
+	constexpr size_t DatasetItemMemo::SlotSize;
+	constexpr unsigned DatasetItemMemo::StatsShards;
+
+	static std::atomic<unsigned> nextStatsShard(0);
+
+	ItemMemoCounters::ItemMemoCounters() : shard(nextStatsShard.fetch_add(1, std::memory_order_relaxed)) {
+	}
+
+	DatasetItemMemo* DatasetItemMemo::create(size_t slotCount) {
+		if (slotCount < 8 || slotCount > (1ULL << 32) || (slotCount & (slotCount - 1)) != 0)
+			return nullptr;
+		void* memory;
+		try {
+			memory = AlignedAllocator<CacheLineSize>::allocMemory(slotCount * SlotSize);
+		}
+		catch (std::bad_alloc&) {
+			return nullptr;
+		}
+		try {
+			return new DatasetItemMemo(slotCount, memory);
+		}
+		catch (std::bad_alloc&) {
+			AlignedAllocator<CacheLineSize>::freeMemory(memory, slotCount * SlotSize);
+			return nullptr;
+		}
+	}
+
+	//The memory holds slotCount headers followed by slotCount items. slotCount is
+	//at least 8, so the items are aligned to a cache line.
+	DatasetItemMemo::DatasetItemMemo(size_t slotCount, void* memory) : memory(memory), slotMask((uint32_t)(slotCount - 1)) {
+		headers = (std::atomic<uint64_t>*)memory;
+		items = headers + slotCount;
+		for (size_t i = 0; i < slotCount; ++i) {
+			new (&headers[i]) std::atomic<uint64_t>(EmptySlot);
+		}
+		for (size_t i = 0; i < slotCount * 8; ++i) {
+			new (&items[i]) std::atomic<uint64_t>(0);
+		}
+		resetStats();
+	}
+
+	DatasetItemMemo::~DatasetItemMemo() {
+		AlignedAllocator<CacheLineSize>::freeMemory(memory, getSlotCount() * SlotSize);
+	}
+
+	bool DatasetItemMemo::lookup(uint32_t itemNumber, uint64_t* out) {
+		uint32_t slot = itemNumber & slotMask;
+		uint64_t header = headers[slot].load(std::memory_order_acquire);
+		if ((header & VersionOne) || (uint32_t)header != itemNumber)
+			return false;
+		std::atomic<uint64_t>* item = items + 8 * slot;
+		for (unsigned i = 0; i < 8; ++i) {
+			out[i] = item[i].load(std::memory_order_relaxed);
+		}
+		std::atomic_thread_fence(std::memory_order_acquire);
+		return headers[slot].load(std::memory_order_relaxed) == header;
+	}
+
+	void DatasetItemMemo::store(uint32_t itemNumber, const uint64_t* out) {
+		uint32_t slot = itemNumber & slotMask;
+		uint64_t header = headers[slot].load(std::memory_order_relaxed);
+		if (header & VersionOne)
+			return;
+		uint64_t writing = ((header & ~(uint64_t)0xFFFFFFFF) + VersionOne) | itemNumber;
+		if (!headers[slot].compare_exchange_strong(header, writing, std::memory_order_acquire))
+			return;
+		//the odd header must be visible before any of the item words
+		std::atomic_thread_fence(std::memory_order_release);
+		std::atomic<uint64_t>* item = items + 8 * slot;
+		for (unsigned i = 0; i < 8; ++i) {
+			item[i].store(out[i], std::memory_order_relaxed);
+		}
+		headers[slot].store(writing + VersionOne, std::memory_order_release);
+	}
+
+	//Must not be called while VMs are using the memo.
+	void DatasetItemMemo::clear() {
+		for (size_t i = 0; i < getSlotCount(); ++i) {
+			headers[i].store(EmptySlot, std::memory_order_relaxed);
+		}
+	}
+
+	void DatasetItemMemo::addStats(unsigned shard, uint64_t hits, uint64_t misses) {
+		StatsShard& s = stats[shard % StatsShards];
+		s.hits.fetch_add(hits, std::memory_order_relaxed);
+		s.misses.fetch_add(misses, std::memory_order_relaxed);
+	}
+
+	void DatasetItemMemo::getStats(uint64_t& hits, uint64_t& misses) const {
+		hits = misses = 0;
+		for (unsigned i = 0; i < StatsShards; ++i) {
+			hits += stats[i].hits.load(std::memory_order_relaxed);
+			misses += stats[i].misses.load(std::memory_order_relaxed);
+		}
+	}
+
+	void DatasetItemMemo::resetStats() {
+		for (unsigned i = 0; i < StatsShards; ++i) {
+			stats[i].hits.store(0, std::memory_order_relaxed);
+			stats[i].misses.store(0, std::memory_order_relaxed);
+		}
+	}
+}
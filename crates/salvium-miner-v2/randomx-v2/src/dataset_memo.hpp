@@ -0,0 +1,120 @@
+/*
+Copyright (c) 2026, The Salvium Project
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in the
+	  documentation and/or other materials provided with the distribution.
+	* Neither the name of the copyright holder nor the
+	  names of its contributors may be used to endorse or promote products
+	  derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include "common.hpp"
+#include "allocator.hpp"
+
+namespace randomx {
+
+	//Bounded memo of computed Dataset items for light-mode VMs.
+	//Slots are direct-mapped by item number. Each slot is guarded by a 64-bit header
+	//that holds the item number in the low half and a version in the high half; the
+	//version is odd while the slot is being written. Readers never block and a writer
+	//skips the slot if another writer holds it, so the memo is lock-free.
+	//The JIT compiler accesses the headers and items directly (see JitCompilerX86::genReadDatasetLightMemo).
+	class DatasetItemMemo {
+	public:
+		static constexpr uint64_t EmptySlot = 0xFFFFFFFF;
+		static constexpr uint64_t VersionOne = 1ULL << 32;
+		static constexpr size_t SlotSize = sizeof(uint64_t) + CacheLineSize;
+		static constexpr unsigned StatsShards = 16;
+
+		//Returns nullptr if slotCount is not a power of 2 or allocation fails.
+		static DatasetItemMemo* create(size_t slotCount);
+		~DatasetItemMemo();
+		DatasetItemMemo(const DatasetItemMemo&) = delete;
+		DatasetItemMemo& operator=(const DatasetItemMemo&) = delete;
+
+		bool lookup(uint32_t itemNumber, uint64_t* out);
+		void store(uint32_t itemNumber, const uint64_t* item);
+		void clear();
+		void addStats(unsigned shard, uint64_t hits, uint64_t misses);
+		void getStats(uint64_t& hits, uint64_t& misses) const;
+		void resetStats();
+
+		size_t getSlotCount() const {
+			return slotMask + 1;
+		}
+		uint32_t getSlotMask() const {
+			return slotMask;
+		}
+		std::atomic<uint64_t>* getHeaders() {
+			return headers;
+		}
+		std::atomic<uint64_t>* getItems() {
+			return items;
+		}
+	private:
+		void* operator new(size_t size) {
+			void* ptr = AlignedAllocator<CacheLineSize>::allocMemory(size);
+			if (ptr == nullptr)
+				throw std::bad_alloc();
+			return ptr;
+		}
+	public:
+		void operator delete(void* ptr) {
+			AlignedAllocator<CacheLineSize>::freeMemory(ptr, sizeof(DatasetItemMemo));
+		}
+	private:
+		struct alignas(CacheLineSize) StatsShard {
+			std::atomic<uint64_t> hits;
+			std::atomic<uint64_t> misses;
+		};
+
+		DatasetItemMemo(size_t slotCount, void* memory);
+
+		StatsShard stats[StatsShards];
+		void* memory;
+		std::atomic<uint64_t>* headers;
+		std::atomic<uint64_t>* items;
+		uint32_t slotMask;
+	};
+
+	//Per-VM memo counters. Kept local so the lookup path doesn't touch shared
+	//cache lines; flushed into the memo after each program.
+	struct ItemMemoCounters {
+		ItemMemoCounters();
+		void flush(DatasetItemMemo* memo) {
+			if (memo != nullptr && (hits | misses) != 0) {
+				memo->addStats(shard, hits, misses);
+			}
+			hits = misses = 0;
+		}
+
+		uint64_t hits = 0;
+		uint64_t misses = 0;
+		unsigned shard;
+	};
+}
@@ -0,0 +1,105 @@
+/*
+Copyright (c) 2026, The Salvium Project
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in the
+	  documentation and/or other materials provided with the distribution.
+	* Neither the name of the copyright holder nor the
+	  names of its contributors may be used to endorse or promote products
+	  derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "dataset.hpp"
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+
+#include <arm_neon.h>
+#include "dataset_simd.hpp"
+
+namespace randomx {
+
+	//A64 has no 64-bit vector multiplication, but the scalar mul/umulh/smulh are single instructions.
+	struct NeonSimd {
+		using Vector = uint64x2_t;
+		static constexpr unsigned Lanes = 2;
+
+		static Vector set1(uint64_t x) {
+			return vdupq_n_u64(x);
+		}
+		static Vector load(const uint64_t* p) {
+			return vld1q_u64(p);
+		}
+		static void store(uint64_t* p, Vector x) {
+			vst1q_u64(p, x);
+		}
+		static Vector add(Vector a, Vector b) {
+			return vaddq_u64(a, b);
+		}
+		static Vector sub(Vector a, Vector b) {
+			return vsubq_u64(a, b);
+		}
+		static Vector xor_(Vector a, Vector b) {
+			return veorq_u64(a, b);
+		}
+		static Vector and_(Vector a, Vector b) {
+			return vandq_u64(a, b);
+		}
+		static Vector shl(Vector x, unsigned count) {
+			return vshlq_u64(x, vdupq_n_s64(count));
+		}
+		static Vector rotr(Vector x, unsigned count) {
+			return vorrq_u64(vshlq_u64(x, vdupq_n_s64(-(int64_t)count)), vshlq_u64(x, vdupq_n_s64(64 - count)));
+		}
+		static Vector mul(Vector a, Vector b) {
+			uint64_t lo = vgetq_lane_u64(a, 0) * vgetq_lane_u64(b, 0);
+			uint64_t hi = vgetq_lane_u64(a, 1) * vgetq_lane_u64(b, 1);
+			return vcombine_u64(vcreate_u64(lo), vcreate_u64(hi));
+		}
+		static Vector mulh(Vector a, Vector b) {
+			uint64_t lo = ::mulh(vgetq_lane_u64(a, 0), vgetq_lane_u64(b, 0));
+			uint64_t hi = ::mulh(vgetq_lane_u64(a, 1), vgetq_lane_u64(b, 1));
+			return vcombine_u64(vcreate_u64(lo), vcreate_u64(hi));
+		}
+		static Vector smulh(Vector a, Vector b) {
+			uint64_t lo = ::smulh((int64_t)vgetq_lane_u64(a, 0), (int64_t)vgetq_lane_u64(b, 0));
+			uint64_t hi = ::smulh((int64_t)vgetq_lane_u64(a, 1), (int64_t)vgetq_lane_u64(b, 1));
+			return vcombine_u64(vcreate_u64(lo), vcreate_u64(hi));
+		}
+		static Vector gather(const uint8_t* base, const uint64_t* offsets) {
+			return vcombine_u64(vld1_u64((const uint64_t*)(base + offsets[0])), vld1_u64((const uint64_t*)(base + offsets[1])));
+		}
+	};
+
+	DatasetInitFunc* datasetInitNeon() {
+		return &initDatasetSimd<NeonSimd>;
+	}
+}
+
+#else
+
+namespace randomx {
+
+	DatasetInitFunc* datasetInitNeon() {
+		return nullptr;
+	}
+}
+
+#endif
@@ -0,0 +1,147 @@
+/*
+Copyright (c) 2026, The Salvium Project
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in the
+	  documentation and/or other materials provided with the distribution.
+	* Neither the name of the copyright holder nor the
+	  names of its contributors may be used to endorse or promote products
+	  derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include "common.hpp"
+#include "dataset.hpp"
+#include "superscalar.hpp"
+#include "intrin_portable.h"
+
+/*
+	Dataset initialization of Simd::Lanes consecutive items at once. Item k of
+	a group lives in lane k of each of the 8 vector registers. All lanes run the
+	same superscalar programs, so only the mix block addresses differ per lane.
+
+	A Simd backend provides:
+		Vector
+		Lanes
+		set1(uint64_t), load(const uint64_t*), store(uint64_t*, Vector)
+		add, sub, xor_, and_, shl(Vector, unsigned), rotr(Vector, unsigned)
+		mul, mulh, smulh (low, unsigned high and signed high 64 bits of the product)
+		gather(const uint8_t* base, const uint64_t* offsets)
+*/
+
+namespace randomx {
+
+	template<class Simd>
+	void executeSuperscalarSimd(typename Simd::Vector(&r)[8], SuperscalarProgram& prog, const std::vector<uint64_t>& reciprocals) {
+		for (unsigned j = 0; j < prog.getSize(); ++j) {
+			Instruction& instr = prog(j);
+			switch ((SuperscalarInstructionType)instr.opcode)
+			{
+			case SuperscalarInstructionType::ISUB_R:
+				r[instr.dst] = Simd::sub(r[instr.dst], r[instr.src]);
+				break;
+			case SuperscalarInstructionType::IXOR_R:
+				r[instr.dst] = Simd::xor_(r[instr.dst], r[instr.src]);
+				break;
+			case SuperscalarInstructionType::IADD_RS:
+				r[instr.dst] = Simd::add(r[instr.dst], Simd::shl(r[instr.src], instr.getModShift()));
+				break;
+			case SuperscalarInstructionType::IMUL_R:
+				r[instr.dst] = Simd::mul(r[instr.dst], r[instr.src]);
+				break;
+			case SuperscalarInstructionType::IROR_C:
+				r[instr.dst] = Simd::rotr(r[instr.dst], instr.getImm32() & 63);
+				break;
+			case SuperscalarInstructionType::IADD_C7:
+			case SuperscalarInstructionType::IADD_C8:
+			case SuperscalarInstructionType::IADD_C9:
+				r[instr.dst] = Simd::add(r[instr.dst], Simd::set1(signExtend2sCompl(instr.getImm32())));
+				break;
+			case SuperscalarInstructionType::IXOR_C7:
+			case SuperscalarInstructionType::IXOR_C8:
+			case SuperscalarInstructionType::IXOR_C9:
+				r[instr.dst] = Simd::xor_(r[instr.dst], Simd::set1(signExtend2sCompl(instr.getImm32())));
+				break;
+			case SuperscalarInstructionType::IMULH_R:
+				r[instr.dst] = Simd::mulh(r[instr.dst], r[instr.src]);
+				break;
+			case SuperscalarInstructionType::ISMULH_R:
+				r[instr.dst] = Simd::smulh(r[instr.dst], r[instr.src]);
+				break;
+			case SuperscalarInstructionType::IMUL_RCP:
+				r[instr.dst] = Simd::mul(r[instr.dst], Simd::set1(reciprocals[instr.getImm32()]));
+				break;
+			default:
+				UNREACHABLE;
+			}
+		}
+	}
+
+	template<class Simd>
+	void initDatasetSimd(randomx_cache* cache, uint8_t* dataset, uint32_t startItem, uint32_t endItem) {
+		using Vector = typename Simd::Vector;
+		constexpr unsigned lanes = Simd::Lanes;
+		constexpr uint64_t mask = CacheSize / CacheLineSize - 1;
+		alignas(64) uint64_t laneValues[lanes];
+		alignas(64) uint64_t offsets[lanes];
+		alignas(64) uint64_t items[8][lanes];
+		uint32_t itemNumber = startItem;
+		for (; endItem - itemNumber >= lanes; itemNumber += lanes, dataset += lanes * CacheLineSize) {
+			Vector rl[8];
+			for (unsigned k = 0; k < lanes; ++k)
+				laneValues[k] = itemNumber + k;
+			Vector registerValue = Simd::load(laneValues);
+			rl[0] = Simd::mul(Simd::add(registerValue, Simd::set1(1)), Simd::set1(superscalarMul0));
+			rl[1] = Simd::xor_(rl[0], Simd::set1(superscalarAdd1));
+			rl[2] = Simd::xor_(rl[0], Simd::set1(superscalarAdd2));
+			rl[3] = Simd::xor_(rl[0], Simd::set1(superscalarAdd3));
+			rl[4] = Simd::xor_(rl[0], Simd::set1(superscalarAdd4));
+			rl[5] = Simd::xor_(rl[0], Simd::set1(superscalarAdd5));
+			rl[6] = Simd::xor_(rl[0], Simd::set1(superscalarAdd6));
+			rl[7] = Simd::xor_(rl[0], Simd::set1(superscalarAdd7));
+			for (unsigned i = 0; i < RANDOMX_CACHE_ACCESSES; ++i) {
+				Simd::store(laneValues, registerValue);
+				for (unsigned k = 0; k < lanes; ++k) {
+					offsets[k] = (laneValues[k] & mask) * CacheLineSize;
+					rx_prefetch_nta(cache->memory + offsets[k]);
+				}
+				SuperscalarProgram& prog = cache->programs[i];
+
+				executeSuperscalarSimd<Simd>(rl, prog, cache->reciprocalCache);
+
+				for (unsigned q = 0; q < 8; ++q)
+					rl[q] = Simd::xor_(rl[q], Simd::gather(cache->memory + 8 * q, offsets));
+
+				registerValue = rl[prog.getAddressRegister()];
+			}
+			for (unsigned q = 0; q < 8; ++q)
+				Simd::store(items[q], rl[q]);
+			for (unsigned k = 0; k < lanes; ++k)
+				for (unsigned q = 0; q < 8; ++q)
+					memcpy(dataset + k * CacheLineSize + 8 * q, &items[q][k], sizeof(uint64_t));
+		}
+		if (itemNumber < endItem)
+			initDataset(cache, dataset, itemNumber, endItem);
+	}
+}
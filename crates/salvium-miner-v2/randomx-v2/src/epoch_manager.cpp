@@ -0,0 +1,268 @@
+/*
+Copyright (c) 2026, The Salvium Project
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in the
+	  documentation and/or other materials provided with the distribution.
+	* Neither the name of the copyright holder nor the
+	  names of its contributors may be used to endorse or promote products
+	  derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <vector>
+#include "epoch_manager.hpp"
+
+#if defined(_WIN32) || defined(__CYGWIN__)
+#include <windows.h>
+#elif defined(__linux__)
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace randomx {
+
+	Epoch::~Epoch() {
+		randomx_release_dataset(dataset);
+	}
+
+	static void lowerThreadPriority() {
+#if defined(_WIN32) || defined(__CYGWIN__)
+		SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_IDLE);
+#elif defined(__linux__)
+		//on Linux, the nice value is a per-thread attribute
+		setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid), 19);
+#endif
+	}
+}
+
+randomx_epoch_manager::randomx_epoch_manager(randomx_flags flags, unsigned initThreads) :
+	randomx_epoch_manager(flags, initThreads, randomx_dataset_item_count()) {
+}
+
+randomx_epoch_manager::randomx_epoch_manager(randomx_flags flags, unsigned initThreads, unsigned long itemCount) :
+	flags(flags), initThreads(std::max(initThreads, 1u)), itemCount(itemCount), buildStarted(false), cancelBuild(false), buildWaited(false) {
+}
+
+randomx_epoch_manager::~randomx_epoch_manager() {
+	std::lock_guard<std::mutex> control(controlMutex);
+	cancelBuild = true;
+	finishBuild();
+}
+
+void randomx_epoch_manager::prepare(const std::string& seed) {
+	std::lock_guard<std::mutex> control(controlMutex);
+	{
+		std::lock_guard<std::mutex> lock(stateMutex);
+		if (current && current->seed == seed) {
+			return;
+		}
+	}
+	if (buildStarted && buildSeed == seed) {
+		return;
+	}
+	cancelBuild = true;
+	finishBuild();
+	startBuild(seed, true);
+}
+
+bool randomx_epoch_manager::activate(const std::string& seed) {
+	std::lock_guard<std::mutex> control(controlMutex);
+	{
+		std::lock_guard<std::mutex> lock(stateMutex);
+		if (current && current->seed == seed) {
+			return true;
+		}
+	}
+	if (!buildStarted || buildSeed != seed) {
+		cancelBuild = true;
+		finishBuild();
+		startBuild(seed, false);
+	}
+	finishBuild();
+	randomx::EpochPtr previous;
+	{
+		std::lock_guard<std::mutex> lock(stateMutex);
+		if (!next) {
+			return false;
+		}
+		previous = std::move(current);
+		current = std::move(next);
+	}
+	//previous is released here unless a registered VM still references it
+	return true;
+}
+
+randomx_dataset* randomx_epoch_manager::getDataset() {
+	std::lock_guard<std::mutex> lock(stateMutex);
+	return current ? current->dataset : nullptr;
+}
+
+void randomx_epoch_manager::registerVm(randomx_vm* vm) {
+	std::lock_guard<std::mutex> lock(stateMutex);
+	if (current) {
+		randomx_vm_set_dataset(vm, current->dataset);
+	}
+	vms[vm] = current;
+}
+
+void randomx_epoch_manager::unregisterVm(randomx_vm* vm) {
+	randomx::EpochPtr epoch;
+	{
+		std::lock_guard<std::mutex> lock(stateMutex);
+		auto it = vms.find(vm);
+		if (it == vms.end()) {
+			return;
+		}
+		epoch = std::move(it->second);
+		vms.erase(it);
+	}
+}
+
+bool randomx_epoch_manager::syncVm(randomx_vm* vm) {
+	randomx::EpochPtr epoch;
+	{
+		std::lock_guard<std::mutex> lock(stateMutex);
+		auto it = vms.find(vm);
+		if (it == vms.end() || !current || it->second == current) {
+			return false;
+		}
+		randomx_vm_set_dataset(vm, current->dataset);
+		epoch = std::move(it->second);
+		it->second = current;
+	}
+	//the old dataset (if this was its last user) is released outside of the lock
+	return true;
+}
+
+void randomx_epoch_manager::startBuild(const std::string& seed, bool lowPriority) {
+	cancelBuild = false;
+	buildWaited = false;
+	buildStarted = true;
+	buildSeed = seed;
+	try {
+		builder = std::thread(&randomx_epoch_manager::build, this, seed, lowPriority);
+	}
+	catch (std::exception&) {
+		build(seed, false);
+	}
+}
+
+void randomx_epoch_manager::finishBuild() {
+	{
+		std::lock_guard<std::mutex> lock(buildMutex);
+		buildWaited = true;
+	}
+	buildWake.notify_all();
+	if (builder.joinable()) {
+		builder.join();
+	}
+	if (cancelBuild) {
+		std::lock_guard<std::mutex> lock(stateMutex);
+		next.reset();
+	}
+	buildStarted = false;
+	buildSeed.clear();
+}
+
+void randomx_epoch_manager::initDatasetItems(randomx_dataset* dataset, randomx_cache* cache, std::atomic<unsigned long>* nextItem, bool lowPriority) {
+	constexpr unsigned long chunkSize = 4096;
+	if (lowPriority) {
+		randomx::lowerThreadPriority();
+	}
+	while (!cancelBuild.load(std::memory_order_relaxed)) {
+		unsigned long startItem = nextItem->fetch_add(chunkSize);
+		if (startItem >= itemCount) {
+			break;
+		}
+		randomx_init_dataset(dataset, cache, startItem, std::min(chunkSize, itemCount - startItem));
+	}
+	if (lowPriority) {
+		//wake up the builder thread if it is waiting for the last items
+		{
+			std::lock_guard<std::mutex> lock(buildMutex);
+		}
+		buildWake.notify_all();
+	}
+}
+
+void randomx_epoch_manager::build(std::string seed, bool lowPriority) {
+	//The Cache takes a fraction of a second to fill, so it is always initialized at normal
+	//priority. Only the Dataset items of a prepared epoch are left to idle threads.
+	randomx_cache* cache = randomx_alloc_cache(flags);
+	if (cache == nullptr) {
+		return;
+	}
+	randomx_dataset* dataset = randomx_alloc_dataset(flags);
+	if (dataset == nullptr) {
+		randomx_release_cache(cache);
+		return;
+	}
+	randomx_init_cache_parallel(cache, seed.data(), seed.size(), initThreads);
+
+	std::atomic<unsigned long> nextItem(0);
+	std::vector<std::thread> workers;
+	if (lowPriority) {
+		try {
+			for (unsigned i = 0; i < initThreads; ++i) {
+				workers.emplace_back(&randomx_epoch_manager::initDatasetItems, this, dataset, cache, &nextItem, true);
+			}
+		}
+		catch (std::exception&) {
+		}
+		//Idle threads may not run at all while the miners are busy. Once prepare or activate
+		//waits for this build, the remaining items are initialized at normal priority, because
+		//a lowered priority cannot be raised again without privileges.
+		if (!workers.empty()) {
+			std::unique_lock<std::mutex> lock(buildMutex);
+			buildWake.wait(lock, [&]() { return buildWaited || nextItem.load() >= itemCount; });
+		}
+	}
+	if (nextItem.load() < itemCount) {
+		try {
+			for (unsigned i = 0; i < initThreads - 1; ++i) {
+				workers.emplace_back(&randomx_epoch_manager::initDatasetItems, this, dataset, cache, &nextItem, false);
+			}
+		}
+		catch (std::exception&) {
+		}
+		initDatasetItems(dataset, cache, &nextItem, false);
+	}
+	for (auto& worker : workers) {
+		worker.join();
+	}
+	randomx_release_cache(cache);
+
+	if (cancelBuild) {
+		randomx_release_dataset(dataset);
+		return;
+	}
+	randomx::EpochPtr epoch;
+	try {
+		epoch = std::make_shared<randomx::Epoch>(seed, dataset);
+	}
+	catch (std::exception&) {
+		randomx_release_dataset(dataset);
+		return;
+	}
+	std::lock_guard<std::mutex> lock(stateMutex);
+	next = std::move(epoch);
+}
@@ -0,0 +1,91 @@
+/*
+Copyright (c) 2026, The Salvium Project
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in the
+	  documentation and/or other materials provided with the distribution.
+	* Neither the name of the copyright holder nor the
+	  names of its contributors may be used to endorse or promote products
+	  derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "randomx.h"
+
+namespace randomx {
+
+	//A fully initialized dataset for one seed. The dataset is released
+	//when the last reference (manager or VM) is dropped.
+	struct Epoch {
+		Epoch(const std::string& seed, randomx_dataset* dataset) : seed(seed), dataset(dataset) {}
+		~Epoch();
+		Epoch(const Epoch&) = delete;
+		Epoch& operator=(const Epoch&) = delete;
+
+		const std::string seed;
+		randomx_dataset* const dataset;
+	};
+
+	using EpochPtr = std::shared_ptr<Epoch>;
+}
+
+/* Global namespace for C binding */
+class randomx_epoch_manager {
+public:
+	randomx_epoch_manager(randomx_flags flags, unsigned initThreads);
+	//builds only the first itemCount items of each Dataset (used by the tests)
+	randomx_epoch_manager(randomx_flags flags, unsigned initThreads, unsigned long itemCount);
+	~randomx_epoch_manager();
+	void prepare(const std::string& seed);
+	bool activate(const std::string& seed);
+	randomx_dataset* getDataset();
+	void registerVm(randomx_vm* vm);
+	void unregisterVm(randomx_vm* vm);
+	bool syncVm(randomx_vm* vm);
+private:
+	void startBuild(const std::string& seed, bool lowPriority);
+	void finishBuild();
+	void build(std::string seed, bool lowPriority);
+	void initDatasetItems(randomx_dataset* dataset, randomx_cache* cache, std::atomic<unsigned long>* nextItem, bool lowPriority);
+
+	const randomx_flags flags;
+	const unsigned initThreads;
+	const unsigned long itemCount;
+	std::mutex controlMutex; //serializes prepare/activate and ownership of the builder thread
+	std::mutex stateMutex; //protects current, next and vms
+	std::thread builder;
+	bool buildStarted;
+	std::string buildSeed;
+	std::atomic<bool> cancelBuild;
+	std::mutex buildMutex; //protects buildWaited
+	std::condition_variable buildWake;
+	bool buildWaited; //set once prepare/activate waits for the builder thread
+	randomx::EpochPtr current;
+	randomx::EpochPtr next;
+	std::map<randomx_vm*, randomx::EpochPtr> vms;
+};
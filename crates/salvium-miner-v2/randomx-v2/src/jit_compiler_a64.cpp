@@ -95,32 +95,57 @@ JitCompilerA64::JitCompilerA64()
 {
 	if (code == nullptr)
 		throw std::runtime_error("allocMemoryPages");
+	execCode = code;
 	memset(reg_changed_offset, 0, sizeof(reg_changed_offset));
 	memcpy(code, (void*) randomx_program_aarch64, CodeSize);
 
 #ifdef __GNUC__
-	__builtin___clear_cache(reinterpret_cast<char*>(code), reinterpret_cast<char*>(code + CodeSize));
+	__builtin___clear_cache(reinterpret_cast<char*>(execCode), reinterpret_cast<char*>(execCode + CodeSize));
 #endif
 }
 
 JitCompilerA64::~JitCompilerA64()
 {
+	if (execCode != code)
+		freeDualMappedMemory(code, execCode, CodeSize + CalcDatasetItemSize);
+	else
+		freePagedMemory(code, CodeSize + CalcDatasetItemSize);
+}
+
+bool JitCompilerA64::enableDualMapping()
+{
+	if (execCode != code)
+		return true;
+	void* exec;
+	uint8_t* rw = (uint8_t*)allocDualMappedMemory(CodeSize + CalcDatasetItemSize, &exec);
+	if (rw == nullptr)
+		return false;
+	memcpy(rw, code, CodeSize + CalcDatasetItemSize);
 	freePagedMemory(code, CodeSize + CalcDatasetItemSize);
+	code = rw;
+	execCode = (uint8_t*)exec;
+#ifdef __GNUC__
+	__builtin___clear_cache(reinterpret_cast<char*>(execCode), reinterpret_cast<char*>(execCode + CodeSize + CalcDatasetItemSize));
+#endif
+	return true;
 }
 
 void JitCompilerA64::enableWriting()
 {
-	setPagesRW(code, CodeSize + CalcDatasetItemSize);
+	if (execCode == code)
+		setPagesRW(code, CodeSize + CalcDatasetItemSize);
 }
 
 void JitCompilerA64::enableExecution()
 {
-	setPagesRX(code, CodeSize + CalcDatasetItemSize);
+	if (execCode == code)
+		setPagesRX(code, CodeSize + CalcDatasetItemSize);
 }
 
 void JitCompilerA64::enableAll()
 {
-	setPagesRWX(code, CodeSize + CalcDatasetItemSize);
+	if (execCode == code)
+		setPagesRWX(code, CodeSize + CalcDatasetItemSize);
 }
 
 void JitCompilerA64::generateProgram(Program& program, ProgramConfiguration& config)
@@ -170,7 +195,7 @@ void JitCompilerA64::generateProgram(Program& program, ProgramConfiguration& con
 	emit32(ARMV8A::EOR | 10 | (IntRegMap[config.readReg0] << 5) | (IntRegMap[config.readReg1] << 16), code, codePos);
 
 #ifdef __GNUC__
-	__builtin___clear_cache(reinterpret_cast<char*>(code + MainLoopBegin), reinterpret_cast<char*>(code + codePos));
+	__builtin___clear_cache(reinterpret_cast<char*>(execCode + MainLoopBegin), reinterpret_cast<char*>(execCode + codePos));
 #endif
 }
 
@@ -227,7 +252,7 @@ void JitCompilerA64::generateProgramLight(Program& program, ProgramConfiguration
 	emit32(ARMV8A::ADD_IMM_HI | 2 | (2 << 5) | (imm_hi << 10), code, codePos);
 
 #ifdef __GNUC__
-	__builtin___clear_cache(reinterpret_cast<char*>(code + MainLoopBegin), reinterpret_cast<char*>(code + codePos));
+	__builtin___clear_cache(reinterpret_cast<char*>(execCode + MainLoopBegin), reinterpret_cast<char*>(execCode + codePos));
 #endif
 }
 
@@ -345,7 +370,7 @@ void JitCompilerA64::generateSuperscalarHash(SuperscalarProgram(&programs)[N], s
 	codePos += p2 - p1;
 
 #ifdef __GNUC__
-	__builtin___clear_cache(reinterpret_cast<char*>(code + CodeSize), reinterpret_cast<char*>(code + codePos));
+	__builtin___clear_cache(reinterpret_cast<char*>(execCode + CodeSize), reinterpret_cast<char*>(execCode + codePos));
 #endif
 }
 
@@ -353,7 +378,7 @@ template void JitCompilerA64::generateSuperscalarHash(SuperscalarProgram(&progra
 
 DatasetInitFunc* JitCompilerA64::getDatasetInitFunc()
 {
-	return (DatasetInitFunc*)(code + (((uint8_t*)randomx_init_dataset_aarch64) - ((uint8_t*)randomx_program_aarch64)));
+	return (DatasetInitFunc*)(execCode + (((uint8_t*)randomx_init_dataset_aarch64) - ((uint8_t*)randomx_program_aarch64)));
 }
 
 size_t JitCompilerA64::getCodeSize()
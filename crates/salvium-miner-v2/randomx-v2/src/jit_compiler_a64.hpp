@@ -41,6 +41,8 @@ namespace randomx {
 	struct ProgramConfiguration;
 	class SuperscalarProgram;
 	class Instruction;
+	class DatasetItemMemo;
+	struct ItemMemoCounters;
 
 	typedef void(JitCompilerA64::*InstructionGeneratorA64)(Instruction&, uint32_t&);
 
@@ -57,7 +59,7 @@ namespace randomx {
 
 		void generateDatasetInitCode() {}
 
-		ProgramFunc* getProgramFunc() { return reinterpret_cast<ProgramFunc*>(code); }
+		ProgramFunc* getProgramFunc() { return reinterpret_cast<ProgramFunc*>(execCode); }
 		DatasetInitFunc* getDatasetInitFunc();
 		uint8_t* getCode() { return code; }
 		size_t getCodeSize();
@@ -65,11 +67,15 @@ namespace randomx {
 		void enableWriting();
 		void enableExecution();
 		void enableAll();
+		bool enableDualMapping();
+		//The dataset item memo is not used by the AArch64 light-mode JIT.
+		void setItemMemo(DatasetItemMemo*, ItemMemoCounters*) {}
 
 	private:
 		static InstructionGeneratorA64 engine[256];
 		uint32_t reg_changed_offset[8];
 		uint8_t* code;
+		uint8_t* execCode;
 		uint32_t literalPos;
 		uint32_t num32bitLiterals;
 
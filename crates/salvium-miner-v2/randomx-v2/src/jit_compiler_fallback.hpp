@@ -38,6 +38,8 @@ namespace randomx {
 	class Program;
 	struct ProgramConfiguration;
 	class SuperscalarProgram;
+	class DatasetItemMemo;
+	struct ItemMemoCounters;
 
 	class JitCompilerFallback {
 	public:
@@ -72,5 +74,9 @@ namespace randomx {
 		void enableWriting() {}
 		void enableExecution() {}
 		void enableAll() {}
+		bool enableDualMapping() {
+			return false;
+		}
+		void setItemMemo(DatasetItemMemo*, ItemMemoCounters*) {}
 	};
 }
\ No newline at end of file
@@ -29,12 +29,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <stdexcept>
 #include <cstring>
 #include <climits>
+#include <cstddef>
 #include "jit_compiler_x86.hpp"
 #include "jit_compiler_x86_static.hpp"
 #include "superscalar.hpp"
 #include "program.hpp"
 #include "reciprocal.h"
 #include "virtual_memory.h"
+#include "dataset_memo.hpp"
 
 namespace randomx {
 	/*
@@ -94,6 +96,16 @@ namespace randomx {
 
 	constexpr int32_t superScalarHashOffset = RandomXCodeSize;
 
+	static_assert(sizeof(InstructionTemplate::code) >= MaxRandomXInstrCodeSize, "InstructionTemplate is too small");
+
+	//patch kinds of InstructionTemplate
+	enum : uint8_t { PatchNone, PatchImm32, PatchImm32L3, PatchImm8, PatchMask, PatchMaskStore };
+
+	//InstructionTemplate operands that an instruction does not have are written to these
+	//offsets past the template, so the emitted code needs at least 40 bytes after the last instruction
+	constexpr uint8_t TemplateScratchImm = 32;
+	constexpr uint8_t TemplateScratchMask = 36;
+
 #if defined(_MSC_VER) && (defined(_DEBUG) || defined (RELWITHDEBINFO))
 #define ADDR(x) ((((uint8_t*)&x)[0] == 0xE9) ? (((uint8_t*)&x) + *(const int32_t*)(((uint8_t*)&x) + 1) + 5) : ((uint8_t*)&x))
 #else
@@ -129,8 +141,6 @@ namespace randomx {
 	const int32_t codeSshPrefetchSize = codeShhEnd - codeShhPrefetch;
 	const int32_t codeSshInitSize = codeProgramEnd - codeShhInit;
 
-	const int32_t epilogueOffset = CodeSize - epilogueSize;
-
 	static const uint8_t REX_ADD_RR[] = { 0x4d, 0x03 };
 	static const uint8_t REX_ADD_RM[] = { 0x4c, 0x03 };
 	static const uint8_t REX_SUB_RR[] = { 0x4d, 0x2b };
@@ -192,6 +202,7 @@ namespace randomx {
 	static const uint8_t REX_MOV_MR[] = { 0x4c, 0x89 };
 	static const uint8_t REX_XOR_EAX[] = { 0x41, 0x33 };
 	static const uint8_t SUB_EBX[] = { 0x83, 0xEB, 0x01 };
+	static const uint8_t CMP_EBX_1[] = { 0x83, 0xFB, 0x01 };
 	static const uint8_t JNZ[] = { 0x0f, 0x85 };
 	static const uint8_t JMP = 0xe9;
 	static const uint8_t REX_XOR_RAX_R64[] = { 0x49, 0x33 };
@@ -207,6 +218,22 @@ namespace randomx {
 	static const uint8_t LEA_32[] = { 0x41, 0x8d };
 	static const uint8_t MOVNTI[] = { 0x4c, 0x0f, 0xc3 };
 	static const uint8_t ADD_EBX_I[] = { 0x81, 0xc3 };
+	static const uint8_t MOV_EAX_EBX[] = { 0x89, 0xd8 };
+	static const uint8_t MOV_RDX_I[] = { 0x48, 0xba };
+	static const uint8_t LEA_RCX_RCX_RAX8[] = { 0x48, 0x8d, 0x0c, 0xc1 };
+	static const uint8_t LEA_RDX_RDX_RCX8[] = { 0x48, 0x8d, 0x14, 0xca };
+	static const uint8_t MOV_RAX_MRCX[] = { 0x48, 0x8b, 0x01 };
+	static const uint8_t BT_RAX_32[] = { 0x48, 0x0f, 0xba, 0xe0, 0x20 };
+	static const uint8_t CMP_EAX_EBX[] = { 0x39, 0xd8 };
+	static const uint8_t CMP_RAX_MRCX[] = { 0x48, 0x3b, 0x01 };
+	static const uint8_t INC_MRAX[] = { 0x48, 0xff, 0x00 };
+	static const uint8_t RDX_NEXT_VERSION_RAX[] = { 0x48, 0x89, 0xc2, 0x48, 0xc1, 0xea, 0x20, 0x48, 0xff, 0xc2, 0x48, 0xc1, 0xe2, 0x20, 0x48, 0x09, 0xda };
+	static const uint8_t LOCK_CMPXCHG_MRCX_RDX[] = { 0xf0, 0x48, 0x0f, 0xb1, 0x11 };
+	static const uint8_t ADD_MRCX_RAX[] = { 0x48, 0x01, 0x01 };
+	static const uint8_t JC_SHORT = 0x72;
+	static const uint8_t JNE_SHORT = 0x75;
+	static const uint8_t PUSH_RBX = 0x53;
+	static const uint8_t POP_RBX = 0x5b;
 
 	static const uint8_t NOP1[] = { 0x90 };
 	static const uint8_t NOP2[] = { 0x66, 0x90 };
@@ -220,31 +247,64 @@ namespace randomx {
 	static const uint8_t* NOPX[] = { NOP1, NOP2, NOP3, NOP4, NOP5, NOP6, NOP7, NOP8 };
 
 	size_t JitCompilerX86::getCodeSize() {
-		return CodeSize;
+		return codeSize;
+	}
+
+	JitCompilerX86::JitCompilerX86() : JitCompilerX86(1) {
 	}
 
-	JitCompilerX86::JitCompilerX86() {
-		code = (uint8_t*)allocMemoryPages(CodeSize);
+	//Interleaved compilers need space for one program per lane, but no SuperscalarHash.
+	JitCompilerX86::JitCompilerX86(unsigned lanes) {
+		codeSize = lanes > 1 ? lanes * RandomXCodeSize : CodeSize;
+		epilogueOffset = codeSize - epilogueSize;
+		code = (uint8_t*)allocMemoryPages(codeSize);
 		if (code == nullptr)
 			throw std::runtime_error("allocMemoryPages");
+		execCode = code;
 		memcpy(code, codePrologue, prologueSize);
 		memcpy(code + epilogueOffset, codeEpilogue, epilogueSize);
+		generateTemplates();
 	}
 
 	JitCompilerX86::~JitCompilerX86() {
-		freePagedMemory(code, CodeSize);
+		if (execCode != code) {
+			freeDualMappedMemory(code, execCode, codeSize);
+		}
+		else {
+			freePagedMemory(code, codeSize);
+		}
+	}
+
+	//Moves the code buffer to a memory region that is mapped twice: code is generated
+	//through the writable view and executed from the executable view, so the W^X
+	//policy holds without changing page protections for every program.
+	bool JitCompilerX86::enableDualMapping() {
+		if (execCode != code)
+			return true;
+		void* exec;
+		uint8_t* rw = (uint8_t*)allocDualMappedMemory(codeSize, &exec);
+		if (rw == nullptr)
+			return false;
+		memcpy(rw, code, codeSize);
+		freePagedMemory(code, codeSize);
+		code = rw;
+		execCode = (uint8_t*)exec;
+		return true;
 	}
 
 	void JitCompilerX86::enableAll() {
-		setPagesRWX(code, CodeSize);
+		if (execCode == code)
+			setPagesRWX(code, codeSize);
 	}
 
 	void JitCompilerX86::enableWriting() {
-		setPagesRW(code, CodeSize);
+		if (execCode == code)
+			setPagesRW(code, codeSize);
 	}
 
 	void JitCompilerX86::enableExecution() {
-		setPagesRX(code, CodeSize);
+		if (execCode == code)
+			setPagesRX(code, codeSize);
 	}
 
 	void JitCompilerX86::generateProgram(Program& prog, ProgramConfiguration& pcfg) {
@@ -259,12 +319,210 @@ namespace randomx {
 		emit(codeReadDatasetLightSshInit, readDatasetLightInitSize);
 		emit(ADD_EBX_I);
 		emit32(datasetOffset / CacheLineSize);
-		emitByte(CALL);
-		emit32(superScalarHashOffset - (codePos + 4));
+		if (itemMemo != nullptr) {
+			genReadDatasetLightMemo();
+		}
+		else {
+			emitByte(CALL);
+			emit32(superScalarHashOffset - (codePos + 4));
+		}
 		emit(codeReadDatasetLightSshFin, readDatasetLightFinSize);
 		generateProgramEpilogue(prog, pcfg);
 	}
 
+	/*
+	Light mode Dataset read with a DatasetItemMemo. On entry, ebx is the item number
+	and r8-r15 are saved on the stack. Implements DatasetItemMemo::lookup/store:
+
+	  rcx = &headers[ebx & slotMask], rax = header
+	  if rax is not being written and holds ebx:
+	    r8-r15 = item; if header unchanged: ++hits, done
+	  call SuperscalarHash (ebx preserved on the stack)
+	  if the slot is free and the header CAS succeeds: store r8-r15, release the slot
+	  ++misses
+	*/
+	void JitCompilerX86::genReadDatasetLightMemo() {
+		uint8_t* headers = (uint8_t*)itemMemo->getHeaders();
+		uint64_t itemsDelta = (uint64_t)itemMemo->getItems() - 8 * (uint64_t)headers;
+		auto genSlotAddress = [&]() {
+			emit(MOV_EAX_EBX);
+			emitByte(AND_EAX_I);
+			emit32(itemMemo->getSlotMask());
+			emit(MOV_RCX_I);
+			emit64((uint64_t)headers);
+			emit(LEA_RCX_RCX_RAX8);
+			emit(MOV_RAX_MRCX);
+			emit(BT_RAX_32);
+		};
+		auto genItemAddress = [&]() {
+			emit(MOV_RDX_I);
+			emit64(itemsDelta);
+			emit(LEA_RDX_RDX_RCX8);
+		};
+		int32_t missJumps[3];
+		auto genMissJump = [&](int k, uint8_t opcode) {
+			emitByte(opcode);
+			missJumps[k] = codePos;
+			emitByte(0);
+		};
+
+		genSlotAddress();
+		genMissJump(0, JC_SHORT);
+		emit(CMP_EAX_EBX);
+		genMissJump(1, JNE_SHORT);
+		genItemAddress();
+		for (int i = 0; i < 8; ++i) {
+			emit(REX_MOV_R64R);
+			emitByte(0x42 + 8 * i);
+			emitByte(8 * i);
+		}
+		emit(CMP_RAX_MRCX);
+		genMissJump(2, JNE_SHORT);
+		emit(MOV_RAX_I);
+		emit64((uint64_t)&itemMemoCounters->hits);
+		emit(INC_MRAX);
+		emitByte(JMP);
+		int32_t doneJump = codePos;
+		emit32(0);
+
+		for (int k = 0; k < 3; ++k) {
+			code[missJumps[k]] = (uint8_t)(codePos - (missJumps[k] + 1));
+		}
+		emitByte(PUSH_RBX);
+		emitByte(CALL);
+		emit32(superScalarHashOffset - (codePos + 4));
+		emitByte(POP_RBX);
+
+		genSlotAddress();
+		emitByte(JC_SHORT);
+		int32_t skipJump1 = codePos;
+		emitByte(0);
+		emit(RDX_NEXT_VERSION_RAX);
+		emit(LOCK_CMPXCHG_MRCX_RDX);
+		emitByte(JNE_SHORT);
+		int32_t skipJump2 = codePos;
+		emitByte(0);
+		genItemAddress();
+		for (int i = 0; i < 8; ++i) {
+			emit(REX_MOV_MR);
+			emitByte(0x42 + 8 * i);
+			emitByte(8 * i);
+		}
+		emit(MOV_RAX_I);
+		emit64(DatasetItemMemo::VersionOne);
+		emit(ADD_MRCX_RAX);
+
+		code[skipJump1] = (uint8_t)(codePos - (skipJump1 + 1));
+		code[skipJump2] = (uint8_t)(codePos - (skipJump2 + 1));
+		emit(MOV_RAX_I);
+		emit64((uint64_t)&itemMemoCounters->misses);
+		emit(INC_MRAX);
+
+		int32_t rel = codePos - (doneJump + 4);
+		memcpy(code + doneJump, &rel, sizeof(rel));
+	}
+
+	/*
+	Interleaved programs execute one iteration of each lane in turn, so the dataset
+	item prefetched by a lane has the iterations of all other lanes to arrive.
+	The code buffer contains (after the standard prologue):
+
+	  load state 0
+	  lane 0: loop body | save state 0 | load state 1
+	  lane 1: loop body | save state 1 | load state 2
+	  ...
+	  lane N-1: loop body | save state N-1 | sub ebx, 1 | jz epilogue | load state 0 | jmp lane 0
+
+	The f and e registers are reloaded at the start of every iteration, so they only
+	need to be saved in the last iteration.
+	*/
+	void JitCompilerX86::generateProgramInterleaved(Program* const* progs, ProgramConfiguration* const* pcfgs, InterleavedLaneState* states, unsigned lanes) {
+		codePos = prologueSize;
+		genLoadLaneState(&states[0]);
+		int32_t firstLane = codePos;
+		for (unsigned k = 0; k < lanes; ++k) {
+			generateProgramBody(*progs[k], *pcfgs[k]);
+			emit(codeReadDataset, readDatasetSize);
+			generateLoopStore(*pcfgs[k]);
+			//save state
+			emit(MOV_RCX_I);
+			emit64((uint64_t)&states[k]);
+			for (int i = 0; i < RegistersCount; ++i) {
+				genLaneStateMov(8 + i, offsetof(InterleavedLaneState, reg.r) + 8 * i, true);
+			}
+			genLaneStateMov(0, offsetof(InterleavedLaneState, spAddr0), true);
+			genLaneStateMov(2, offsetof(InterleavedLaneState, spAddr1), true);
+			genLaneStateMov(5, offsetof(InterleavedLaneState, memoryRegisters), true);
+			genLaneStateMxcsr(offsetof(InterleavedLaneState, mxcsr), true);
+			emit(CMP_EBX_1);
+			emit(JNZ);
+			int32_t skipFloat = codePos;
+			emit32(0);
+			for (int i = 0; i < RegisterCountFlt; ++i) {
+				genLaneStateMovapd(i, offsetof(InterleavedLaneState, reg.f) + 16 * i, true);
+				genLaneStateMovapd(4 + i, offsetof(InterleavedLaneState, reg.e) + 16 * i, true);
+			}
+			int32_t rel = codePos - (skipFloat + 4);
+			memcpy(code + skipFloat, &rel, sizeof(rel));
+			if (k == lanes - 1) {
+				emit(SUB_EBX);
+				emit(JZ);
+				emit32(epilogueOffset - codePos - 4);
+				genLoadLaneState(&states[0]);
+				emitByte(JMP);
+				emit32(firstLane - codePos - 4);
+			}
+			else {
+				genLoadLaneState(&states[k + 1]);
+			}
+		}
+	}
+
+	void JitCompilerX86::genLoadLaneState(InterleavedLaneState* state) {
+		emit(MOV_RCX_I);
+		emit64((uint64_t)state);
+		for (int i = 0; i < RegistersCount; ++i) {
+			genLaneStateMov(8 + i, offsetof(InterleavedLaneState, reg.r) + 8 * i, false);
+		}
+		for (int i = 0; i < RegisterCountFlt; ++i) {
+			genLaneStateMovapd(8 + i, offsetof(InterleavedLaneState, reg.a) + 16 * i, false);
+		}
+		genLaneStateMovapd(14, offsetof(InterleavedLaneState, eMask), false);
+		genLaneStateMov(0, offsetof(InterleavedLaneState, spAddr0), false);
+		genLaneStateMov(2, offsetof(InterleavedLaneState, spAddr1), false);
+		genLaneStateMov(5, offsetof(InterleavedLaneState, memoryRegisters), false);
+		genLaneStateMov(6, offsetof(InterleavedLaneState, scratchpad), false);
+		genLaneStateMov(7, offsetof(InterleavedLaneState, dataset), false);
+		genLaneStateMxcsr(offsetof(InterleavedLaneState, mxcsr), false);
+	}
+
+	//mov [rcx+offset], reg / mov reg, [rcx+offset]
+	void JitCompilerX86::genLaneStateMov(int reg, int32_t offset, bool store) {
+		emitByte(reg >= 8 ? 0x4c : 0x48);
+		emitByte(store ? 0x89 : 0x8b);
+		emitByte(0x81 + 8 * (reg & 7));
+		emit32(offset);
+	}
+
+	//movapd [rcx+offset], xmm / movapd xmm, [rcx+offset]
+	void JitCompilerX86::genLaneStateMovapd(int xmm, int32_t offset, bool store) {
+		emitByte(0x66);
+		if (xmm >= 8)
+			emitByte(0x44);
+		emitByte(0x0f);
+		emitByte(store ? 0x29 : 0x28);
+		emitByte(0x81 + 8 * (xmm & 7));
+		emit32(offset);
+	}
+
+	//stmxcsr [rcx+offset] / ldmxcsr [rcx+offset]
+	void JitCompilerX86::genLaneStateMxcsr(int32_t offset, bool store) {
+		emitByte(0x0f);
+		emitByte(0xae);
+		emitByte(store ? 0x99 : 0x91);
+		emit32(offset);
+	}
+
 	template<size_t N>
 	void JitCompilerX86::generateSuperscalarHash(SuperscalarProgram(&programs)[N], std::vector<uint64_t> &reciprocalCache) {
 		memcpy(code + superScalarHashOffset, codeShhInit, codeSshInitSize);
@@ -302,13 +560,17 @@ namespace randomx {
 	}
 
 	void JitCompilerX86::generateProgramPrologue(Program& prog, ProgramConfiguration& pcfg) {
+		codePos = prologueSize;
+		memcpy(code + codePos - 48, &pcfg.eMask, sizeof(pcfg.eMask));
+		generateProgramBody(prog, pcfg);
+	}
+
+	void JitCompilerX86::generateProgramBody(Program& prog, ProgramConfiguration& pcfg) {
 		instructionOffsets.clear();
 		for (unsigned i = 0; i < RegistersCount; ++i) {
 			registerUsage[i] = -1;
 		}
 
-		codePos = prologueSize;
-		memcpy(code + codePos - 48, &pcfg.eMask, sizeof(pcfg.eMask));
 		memcpy(code + codePos, codeLoopLoad, loopLoadSize);
 		codePos += loopLoadSize;
 		for (unsigned i = 0; i < prog.getSize(); ++i) {
@@ -324,6 +586,15 @@ namespace randomx {
 	}
 
 	void JitCompilerX86::generateProgramEpilogue(Program& prog, ProgramConfiguration& pcfg) {
+		generateLoopStore(pcfg);
+		emit(SUB_EBX);
+		emit(JNZ);
+		emit32(prologueSize - codePos - 4);
+		emitByte(JMP);
+		emit32(epilogueOffset - codePos - 4);
+	}
+
+	void JitCompilerX86::generateLoopStore(ProgramConfiguration& pcfg) {
 		emit(REX_MOV_RR64);
 		emitByte(0xc0 + pcfg.readReg0);
 		emit(REX_XOR_RAX_R64);
@@ -331,19 +602,108 @@ namespace randomx {
 		emit(ADDR(randomx_prefetch_scratchpad), ADDR(randomx_prefetch_scratchpad_end) - ADDR(randomx_prefetch_scratchpad));
 		memcpy(code + codePos, codeLoopStore, loopStoreSize);
 		codePos += loopStoreSize;
-		emit(SUB_EBX);
-		emit(JNZ);
-		emit32(prologueSize - codePos - 4);
-		emitByte(JMP);
-		emit32(epilogueOffset - codePos - 4);
 	}
 
 	void JitCompilerX86::generateCode(Instruction& instr, int i) {
 		instructionOffsets.push_back(codePos);
+		const InstructionTemplate& tpl = templates[(templateIndex[instr.opcode] * RegistersCount + instr.dst) * RegistersCount + instr.src];
+		if (tpl.valid) {
+			emitTemplate(tpl, instr, i);
+			return;
+		}
 		auto generator = engine[instr.opcode];
 		(this->*generator)(instr, i);
 	}
 
+	void JitCompilerX86::emitTemplate(const InstructionTemplate& tpl, Instruction& instr, int i) {
+		//Emission is branchless: the whole template is copied and absent operands are
+		//written past its end, where they are overwritten by the following code.
+		uint8_t* p = code + codePos;
+		for (unsigned k = 0; k < sizeof(tpl.code); k += sizeof(uint64_t)) {
+			uint64_t chunk;
+			memcpy(&chunk, tpl.code + k, sizeof(chunk));
+			memcpy(p + k, &chunk, sizeof(chunk));
+		}
+		uint32_t imm = instr.getImm32() & tpl.immMask;
+		memcpy(p + tpl.immPos, &imm, sizeof(imm));
+		uint32_t mask = instr.getModMem() ? ScratchpadL1Mask : ScratchpadL2Mask;
+		if (tpl.maskKind == PatchMaskStore && instr.getModCond() >= StoreL3Condition) {
+			mask = ScratchpadL3Mask;
+		}
+		memcpy(p + tpl.maskPos, &mask, sizeof(mask));
+		p[tpl.sibPos] |= (instr.getModShift() << 6) & tpl.sibMask;
+		registerUsage[tpl.usageDst] = i;
+		registerUsage[tpl.usageSrc] = i;
+		codePos += tpl.size;
+	}
+
+	//Runs the handler of every instruction type for all register pairs with a zero
+	//immediate and modifier and records the output as a template. CBRANCH, CFROUND
+	//and IMUL_RCP depend on more than the registers and are always generated by their handlers.
+	void JitCompilerX86::generateTemplates() {
+		unsigned typeCount = 0;
+		for (unsigned op = 0; op < 256; ++op) {
+			if (op == 0 || engine[op] != engine[op - 1]) {
+				typeCount++;
+			}
+			templateIndex[op] = typeCount - 1;
+		}
+		templates.assign(typeCount * RegistersCount * RegistersCount, InstructionTemplate());
+		for (unsigned op = 0; op < 256; ++op) {
+			auto generator = engine[op];
+			if ((op > 0 && generator == engine[op - 1]) || generator == &JitCompilerX86::h_CBRANCH ||
+				generator == &JitCompilerX86::h_CFROUND || generator == &JitCompilerX86::h_IMUL_RCP) {
+				continue;
+			}
+			for (unsigned dst = 0; dst < RegistersCount; ++dst) {
+				for (unsigned src = 0; src < RegistersCount; ++src) {
+					Instruction instr;
+					instr.opcode = op;
+					instr.dst = dst;
+					instr.src = src;
+					instr.setMod(0);
+					instr.setImm32(0);
+					for (unsigned j = 0; j < RegistersCount; ++j) {
+						registerUsage[j] = -1;
+					}
+					patchPoints.immPos = patchPoints.maskPos = patchPoints.sibPos = -1;
+					patchPoints.immKind = patchPoints.maskKind = PatchNone;
+					codePos = prologueSize;
+					(this->*generator)(instr, 0);
+					int32_t size = codePos - prologueSize;
+					bool valid = size <= (int32_t)sizeof(InstructionTemplate::code);
+					for (unsigned j = 0; j < RegistersCount; ++j) {
+						if (registerUsage[j] >= 0 && j != dst && j != src)
+							valid = false;
+					}
+					if (!valid) {
+						continue;
+					}
+					InstructionTemplate& tpl = templates[(templateIndex[op] * RegistersCount + dst) * RegistersCount + src];
+					memcpy(tpl.code, code + prologueSize, size);
+					tpl.size = size;
+					tpl.valid = 1;
+					tpl.usageDst = registerUsage[dst] >= 0 ? dst : RegistersCount;
+					tpl.usageSrc = registerUsage[src] >= 0 ? src : RegistersCount;
+					tpl.immPos = TemplateScratchImm;
+					if (patchPoints.immPos >= 0) {
+						tpl.immPos = patchPoints.immPos - prologueSize;
+						tpl.immMask = patchPoints.immKind == PatchImm32L3 ? ScratchpadL3Mask : (patchPoints.immKind == PatchImm8 ? 63 : 0xFFFFFFFF);
+					}
+					tpl.maskPos = TemplateScratchMask;
+					if (patchPoints.maskPos >= 0) {
+						tpl.maskPos = patchPoints.maskPos - prologueSize;
+						tpl.maskKind = patchPoints.maskKind;
+					}
+					if (patchPoints.sibPos >= 0) {
+						tpl.sibPos = patchPoints.sibPos - prologueSize;
+						tpl.sibMask = 0xc0;
+					}
+				}
+			}
+		}
+	}
+
 	void JitCompilerX86::generateSuperscalarCode(Instruction& instr, std::vector<uint64_t> &reciprocalCache) {
 		switch ((SuperscalarInstructionType)instr.opcode)
 		{
@@ -444,11 +804,13 @@ namespace randomx {
 		if (instr.src == RegisterNeedsSib) {
 			emitByte(0x24);
 		}
+		markImm(PatchImm32);
 		emit32(instr.getImm32());
 		if (rax)
 			emitByte(AND_EAX_I);
 		else
 			emit(AND_ECX_I);
+		markMask(PatchMask);
 		emit32(instr.getModMem() ? ScratchpadL1Mask : ScratchpadL2Mask);
 	}
 
@@ -458,8 +820,10 @@ namespace randomx {
 		if (instr.dst == RegisterNeedsSib) {
 			emitByte(0x24);
 		}
+		markImm(PatchImm32);
 		emit32(instr.getImm32());
 		emitByte(AND_EAX_I);
+		markMask(PatchMaskStore);
 		if (instr.getModCond() < StoreL3Condition) {
 			emit32(instr.getModMem() ? ScratchpadL1Mask : ScratchpadL2Mask);
 		}
@@ -469,6 +833,7 @@ namespace randomx {
 	}
 
 	void JitCompilerX86::genAddressImm(Instruction& instr) {
+		markImm(PatchImm32L3);
 		emit32(instr.getImm32() & ScratchpadL3Mask);
 	}
 
@@ -479,9 +844,12 @@ namespace randomx {
 			emitByte(0xac);
 		else
 			emitByte(0x04 + 8 * instr.dst);
+		patchPoints.sibPos = codePos;
 		genSIB(instr.getModShift(), instr.src, instr.dst);
-		if (instr.dst == RegisterNeedsDisplacement)
+		if (instr.dst == RegisterNeedsDisplacement) {
+			markImm(PatchImm32);
 			emit32(instr.getImm32());
+		}
 	}
 
 	void JitCompilerX86::h_IADD_M(Instruction& instr, int i) {
@@ -512,6 +880,7 @@ namespace randomx {
 		else {
 			emit(REX_81);
 			emitByte(0xe8 + instr.dst);
+			markImm(PatchImm32);
 			emit32(instr.getImm32());
 		}
 	}
@@ -540,6 +909,7 @@ namespace randomx {
 		else {
 			emit(REX_IMUL_RRI);
 			emitByte(0xc0 + 9 * instr.dst);
+			markImm(PatchImm32);
 			emit32(instr.getImm32());
 		}
 	}
@@ -643,6 +1013,7 @@ namespace randomx {
 		else {
 			emit(REX_XOR_RI);
 			emitByte(0xf0 + instr.dst);
+			markImm(PatchImm32);
 			emit32(instr.getImm32());
 		}
 	}
@@ -673,6 +1044,7 @@ namespace randomx {
 		else {
 			emit(REX_ROT_I8);
 			emitByte(0xc8 + instr.dst);
+			markImm(PatchImm8);
 			emitByte(instr.getImm32() & 63);
 		}
 	}
@@ -688,6 +1060,7 @@ namespace randomx {
 		else {
 			emit(REX_ROT_I8);
 			emitByte(0xc0 + instr.dst);
+			markImm(PatchImm8);
 			emitByte(instr.getImm32() & 63);
 		}
 	}
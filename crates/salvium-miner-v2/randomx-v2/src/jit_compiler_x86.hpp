@@ -40,23 +40,57 @@ namespace randomx {
 	class SuperscalarProgram;
 	class JitCompilerX86;
 	class Instruction;
+	class DatasetItemMemo;
+	struct ItemMemoCounters;
 
 	typedef void(JitCompilerX86::*InstructionGeneratorX86)(Instruction&, int);
 
+	//State of one lane of an interleaved program while another lane is executing.
+	struct alignas(16) InterleavedLaneState {
+		RegisterFile reg;
+		uint64_t eMask[2];
+		uint64_t spAddr0;
+		uint64_t spAddr1;
+		uint64_t memoryRegisters;
+		uint8_t* scratchpad;
+		uint8_t* dataset;
+		uint32_t mxcsr;
+	};
+
+	//Machine code of one instruction for a fixed (dst, src) register pair, recorded
+	//by running its handler when the compiler is created. Bytes that depend on the
+	//immediate or on the modifier are patched when the template is emitted.
+	struct InstructionTemplate {
+		uint8_t code[32];
+		uint32_t immMask;
+		uint8_t size;
+		uint8_t valid;
+		uint8_t immPos;
+		uint8_t maskPos;
+		uint8_t maskKind;
+		uint8_t sibPos;
+		uint8_t sibMask;
+		uint8_t usageDst;
+		uint8_t usageSrc;
+		uint8_t reserved[3];
+	};
+
 	class JitCompilerX86 {
 	public:
 		JitCompilerX86();
+		explicit JitCompilerX86(unsigned lanes);
 		~JitCompilerX86();
 		void generateProgram(Program&, ProgramConfiguration&);
+		void generateProgramInterleaved(Program* const*, ProgramConfiguration* const*, InterleavedLaneState*, unsigned lanes);
 		void generateProgramLight(Program&, ProgramConfiguration&, uint32_t);
 		template<size_t N>
 		void generateSuperscalarHash(SuperscalarProgram (&programs)[N], std::vector<uint64_t> &);
 		void generateDatasetInitCode();
 		ProgramFunc* getProgramFunc() {
-			return (ProgramFunc*)code;
+			return (ProgramFunc*)execCode;
 		}
 		DatasetInitFunc* getDatasetInitFunc() {
-			return (DatasetInitFunc*)code;
+			return (DatasetInitFunc*)execCode;
 		}
 		uint8_t* getCode() {
 			return code;
@@ -65,23 +99,63 @@ namespace randomx {
 		void enableWriting();
 		void enableExecution();
 		void enableAll();
+		bool enableDualMapping();
+		void setItemMemo(DatasetItemMemo* memo, ItemMemoCounters* counters) {
+			itemMemo = memo;
+			itemMemoCounters = counters;
+		}
+		//Generates every instruction with its handler (for testing the templates)
+		void disableTemplates() {
+			for (auto& tpl : templates)
+				tpl.valid = 0;
+		}
 	private:
 		static InstructionGeneratorX86 engine[256];
+		std::vector<InstructionTemplate> templates;
+		uint8_t templateIndex[256];
+		struct {
+			int32_t immPos, maskPos, sibPos;
+			uint8_t immKind, maskKind;
+		} patchPoints;
 		std::vector<int32_t> instructionOffsets;
-		int registerUsage[RegistersCount];
+		int registerUsage[RegistersCount + 1]; //the last entry is written by templates of instructions that do not modify registers
 		uint8_t* code;
+		uint8_t* execCode;
 		int32_t codePos;
+		size_t codeSize;
+		int32_t epilogueOffset;
+		DatasetItemMemo* itemMemo = nullptr;
+		ItemMemoCounters* itemMemoCounters = nullptr;
 
 		void generateProgramPrologue(Program&, ProgramConfiguration&);
 		void generateProgramEpilogue(Program&, ProgramConfiguration&);
+		void generateProgramBody(Program&, ProgramConfiguration&);
+		void generateLoopStore(ProgramConfiguration&);
+		void genLaneStateMov(int reg, int32_t offset, bool store);
+		void genLaneStateMovapd(int xmm, int32_t offset, bool store);
+		void genLaneStateMxcsr(int32_t offset, bool store);
+		void genLoadLaneState(InterleavedLaneState*);
+		void genReadDatasetLightMemo();
 		void genAddressReg(Instruction&, bool);
 		void genAddressRegDst(Instruction&);
 		void genAddressImm(Instruction&);
 		void genSIB(int scale, int index, int base);
 
 		void generateCode(Instruction&, int);
+		void generateTemplates();
+		void emitTemplate(const InstructionTemplate&, Instruction&, int);
 		void generateSuperscalarCode(Instruction &, std::vector<uint64_t> &);
 
+		void markImm(uint8_t kind) {
+			patchPoints.immPos = codePos;
+			patchPoints.immKind = kind;
+		}
+
+		void markMask(uint8_t kind) {
+			patchPoints.maskPos = codePos;
+			patchPoints.maskKind = kind;
+		}
+
 		void emitByte(uint8_t val) {
 			code[codePos] = val;
 			codePos++;
@@ -0,0 +1,132 @@
+/*
+Copyright (c) 2026, The Salvium Project
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in the
+	  documentation and/or other materials provided with the distribution.
+	* Neither the name of the copyright holder nor the
+	  names of its contributors may be used to endorse or promote products
+	  derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "numa.hpp"
+
+#if defined(_WIN32) || defined(__CYGWIN__)
+#include <windows.h>
+#elif defined(__linux__)
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#endif
+
+namespace randomx {
+
+#if defined(__linux__) && !defined(__CYGWIN__)
+	//Parses a sysfs list such as "0-3,8,10-11" and calls f for every entry.
+	template<typename F>
+	static bool readSysfsList(const char* path, F f) {
+		FILE* file = fopen(path, "r");
+		if (file == nullptr)
+			return false;
+		char buffer[4096];
+		bool ok = fgets(buffer, sizeof(buffer), file) != nullptr;
+		fclose(file);
+		if (!ok)
+			return false;
+		char* p = buffer;
+		while (*p >= '0' && *p <= '9') {
+			unsigned long first = strtoul(p, &p, 10);
+			unsigned long last = first;
+			if (*p == '-')
+				last = strtoul(p + 1, &p, 10);
+			for (unsigned long i = first; i <= last; ++i)
+				f((unsigned)i);
+			if (*p == ',')
+				++p;
+		}
+		return true;
+	}
+#endif
+
+	unsigned getNumaNodeCount() {
+#if defined(_WIN32) || defined(__CYGWIN__)
+		ULONG highest;
+		if (!GetNumaHighestNodeNumber(&highest))
+			return 1;
+		return highest + 1;
+#elif defined(__linux__)
+		unsigned count = 1;
+		readSysfsList("/sys/devices/system/node/online", [&count](unsigned node) {
+			if (node + 1 > count)
+				count = node + 1;
+		});
+		return count;
+#else
+		return 1;
+#endif
+	}
+
+	bool bindThreadToNumaNode(unsigned node) {
+#if defined(_WIN32) || defined(__CYGWIN__)
+		GROUP_AFFINITY affinity;
+		if (!GetNumaNodeProcessorMaskEx((USHORT)node, &affinity) || affinity.Mask == 0)
+			return false;
+		return SetThreadGroupAffinity(GetCurrentThread(), &affinity, nullptr) != 0;
+#elif defined(__linux__)
+		char path[64];
+		snprintf(path, sizeof(path), "/sys/devices/system/node/node%u/cpulist", node);
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		int cpus = 0;
+		bool ok = readSysfsList(path, [&set, &cpus](unsigned cpu) {
+			if (cpu < CPU_SETSIZE) {
+				CPU_SET(cpu, &set);
+				cpus++;
+			}
+		});
+		if (!ok || cpus == 0)
+			return false;
+		return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+		return node == 0;
+#endif
+	}
+
+	unsigned getCurrentNumaNode() {
+#if defined(_WIN32) || defined(__CYGWIN__)
+		PROCESSOR_NUMBER processor;
+		USHORT node;
+		GetCurrentProcessorNumberEx(&processor);
+		if (!GetNumaProcessorNodeEx(&processor, &node))
+			return 0;
+		return node;
+#elif defined(__linux__) && defined(SYS_getcpu)
+		unsigned cpu, node;
+		if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0)
+			return 0;
+		return node;
+#else
+		return 0;
+#endif
+	}
+
+}
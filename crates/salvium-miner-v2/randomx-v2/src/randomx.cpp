@@ -32,10 +32,21 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "vm_interpreted_light.hpp"
 #include "vm_compiled.hpp"
 #include "vm_compiled_light.hpp"
+#if defined(_M_X64) || defined(__x86_64__)
+#include "vm_compiled_interleaved.hpp"
+#endif
 #include "blake2/blake2.h"
 #include "cpu.hpp"
+#include "cache_registry.hpp"
+#include "epoch_manager.hpp"
+#include "verifier.hpp"
+#include "numa.hpp"
+#include "virtual_memory.h"
 #include <cassert>
+#include <cstdio>
 #include <limits>
+#include <thread>
+#include <vector>
 
 #if defined(__SSE__) || defined(__SSE2__) || (defined(_M_IX86_FP) && (_M_IX86_FP > 0))
 #define USE_CSR_INTRINSICS
@@ -44,6 +55,31 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <cfenv>
 #endif
 
+#if defined(_M_X64) || defined(__x86_64__)
+static randomx_vm* createInterleavedVm(randomx_flags flags, unsigned lanes) {
+	switch ((int)(flags & (RANDOMX_FLAG_HARD_AES | RANDOMX_FLAG_LARGE_PAGES | RANDOMX_FLAG_SECURE))) {
+		case RANDOMX_FLAG_DEFAULT:
+			return new randomx::CompiledInterleavedVmDefault(lanes);
+		case RANDOMX_FLAG_HARD_AES:
+			return new randomx::CompiledInterleavedVmHardAes(lanes);
+		case RANDOMX_FLAG_LARGE_PAGES:
+			return new randomx::CompiledInterleavedVmLargePage(lanes);
+		case RANDOMX_FLAG_HARD_AES | RANDOMX_FLAG_LARGE_PAGES:
+			return new randomx::CompiledInterleavedVmLargePageHardAes(lanes);
+		case RANDOMX_FLAG_SECURE:
+			return new randomx::CompiledInterleavedVmDefaultSecure(lanes);
+		case RANDOMX_FLAG_HARD_AES | RANDOMX_FLAG_SECURE:
+			return new randomx::CompiledInterleavedVmHardAesSecure(lanes);
+		case RANDOMX_FLAG_LARGE_PAGES | RANDOMX_FLAG_SECURE:
+			return new randomx::CompiledInterleavedVmLargePageSecure(lanes);
+		case RANDOMX_FLAG_HARD_AES | RANDOMX_FLAG_LARGE_PAGES | RANDOMX_FLAG_SECURE:
+			return new randomx::CompiledInterleavedVmLargePageHardAesSecure(lanes);
+		default:
+			UNREACHABLE;
+	}
+}
+#endif
+
 extern "C" {
 
 	randomx_flags randomx_get_flags() {
@@ -63,6 +99,9 @@ extern "C" {
 		if (randomx_argon2_impl_ssse3() != nullptr && cpu.hasSsse3()) {
 			flags |= RANDOMX_FLAG_ARGON2_SSSE3;
 		}
+		if (randomx_argon2_impl_neon() != nullptr) {
+			flags |= RANDOMX_FLAG_ARGON2_NEON;
+		}
 		return flags;
 	}
 
@@ -81,7 +120,7 @@ extern "C" {
 					cache->dealloc = &randomx::deallocCache<randomx::DefaultAllocator>;
 					cache->jit = nullptr;
 					cache->initialize = &randomx::initCache;
-					cache->datasetInit = &randomx::initDataset;
+					cache->datasetInit = randomx::selectDatasetInitImpl();
 					cache->memory = (uint8_t*)randomx::DefaultAllocator::allocMemory(randomx::CacheSize);
 					break;
 
@@ -97,7 +136,7 @@ extern "C" {
 					cache->dealloc = &randomx::deallocCache<randomx::LargePageAllocator>;
 					cache->jit = nullptr;
 					cache->initialize = &randomx::initCache;
-					cache->datasetInit = &randomx::initDataset;
+					cache->datasetInit = randomx::selectDatasetInitImpl();
 					cache->memory = (uint8_t*)randomx::LargePageAllocator::allocMemory(randomx::CacheSize);
 					break;
 
@@ -135,6 +174,26 @@ extern "C" {
 		if (cache->cacheKey != cacheKey || !cache->isInitialized()) {
 			cache->initialize(cache, key, keySize);
 			cache->cacheKey = cacheKey;
+			if (cache->itemMemo != nullptr)
+				cache->itemMemo->clear();
+		}
+	}
+
+	void randomx_init_cache_parallel(randomx_cache *cache, const void *key, size_t keySize, unsigned int threads) {
+		assert(cache != nullptr);
+		assert(keySize == 0 || key != nullptr);
+		std::string cacheKey;
+		cacheKey.assign((const char *)key, keySize);
+		if (cache->cacheKey != cacheKey || !cache->isInitialized()) {
+			if (threads > 1) {
+				randomx::initCacheParallel(cache, key, keySize, threads);
+			}
+			else {
+				cache->initialize(cache, key, keySize);
+			}
+			cache->cacheKey = cacheKey;
+			if (cache->itemMemo != nullptr)
+				cache->itemMemo->clear();
 		}
 	}
 
@@ -144,6 +203,33 @@ extern "C" {
 		delete cache;
 	}
 
+	int randomx_cache_set_item_memo(randomx_cache *cache, size_t size) {
+		assert(cache != nullptr);
+		delete cache->itemMemo;
+		cache->itemMemo = nullptr;
+		if (size == 0) {
+			return 1;
+		}
+		size_t slots = 1;
+		while (slots * 2 <= size / randomx::DatasetItemMemo::SlotSize && slots * 2 <= randomx::DatasetSize / randomx::CacheLineSize) {
+			slots *= 2;
+		}
+		cache->itemMemo = randomx::DatasetItemMemo::create(slots);
+		return cache->itemMemo != nullptr;
+	}
+
+	void randomx_cache_get_item_memo_stats(randomx_cache *cache, randomx_item_memo_stats *stats, int reset) {
+		assert(cache != nullptr);
+		assert(stats != nullptr);
+		stats->hits = stats->misses = stats->capacity = 0;
+		if (cache->itemMemo != nullptr) {
+			cache->itemMemo->getStats(stats->hits, stats->misses);
+			stats->capacity = cache->itemMemo->getSlotCount();
+			if (reset)
+				cache->itemMemo->resetStats();
+		}
+	}
+
 	randomx_dataset *randomx_alloc_dataset(randomx_flags flags) {
 
 		//fail on 32-bit systems if DatasetSize is >= 4 GiB
@@ -197,6 +283,166 @@ extern "C" {
 		return dataset->memory;
 	}
 
+	int randomx_dataset_save(randomx_dataset *dataset, const char *path, const void *seed, size_t seedSize) {
+		assert(dataset != nullptr);
+		assert(path != nullptr);
+		assert(seedSize == 0 || seed != nullptr);
+
+		std::vector<uint8_t> header(randomx::DatasetFileHeaderSize);
+		randomx::initDatasetFileHeader(*(randomx::DatasetFileHeader*)header.data(), seed, seedSize, dataset->memory);
+
+		std::string tempPath(path);
+		tempPath += ".tmp";
+		FILE* file = fopen(tempPath.c_str(), "wb");
+		if (file == nullptr) {
+			return 0;
+		}
+		bool ok = fwrite(header.data(), 1, header.size(), file) == header.size();
+		ok = ok && fwrite(dataset->memory, 1, randomx::DatasetSize, file) == randomx::DatasetSize;
+		ok = (fclose(file) == 0) && ok;
+		if (ok) {
+			//rename does not replace an existing file on Windows
+			ok = rename(tempPath.c_str(), path) == 0 || (remove(path) == 0 && rename(tempPath.c_str(), path) == 0);
+		}
+		if (!ok) {
+			remove(tempPath.c_str());
+		}
+		return ok ? 1 : 0;
+	}
+
+	randomx_dataset *randomx_dataset_map(const char *path, const void *seed, size_t seedSize, randomx_flags flags) {
+		assert(path != nullptr);
+		assert(seedSize == 0 || seed != nullptr);
+
+		//fail on 32-bit systems if DatasetSize is >= 4 GiB
+		if (randomx::DatasetSize + randomx::DatasetFileHeaderSize > std::numeric_limits<size_t>::max()) {
+			return nullptr;
+		}
+
+		randomx_dataset *dataset = nullptr;
+		FILE* file = nullptr;
+
+		try {
+			dataset = new randomx_dataset();
+			if (flags & RANDOMX_FLAG_LARGE_PAGES) {
+				dataset->dealloc = &randomx::deallocDataset<randomx::LargePageAllocator>;
+				randomx::DatasetFileHeader header;
+				file = fopen(path, "rb");
+				bool ok = file != nullptr && fread(&header, sizeof(header), 1, file) == 1;
+				ok = ok && randomx::checkDatasetFileHeader(header, seed, seedSize);
+				ok = ok && fseek(file, randomx::DatasetFileHeaderSize, SEEK_SET) == 0;
+				if (ok) {
+					//throws if large pages are not available; the file is closed in the catch block
+					dataset->memory = (uint8_t*)randomx::LargePageAllocator::allocMemory(randomx::DatasetSize);
+					ok = fread(dataset->memory, 1, randomx::DatasetSize, file) == randomx::DatasetSize;
+				}
+				if (file != nullptr) {
+					fclose(file);
+					file = nullptr;
+				}
+				if (!ok || randomx::getDatasetChecksum(dataset->memory) != header.checksum) {
+					randomx_release_dataset(dataset);
+					dataset = nullptr;
+				}
+			}
+			else {
+				const bool lazy = (flags & RANDOMX_FLAG_LAZY_MAP) != 0;
+				dataset->dealloc = &randomx::deallocMappedDataset;
+				auto mapping = (uint8_t*)mapFileMemory(path, randomx::DatasetFileHeaderSize + randomx::DatasetSize, !lazy);
+				if (mapping != nullptr) {
+					dataset->memory = mapping + randomx::DatasetFileHeaderSize;
+					auto& header = *(const randomx::DatasetFileHeader*)mapping;
+					//the checksum would read the whole file, so a lazy mapping only checks the header
+					if (!randomx::checkDatasetFileHeader(header, seed, seedSize) || (!lazy && randomx::getDatasetChecksum(dataset->memory) != header.checksum)) {
+						randomx_release_dataset(dataset);
+						dataset = nullptr;
+					}
+				}
+			}
+		}
+		catch (std::exception &ex) {
+			if (file != nullptr) {
+				fclose(file);
+			}
+			if (dataset != nullptr) {
+				randomx_release_dataset(dataset);
+				dataset = nullptr;
+			}
+		}
+		if (dataset && dataset->memory == nullptr) {
+			randomx_release_dataset(dataset);
+			dataset = nullptr;
+		}
+
+		return dataset;
+	}
+
+	unsigned int randomx_numa_node_count() {
+		return randomx::getNumaNodeCount();
+	}
+
+	int randomx_numa_bind_thread(unsigned int node) {
+		return randomx::bindThreadToNumaNode(node) ? 1 : 0;
+	}
+
+	unsigned int randomx_numa_current_node() {
+		return randomx::getCurrentNumaNode();
+	}
+
+	randomx_dataset *randomx_alloc_dataset_numa(randomx_flags flags, unsigned int node) {
+
+		//fail on 32-bit systems if DatasetSize is >= 4 GiB
+		if (randomx::DatasetSize > std::numeric_limits<size_t>::max()) {
+			return nullptr;
+		}
+
+		randomx_dataset *dataset = nullptr;
+
+		try {
+			dataset = new randomx_dataset();
+			dataset->dealloc = &randomx::deallocDataset<randomx::NumaAllocator>;
+			dataset->memory = (uint8_t*)randomx::NumaAllocator::allocMemory(randomx::DatasetSize, node, (flags & RANDOMX_FLAG_LARGE_PAGES) != 0);
+		}
+		catch (std::exception &ex) {
+			if (dataset != nullptr) {
+				randomx_release_dataset(dataset);
+				dataset = nullptr;
+			}
+		}
+
+		return dataset;
+	}
+
+	void randomx_init_dataset_numa(randomx_dataset *dataset, randomx_cache *cache, unsigned int node, unsigned int threads) {
+		assert(dataset != nullptr);
+		assert(cache != nullptr);
+		const uint32_t itemCount = randomx::DatasetSize / randomx::CacheLineSize;
+		if (threads == 0)
+			threads = 1;
+		auto initRange = [dataset, cache](uint32_t startItem, uint32_t endItem) {
+			cache->datasetInit(cache, dataset->memory + startItem * randomx::CacheLineSize, startItem, endItem);
+		};
+		std::vector<std::thread> workers;
+		uint32_t startItem = 0;
+		try {
+			const uint32_t perThread = itemCount / threads;
+			for (unsigned i = 0; i < threads; ++i) {
+				uint32_t endItem = (i == threads - 1) ? itemCount : startItem + perThread;
+				workers.emplace_back([=]() {
+					randomx::bindThreadToNumaNode(node);
+					initRange(startItem, endItem);
+				});
+				startItem = endItem;
+			}
+		}
+		catch (std::exception &ex) {
+			//the memory policy still places the pages, only the compute is not node-local
+			initRange(startItem, itemCount);
+		}
+		for (auto& worker : workers)
+			worker.join();
+	}
+
 	void randomx_release_dataset(randomx_dataset *dataset) {
 		assert(dataset != nullptr);
 		dataset->dealloc(dataset);
@@ -211,6 +457,12 @@ extern "C" {
 		randomx_vm *vm = nullptr;
 
 		try {
+#if defined(_M_X64) || defined(__x86_64__)
+			if ((flags & RANDOMX_FLAG_FULL_MEM) && (flags & RANDOMX_FLAG_JIT) && (flags & (RANDOMX_FLAG_INTERLEAVE_2 | RANDOMX_FLAG_INTERLEAVE_4))) {
+				vm = createInterleavedVm(flags, (flags & RANDOMX_FLAG_INTERLEAVE_4) ? 4 : 2);
+			}
+			else
+#endif
 			switch ((int)(flags & (RANDOMX_FLAG_FULL_MEM | RANDOMX_FLAG_JIT | RANDOMX_FLAG_HARD_AES | RANDOMX_FLAG_LARGE_PAGES))) {
 				case RANDOMX_FLAG_DEFAULT:
 					vm = new randomx::InterpretedLightVmDefault();
@@ -329,6 +581,12 @@ extern "C" {
 				vm->setDataset(dataset);
 
 			vm->allocate();
+
+			if (flags & RANDOMX_FLAG_VAES)
+				vm->enableVaes();
+
+			if ((flags & RANDOMX_FLAG_DUAL_MAP) && (flags & RANDOMX_FLAG_SECURE))
+				vm->enableDualMapping();
 		}
 		catch (std::exception &ex) {
 			delete vm;
@@ -358,6 +616,36 @@ extern "C" {
 		delete machine;
 	}
 
+	void randomx_get_memory_info(randomx_memory_info *info, randomx_cache *cache, randomx_dataset *dataset, randomx_vm *machine) {
+		assert(info != nullptr);
+		info->cache = (cache != nullptr && cache->memory != nullptr) ? randomx::getPageType(cache->memory) : RANDOMX_PAGES_NONE;
+		info->dataset = (dataset != nullptr && dataset->memory != nullptr) ? randomx::getPageType(dataset->memory) : RANDOMX_PAGES_NONE;
+		info->scratchpad = machine != nullptr ? randomx::getPageType(machine->getScratchpad()) : RANDOMX_PAGES_NONE;
+	}
+
+	int randomx_vm_get_stats(randomx_vm *machine, randomx_vm_stats *stats) {
+		assert(machine != nullptr);
+		assert(stats != nullptr);
+		const randomx::VmStats& counters = machine->vmStats;
+		stats->hashes = counters.hashes.get();
+		stats->initScratchpad = counters.initScratchpad.get();
+		stats->generateProgram = counters.generateProgram.get();
+		stats->compile = counters.compile.get();
+		stats->execute = counters.execute.get();
+		stats->blake2bChain = counters.blake2bChain.get();
+		stats->finalResult = counters.finalResult.get();
+#ifdef RANDOMX_VM_STATS
+		return 1;
+#else
+		return 0;
+#endif
+	}
+
+	void randomx_vm_reset_stats(randomx_vm *machine) {
+		assert(machine != nullptr);
+		machine->vmStats.reset();
+	}
+
 	void randomx_calculate_hash(randomx_vm *machine, const void *input, size_t inputSize, void *output) {
 		assert(machine != nullptr);
 		assert(inputSize == 0 || input != nullptr);
@@ -371,12 +659,17 @@ extern "C" {
 #endif
 
 		alignas(16) uint64_t tempHash[8];
-		int blakeResult = blake2b(tempHash, sizeof(tempHash), input, inputSize, nullptr, 0);
-		assert(blakeResult == 0);
+		int blakeResult;
+		{
+			RANDOMX_VM_PHASE(machine, blake2bChain);
+			blakeResult = blake2b(tempHash, sizeof(tempHash), input, inputSize, nullptr, 0);
+			assert(blakeResult == 0);
+		}
 		machine->initScratchpad(&tempHash);
 		machine->resetRoundingMode();
 		for (int chain = 0; chain < RANDOMX_PROGRAM_COUNT - 1; ++chain) {
 			machine->run(&tempHash);
+			RANDOMX_VM_PHASE(machine, blake2bChain);
 			blakeResult = blake2b(tempHash, sizeof(tempHash), machine->getRegisterFile(), sizeof(randomx::RegisterFile), nullptr, 0);
 			assert(blakeResult == 0);
 		}
@@ -391,7 +684,10 @@ extern "C" {
 	}
 
 	void randomx_calculate_hash_first(randomx_vm* machine, const void* input, size_t inputSize) {
-		blake2b(machine->tempHash, sizeof(machine->tempHash), input, inputSize, nullptr, 0);
+		{
+			RANDOMX_VM_PHASE(machine, blake2bChain);
+			blake2b(machine->tempHash, sizeof(machine->tempHash), input, inputSize, nullptr, 0);
+		}
 		machine->initScratchpad(machine->tempHash);
 	}
 
@@ -399,12 +695,16 @@ extern "C" {
 		machine->resetRoundingMode();
 		for (uint32_t chain = 0; chain < RANDOMX_PROGRAM_COUNT - 1; ++chain) {
 			machine->run(machine->tempHash);
+			RANDOMX_VM_PHASE(machine, blake2bChain);
 			blake2b(machine->tempHash, sizeof(machine->tempHash), machine->getRegisterFile(), sizeof(randomx::RegisterFile), nullptr, 0);
 		}
 		machine->run(machine->tempHash);
 
 		// Finish current hash and fill the scratchpad for the next hash at the same time
-		blake2b(machine->tempHash, sizeof(machine->tempHash), nextInput, nextInputSize, nullptr, 0);
+		{
+			RANDOMX_VM_PHASE(machine, blake2bChain);
+			blake2b(machine->tempHash, sizeof(machine->tempHash), nextInput, nextInputSize, nullptr, 0);
+		}
 		machine->hashAndFill(output, RANDOMX_HASH_SIZE, machine->tempHash);
 	}
 
@@ -412,12 +712,93 @@ extern "C" {
 		machine->resetRoundingMode();
 		for (int chain = 0; chain < RANDOMX_PROGRAM_COUNT - 1; ++chain) {
 			machine->run(machine->tempHash);
+			RANDOMX_VM_PHASE(machine, blake2bChain);
 			blake2b(machine->tempHash, sizeof(machine->tempHash), machine->getRegisterFile(), sizeof(randomx::RegisterFile), nullptr, 0);
 		}
 		machine->run(machine->tempHash);
 		machine->getFinalResult(output, RANDOMX_HASH_SIZE);
 	}
 
+	size_t randomx_calculate_hash_batch(randomx_vm* machine, const void* input, size_t inputSize, size_t nonceOffset, uint32_t nonceStart, size_t count, void* output, uint64_t target) {
+		assert(machine != nullptr);
+		assert(input != nullptr);
+		assert(nonceOffset + sizeof(uint32_t) <= inputSize);
+		assert(count == 0 || output != nullptr);
+
+		if (count == 0) {
+			return 0;
+		}
+
+#ifdef USE_CSR_INTRINSICS
+		const unsigned int fpstate = _mm_getcsr();
+#else
+		fenv_t fpstate;
+		fegetenv(&fpstate);
+#endif
+
+		std::vector<uint8_t> blob((const uint8_t*)input, (const uint8_t*)input + inputSize);
+		uint8_t* noncePtr = blob.data() + nonceOffset;
+		uint8_t* out = (uint8_t*)output;
+		size_t done = 0;
+		bool found = false;
+
+		const unsigned lanes = machine->getLaneCount();
+		if (lanes > 1) {
+			std::vector<uint8_t> blobs(lanes * inputSize);
+			std::vector<const void*> inputs(lanes);
+			std::vector<uint8_t> hashes(lanes * RANDOMX_HASH_SIZE);
+			for (unsigned k = 0; k < lanes; ++k) {
+				memcpy(&blobs[k * inputSize], input, inputSize);
+				inputs[k] = &blobs[k * inputSize];
+			}
+			//the last group may calculate up to lanes - 1 hashes that are not returned
+			while (done < count && !found) {
+				for (unsigned k = 0; k < lanes; ++k) {
+					store32(&blobs[k * inputSize + nonceOffset], nonceStart + (uint32_t)(done + k));
+				}
+				machine->calculateHashInterleaved(inputs.data(), inputSize, hashes.data());
+				for (unsigned k = 0; k < lanes && done < count; ++k) {
+					memcpy(out, &hashes[k * RANDOMX_HASH_SIZE], RANDOMX_HASH_SIZE);
+					++done;
+					if (target != 0 && load64(out + 24) < target) {
+						found = true;
+						break;
+					}
+					out += RANDOMX_HASH_SIZE;
+				}
+			}
+		}
+		else {
+			store32(noncePtr, nonceStart);
+			randomx_calculate_hash_first(machine, blob.data(), inputSize);
+
+			// Each step finishes hash `done` while filling the scratchpad for hash `done + 1`
+			while (done + 1 < count) {
+				store32(noncePtr, nonceStart + (uint32_t)(done + 1));
+				randomx_calculate_hash_next(machine, blob.data(), inputSize, out);
+				++done;
+				if (target != 0 && load64(out + 24) < target) {
+					found = true;
+					break;
+				}
+				out += RANDOMX_HASH_SIZE;
+			}
+
+			if (!found) {
+				randomx_calculate_hash_last(machine, out);
+				++done;
+			}
+		}
+
+#ifdef USE_CSR_INTRINSICS
+		_mm_setcsr(fpstate);
+#else
+		fesetenv(&fpstate);
+#endif
+
+		return done;
+	}
+
 	void randomx_calculate_commitment(const void* input, size_t inputSize, const void* hash_in, void* com_out) {
 		assert(inputSize == 0 || input != nullptr);
 		assert(hash_in != nullptr);
@@ -428,4 +809,132 @@ extern "C" {
 		blake2b_update(&state, hash_in, RANDOMX_HASH_SIZE);
 		blake2b_final(&state, com_out, RANDOMX_HASH_SIZE);
 	}
+
+	randomx_epoch_manager *randomx_create_epoch_manager(randomx_flags flags, unsigned int initThreads) {
+		randomx_epoch_manager *manager = nullptr;
+		try {
+			manager = new randomx_epoch_manager(flags, initThreads);
+		}
+		catch (std::exception &ex) {
+			manager = nullptr;
+		}
+		return manager;
+	}
+
+	void randomx_epoch_manager_prepare(randomx_epoch_manager *manager, const void *seed, size_t seedSize) {
+		assert(manager != nullptr);
+		assert(seedSize == 0 || seed != nullptr);
+		manager->prepare(std::string((const char *)seed, seedSize));
+	}
+
+	int randomx_epoch_manager_activate(randomx_epoch_manager *manager, const void *seed, size_t seedSize) {
+		assert(manager != nullptr);
+		assert(seedSize == 0 || seed != nullptr);
+		return manager->activate(std::string((const char *)seed, seedSize)) ? 1 : 0;
+	}
+
+	randomx_dataset *randomx_epoch_manager_get_dataset(randomx_epoch_manager *manager) {
+		assert(manager != nullptr);
+		return manager->getDataset();
+	}
+
+	void randomx_epoch_manager_register_vm(randomx_epoch_manager *manager, randomx_vm *machine) {
+		assert(manager != nullptr);
+		assert(machine != nullptr);
+		manager->registerVm(machine);
+	}
+
+	void randomx_epoch_manager_unregister_vm(randomx_epoch_manager *manager, randomx_vm *machine) {
+		assert(manager != nullptr);
+		assert(machine != nullptr);
+		manager->unregisterVm(machine);
+	}
+
+	int randomx_epoch_manager_sync_vm(randomx_epoch_manager *manager, randomx_vm *machine) {
+		assert(manager != nullptr);
+		assert(machine != nullptr);
+		return manager->syncVm(machine) ? 1 : 0;
+	}
+
+	void randomx_destroy_epoch_manager(randomx_epoch_manager *manager) {
+		assert(manager != nullptr);
+		delete manager;
+	}
+
+	randomx_cache_registry *randomx_create_cache_registry(randomx_flags flags, size_t memoryBudget, unsigned int initThreads) {
+		randomx_cache_registry *registry = nullptr;
+		try {
+			registry = new randomx_cache_registry(flags, memoryBudget, initThreads);
+		}
+		catch (std::exception &ex) {
+			registry = nullptr;
+		}
+		return registry;
+	}
+
+	int randomx_cache_registry_prepare(randomx_cache_registry *registry, const void *seed, size_t seedSize) {
+		assert(registry != nullptr);
+		assert(seedSize == 0 || seed != nullptr);
+		return registry->prepare(std::string((const char *)seed, seedSize)) ? 1 : 0;
+	}
+
+	randomx_cache *randomx_cache_registry_acquire(randomx_cache_registry *registry, const void *seed, size_t seedSize) {
+		assert(registry != nullptr);
+		assert(seedSize == 0 || seed != nullptr);
+		return registry->acquire(std::string((const char *)seed, seedSize));
+	}
+
+	void randomx_cache_registry_release(randomx_cache_registry *registry, randomx_cache *cache) {
+		assert(registry != nullptr);
+		assert(cache != nullptr);
+		registry->release(cache);
+	}
+
+	int randomx_cache_registry_attach_vm(randomx_cache_registry *registry, randomx_vm *machine, const void *seed, size_t seedSize) {
+		assert(registry != nullptr);
+		assert(machine != nullptr);
+		assert(seedSize == 0 || seed != nullptr);
+		return registry->attachVm(machine, std::string((const char *)seed, seedSize)) ? 1 : 0;
+	}
+
+	void randomx_cache_registry_detach_vm(randomx_cache_registry *registry, randomx_vm *machine) {
+		assert(registry != nullptr);
+		assert(machine != nullptr);
+		registry->detachVm(machine);
+	}
+
+	size_t randomx_cache_registry_count(randomx_cache_registry *registry) {
+		assert(registry != nullptr);
+		return registry->getCacheCount();
+	}
+
+	void randomx_destroy_cache_registry(randomx_cache_registry *registry) {
+		assert(registry != nullptr);
+		delete registry;
+	}
+
+	randomx_verifier *randomx_create_verifier(randomx_flags flags, unsigned int threads) {
+		randomx_verifier *verifier = nullptr;
+		try {
+			verifier = new randomx_verifier(flags, threads);
+		}
+		catch (std::exception &ex) {
+			verifier = nullptr;
+		}
+		return verifier;
+	}
+
+	int randomx_verify_batch(randomx_verifier *verifier, randomx_cache * const *caches, randomx_dataset *dataset,
+		const void * const *inputs, const size_t *inputSizes, const void * const *expectedHashes, size_t count,
+		unsigned char *results, void *hashes) {
+		assert(verifier != nullptr);
+		assert(count == 0 || (inputs != nullptr && inputSizes != nullptr && expectedHashes != nullptr && results != nullptr));
+		assert(count == 0 || caches != nullptr || dataset != nullptr);
+		return verifier->verify(caches, dataset, inputs, inputSizes, expectedHashes, count, results, (uint8_t*)hashes) ? 1 : 0;
+	}
+
+	void randomx_destroy_verifier(randomx_verifier *verifier) {
+		assert(verifier != nullptr);
+		delete verifier;
+	}
 }
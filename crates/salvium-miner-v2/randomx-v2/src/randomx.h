@@ -48,12 +48,51 @@ typedef enum {
   RANDOMX_FLAG_SECURE = 16,
   RANDOMX_FLAG_ARGON2_SSSE3 = 32,
   RANDOMX_FLAG_ARGON2_AVX2 = 64,
-  RANDOMX_FLAG_ARGON2 = 96
+  RANDOMX_FLAG_ARGON2 = 2144,
+  RANDOMX_FLAG_INTERLEAVE_2 = 128,
+  RANDOMX_FLAG_INTERLEAVE_4 = 256,
+  RANDOMX_FLAG_VAES = 512,
+  RANDOMX_FLAG_DUAL_MAP = 1024,
+  RANDOMX_FLAG_ARGON2_NEON = 2048,
+  RANDOMX_FLAG_LAZY_MAP = 4096
 } randomx_flags;
 
+typedef enum {
+  RANDOMX_PAGES_NONE = 0,
+  RANDOMX_PAGES_SMALL = 1,
+  RANDOMX_PAGES_TRANSPARENT = 2,
+  RANDOMX_PAGES_2MB = 3,
+  RANDOMX_PAGES_1GB = 4
+} randomx_page_type;
+
+typedef struct {
+  randomx_page_type cache;
+  randomx_page_type dataset;
+  randomx_page_type scratchpad;
+} randomx_memory_info;
+
+typedef struct {
+  uint64_t hits;
+  uint64_t misses;
+  uint64_t capacity;
+} randomx_item_memo_stats;
+
+typedef struct {
+  uint64_t hashes;
+  uint64_t initScratchpad;
+  uint64_t generateProgram;
+  uint64_t compile;
+  uint64_t execute;
+  uint64_t blake2bChain;
+  uint64_t finalResult;
+} randomx_vm_stats;
+
 typedef struct randomx_dataset randomx_dataset;
 typedef struct randomx_cache randomx_cache;
 typedef struct randomx_vm randomx_vm;
+typedef struct randomx_epoch_manager randomx_epoch_manager;
+typedef struct randomx_verifier randomx_verifier;
+typedef struct randomx_cache_registry randomx_cache_registry;
 
 
 #if defined(__cplusplus)
@@ -95,11 +134,13 @@ RANDOMX_EXPORT randomx_flags randomx_get_flags(void);
  *        RANDOMX_FLAG_LARGE_PAGES - allocate memory in large pages
  *        RANDOMX_FLAG_JIT - create cache structure with JIT compilation support; this makes
  *                           subsequent Dataset initialization faster
- *        Optionally, one of these two flags may be selected:
+ *        Optionally, one of these three flags may be selected:
  *        RANDOMX_FLAG_ARGON2_SSSE3 - optimized Argon2 for CPUs with the SSSE3 instruction set
  *                                   makes subsequent cache initialization faster
  *        RANDOMX_FLAG_ARGON2_AVX2 - optimized Argon2 for CPUs with the AVX2 instruction set
  *                                   makes subsequent cache initialization faster
+ *        RANDOMX_FLAG_ARGON2_NEON - optimized Argon2 for 64-bit ARM CPUs (NEON is always
+ *                                   available on AArch64)
  *
  * @return Pointer to an allocated randomx_cache structure.
  *         Returns NULL if:
@@ -119,6 +160,23 @@ RANDOMX_EXPORT randomx_cache *randomx_alloc_cache(randomx_flags flags);
 */
 RANDOMX_EXPORT void randomx_init_cache(randomx_cache *cache, const void *key, size_t keySize);
 
+/**
+ * Same as randomx_init_cache, but uses additional threads to shorten the wall-clock
+ * time of the initialization. RandomX uses a single Argon2 lane, so every block
+ * depends on the previous one and the Argon2d fill cannot be split between threads.
+ * It runs on the calling thread while the SuperscalarHash programs are generated
+ * (and compiled if the cache was allocated with RANDOMX_FLAG_JIT) on another thread.
+ * The first initialization of a cache also spreads the page faults of the cache
+ * memory over the given number of threads.
+ *
+ * @param cache is a pointer to a previously allocated randomx_cache structure. Must not be NULL.
+ * @param key is a pointer to memory which contains the key value. Must not be NULL.
+ * @param keySize is the number of bytes of the key.
+ * @param threads is the maximum number of threads to use, including the calling thread.
+ *        Values 0 and 1 are equivalent to calling randomx_init_cache.
+*/
+RANDOMX_EXPORT void randomx_init_cache_parallel(randomx_cache *cache, const void *key, size_t keySize, unsigned int threads);
+
 /**
  * Releases all memory occupied by the randomx_cache structure.
  *
@@ -126,6 +184,34 @@ RANDOMX_EXPORT void randomx_init_cache(randomx_cache *cache, const void *key, si
 */
 RANDOMX_EXPORT void randomx_release_cache(randomx_cache* cache);
 
+/**
+ * Enables a bounded memo of computed Dataset items for light-mode virtual machines
+ * (RANDOMX_FLAG_FULL_MEM not set) that use this cache. Items computed by any of these
+ * virtual machines are kept in a direct-mapped, lock-free table that is shared by all
+ * threads, so validating many hashes with the same key recomputes fewer items.
+ * The memo is cleared when the cache is initialized with a different key.
+ * In JIT mode, the memo is only used on x86-64.
+ * Must not be called while a virtual machine is calculating a hash with this cache.
+ *
+ * @param cache is a pointer to a previously allocated randomx_cache structure. Must not be NULL.
+ * @param size is the maximum memory used by the memo in bytes. Each item takes 72 bytes
+ *        and the number of items is rounded down to a power of 2. 0 disables the memo.
+ *
+ * @return 1 on success, 0 if size is too small (less than 8 items) or allocation fails.
+ *         On failure, the memo is disabled.
+*/
+RANDOMX_EXPORT int randomx_cache_set_item_memo(randomx_cache *cache, size_t size);
+
+/**
+ * Gets the Dataset item memo statistics of a cache. The counters are updated after
+ * every program executed by a virtual machine and all fields are 0 if the memo is disabled.
+ *
+ * @param cache is a pointer to a randomx_cache structure. Must not be NULL.
+ * @param stats is a pointer to the structure that receives the result. Must not be NULL.
+ * @param reset - if non-zero, the hit and miss counters are reset to 0 after reading.
+*/
+RANDOMX_EXPORT void randomx_cache_get_item_memo_stats(randomx_cache *cache, randomx_item_memo_stats *stats, int reset);
+
 /**
  * Creates a randomx_dataset structure and allocates memory for RandomX Dataset.
  *
@@ -167,6 +253,95 @@ RANDOMX_EXPORT void randomx_init_dataset(randomx_dataset *dataset, randomx_cache
 */
 RANDOMX_EXPORT void *randomx_get_dataset_memory(randomx_dataset *dataset);
 
+/**
+ * Saves an initialized dataset to a file, so it can be loaded later with randomx_dataset_map
+ * instead of being recomputed. The file header contains a hash of the seed, a fingerprint
+ * of the RANDOMX_* configuration and a checksum of the dataset. The file is written to
+ * a temporary file first and then renamed to path.
+ *
+ * @param dataset is a pointer to a fully initialized randomx_dataset structure. Must not be NULL.
+ * @param path is the path of the file. Must not be NULL.
+ * @param seed is a pointer to memory which contains the key used to initialize the Cache
+ *        from which the dataset was initialized. Must not be NULL.
+ * @param seedSize is the number of bytes of the seed.
+ *
+ * @return 1 on success, 0 if the file could not be written.
+*/
+RANDOMX_EXPORT int randomx_dataset_save(randomx_dataset *dataset, const char *path, const void *seed, size_t seedSize);
+
+/**
+ * Creates a randomx_dataset structure from a file written by randomx_dataset_save.
+ *
+ * By default the file is memory-mapped read-only and prefaulted, so the dataset is
+ * shared with the page cache, and the checksum is verified. With RANDOMX_FLAG_LAZY_MAP
+ * the mapping is not prefaulted and the checksum is not verified, so the function returns
+ * as soon as the header is checked and the pages are read on first use. With
+ * RANDOMX_FLAG_LARGE_PAGES the file is read into newly allocated large pages instead
+ * and the checksum is always verified.
+ * The returned dataset must not be passed to randomx_init_dataset.
+ *
+ * @param path is the path of the file. Must not be NULL.
+ * @param seed is a pointer to memory which contains the expected key. Must not be NULL.
+ * @param seedSize is the number of bytes of the seed.
+ * @param flags is the allocation flags. Only RANDOMX_FLAG_LARGE_PAGES and
+ *        RANDOMX_FLAG_LAZY_MAP are supported.
+ *
+ * @return Pointer to a randomx_dataset structure.
+ *         Returns NULL if the file does not exist, was saved for a different seed or
+ *         configuration, fails the checksum or memory allocation fails.
+*/
+RANDOMX_EXPORT randomx_dataset *randomx_dataset_map(const char *path, const void *seed, size_t seedSize, randomx_flags flags);
+
+/**
+ * Gets the number of NUMA nodes of the system.
+ *
+ * @return the highest NUMA node number + 1. Returns 1 on systems without NUMA support.
+*/
+RANDOMX_EXPORT unsigned int randomx_numa_node_count(void);
+
+/**
+ * Restricts the calling thread to the processors of a NUMA node.
+ *
+ * @param node is the NUMA node number.
+ *
+ * @return 1 on success, 0 if the node does not exist or the affinity could not be set.
+*/
+RANDOMX_EXPORT int randomx_numa_bind_thread(unsigned int node);
+
+/**
+ * Gets the NUMA node of the processor the calling thread is running on. Mining threads
+ * should use this (after randomx_numa_bind_thread) to pick their node-local dataset replica.
+ *
+ * @return the NUMA node number. Returns 0 on systems without NUMA support.
+*/
+RANDOMX_EXPORT unsigned int randomx_numa_current_node(void);
+
+/**
+ * Creates a randomx_dataset structure with the dataset memory bound to a NUMA node.
+ * Use one dataset per node to keep the dataset reads of every mining thread node-local.
+ *
+ * @param flags is the initialization flags. Only one flag is supported (can be set or not set):
+ *        RANDOMX_FLAG_LARGE_PAGES - allocate memory in large pages
+ * @param node is the NUMA node number.
+ *
+ * @return Pointer to an allocated randomx_dataset structure.
+ *         NULL is returned if the node does not exist or memory allocation fails.
+ */
+RANDOMX_EXPORT randomx_dataset *randomx_alloc_dataset_numa(randomx_flags flags, unsigned int node);
+
+/**
+ * Initializes all dataset items using threads bound to a NUMA node, so the dataset
+ * is computed by the processors local to its memory. The calling thread waits for
+ * the initialization to finish and its affinity is not changed.
+ *
+ * @param dataset is a pointer to a randomx_dataset structure, usually allocated with
+ *        randomx_alloc_dataset_numa. Must not be NULL.
+ * @param cache is a pointer to a previously allocated and initialized randomx_cache structure. Must not be NULL.
+ * @param node is the NUMA node number.
+ * @param threads is the number of initialization threads. 0 is treated as 1.
+*/
+RANDOMX_EXPORT void randomx_init_dataset_numa(randomx_dataset *dataset, randomx_cache *cache, unsigned int node, unsigned int threads);
+
 /**
  * Releases all memory occupied by the randomx_dataset structure.
  *
@@ -177,13 +352,28 @@ RANDOMX_EXPORT void randomx_release_dataset(randomx_dataset *dataset);
 /**
  * Creates and initializes a RandomX virtual machine.
  *
- * @param flags is any combination of these 5 flags (each flag can be set or not set):
+ * @param flags is any combination of these 9 flags (each flag can be set or not set):
  *        RANDOMX_FLAG_LARGE_PAGES - allocate scratchpad memory in large pages
  *        RANDOMX_FLAG_HARD_AES - virtual machine will use hardware accelerated AES
  *        RANDOMX_FLAG_FULL_MEM - virtual machine will use the full dataset
  *        RANDOMX_FLAG_JIT - virtual machine will use a JIT compiler
  *        RANDOMX_FLAG_SECURE - when combined with RANDOMX_FLAG_JIT, the JIT pages are never
  *                              writable and executable at the same time (W^X policy)
+ *        RANDOMX_FLAG_INTERLEAVE_2, RANDOMX_FLAG_INTERLEAVE_4 - when combined with
+ *                              RANDOMX_FLAG_FULL_MEM and RANDOMX_FLAG_JIT on x86-64, the
+ *                              virtual machine has 2 or 4 lanes with separate scratchpads and
+ *                              randomx_calculate_hash_batch executes the programs of 2 or 4
+ *                              hashes in turn, one loop iteration at a time, so that each
+ *                              dataset prefetch has more time to complete. Ignored otherwise.
+ *        RANDOMX_FLAG_VAES - when combined with RANDOMX_FLAG_HARD_AES, the scratchpad hash and
+ *                              program generation use 256-bit VAES instructions if the CPU
+ *                              supports them.
+ *                              Ignored otherwise.
+ *        RANDOMX_FLAG_DUAL_MAP - when combined with RANDOMX_FLAG_JIT and RANDOMX_FLAG_SECURE,
+ *                              the JIT buffer is mapped twice (writable and executable) so the
+ *                              W^X policy is kept without changing page protections for every
+ *                              program. Falls back to the standard secure mode if the platform
+ *                              doesn't support it. Ignored otherwise.
  *        The numeric values of the first 4 flags are ordered so that a higher value will provide
  *        faster hash calculation and a lower numeric value will provide higher portability.
  *        Using RANDOMX_FLAG_DEFAULT (all flags not set) works on all platforms, but is the slowest.
@@ -228,6 +418,54 @@ RANDOMX_EXPORT void randomx_vm_set_dataset(randomx_vm *machine, randomx_dataset
 */
 RANDOMX_EXPORT void randomx_destroy_vm(randomx_vm *machine);
 
+/**
+ * Reports the page type backing the Cache, Dataset and VM scratchpad.
+ *
+ * With RANDOMX_FLAG_LARGE_PAGES, memory is allocated from the first tier that succeeds:
+ * 1 GiB pages (only for allocations of at least 1 GiB, i.e. the Dataset), 2 MiB pages,
+ * then (on Linux) 2 MiB aligned memory advised with MADV_HUGEPAGE. RANDOMX_PAGES_TRANSPARENT
+ * means the advice was accepted; whether the kernel backs the memory with huge pages
+ * depends on the THP settings of the system.
+ *
+ * @param info is a pointer to the structure that receives the result. Must not be NULL.
+ * @param cache is a pointer to a randomx_cache structure or NULL.
+ * @param dataset is a pointer to a randomx_dataset structure or NULL.
+ * @param machine is a pointer to a randomx_vm structure or NULL.
+ *        The field of a NULL argument is set to RANDOMX_PAGES_NONE.
+*/
+RANDOMX_EXPORT void randomx_get_memory_info(randomx_memory_info *info, randomx_cache *cache, randomx_dataset *dataset, randomx_vm *machine);
+
+/**
+ * Gets the time a virtual machine has spent in each phase of the hash calculation.
+ * The counters are only collected if the library was built with RANDOMX_VM_STATS
+ * (cmake -DRANDOMX_VM_STATS=ON). They are measured in ticks of the time stamp counter
+ * on x86, of the virtual counter (CNTVCT_EL0) on ARMv8 and in nanoseconds elsewhere.
+ *   initScratchpad  - AES fill of the scratchpad from the input hash
+ *   generateProgram - AES generation of each program and its configuration
+ *   compile         - JIT compilation (or bytecode compilation in interpreted mode)
+ *   execute         - program execution including Dataset accesses
+ *   blake2bChain    - hashing of the input and of the register file between programs
+ *   finalResult     - AES hash of the scratchpad and the final Blake2b (with
+ *                     randomx_calculate_hash_next this includes the next scratchpad fill)
+ * This function may be called from any thread while the virtual machine is in use.
+ *
+ * @param machine is a pointer to a randomx_vm structure. Must not be NULL.
+ * @param stats is a pointer to the structure that receives the result. Must not be NULL.
+ *
+ * @return 1 if the statistics are available, 0 if the library was built without them
+ *         (all fields are then set to 0).
+*/
+RANDOMX_EXPORT int randomx_vm_get_stats(randomx_vm *machine, randomx_vm_stats *stats);
+
+/**
+ * Resets all phase counters of a virtual machine to 0.
+ * Like randomx_vm_get_stats, this function may be called from any thread while
+ * the virtual machine is in use.
+ *
+ * @param machine is a pointer to a randomx_vm structure. Must not be NULL.
+*/
+RANDOMX_EXPORT void randomx_vm_reset_stats(randomx_vm *machine);
+
 /**
  * Calculates a RandomX hash value.
  *
@@ -260,6 +498,32 @@ RANDOMX_EXPORT void randomx_calculate_hash_first(randomx_vm* machine, const void
 RANDOMX_EXPORT void randomx_calculate_hash_next(randomx_vm* machine, const void* nextInput, size_t nextInputSize, void* output);
 RANDOMX_EXPORT void randomx_calculate_hash_last(randomx_vm* machine, void* output);
 
+/**
+ * Calculates RandomX hashes of consecutive nonces using the pipelined
+ * randomx_calculate_hash_first/next/last sequence internally. Virtual machines
+ * created with RANDOMX_FLAG_INTERLEAVE_2/4 calculate 2 or 4 hashes at a time instead.
+ *
+ * The input is copied and a 32-bit little-endian nonce is written at nonceOffset
+ * before each hash, starting with nonceStart and incrementing by one.
+ *
+ * @param machine is a pointer to a randomx_vm structure. Must not be NULL.
+ * @param input is a pointer to the block template to be hashed. Must not be NULL.
+ * @param inputSize is the number of bytes of the block template.
+ * @param nonceOffset is the byte offset of the nonce in the input. nonceOffset + 4
+ *        must not exceed inputSize.
+ * @param nonceStart is the nonce value used for the first hash.
+ * @param count is the maximum number of hashes to calculate.
+ * @param output is a pointer to memory where the hashes will be stored. Must not
+ *        be NULL and at least count * RANDOMX_HASH_SIZE bytes must be available for writing.
+ * @param target is a 64-bit target compared against the last 8 bytes of each hash
+ *        (read as a little-endian integer). Calculation stops after the first hash
+ *        that is below the target. Pass 0 to always calculate all count hashes.
+ *
+ * @return The number of hashes written to output. If the calculation stopped early,
+ *         the last hash written is the one that met the target.
+*/
+RANDOMX_EXPORT size_t randomx_calculate_hash_batch(randomx_vm* machine, const void* input, size_t inputSize, size_t nonceOffset, uint32_t nonceStart, size_t count, void* output, uint64_t target);
+
 /**
  * Calculate a RandomX commitment from a RandomX hash and its input.
  *
@@ -271,6 +535,223 @@ RANDOMX_EXPORT void randomx_calculate_hash_last(randomx_vm* machine, void* outpu
 */
 RANDOMX_EXPORT void randomx_calculate_commitment(const void* input, size_t inputSize, const void* hash_in, void* com_out);
 
+/**
+ * Creates an epoch manager, which owns the Dataset of the current seed and can build the
+ * Dataset of the next seed in the background while the current one is being used.
+ *
+ * @param flags is the flags used to allocate the Cache and the Dataset of each epoch.
+ *        See randomx_alloc_cache and randomx_alloc_dataset for the supported flags.
+ * @param initThreads is the number of threads used to initialize each Dataset.
+ *
+ * @return Pointer to a new randomx_epoch_manager structure.
+ *         Returns NULL if memory allocation fails.
+*/
+RANDOMX_EXPORT randomx_epoch_manager *randomx_create_epoch_manager(randomx_flags flags, unsigned int initThreads);
+
+/**
+ * Starts building the Dataset for a seed in the background on low priority threads.
+ * Any unfinished build for a different seed is cancelled. Does nothing if the seed is
+ * already current or being prepared.
+ *
+ * @param manager is a pointer to a randomx_epoch_manager structure. Must not be NULL.
+ * @param seed is a pointer to memory which contains the seed (Cache key). Must not be NULL.
+ * @param seedSize is the number of bytes of the seed.
+*/
+RANDOMX_EXPORT void randomx_epoch_manager_prepare(randomx_epoch_manager *manager, const void *seed, size_t seedSize);
+
+/**
+ * Makes the Dataset for a seed the current one. Waits for the build started by
+ * randomx_epoch_manager_prepare to finish or builds the Dataset synchronously if the seed
+ * was not prepared. The items a prepared build has not reached yet are initialized at
+ * normal priority while this function waits. The previous Dataset is released as soon as
+ * no registered VM uses it.
+ *
+ * @param manager is a pointer to a randomx_epoch_manager structure. Must not be NULL.
+ * @param seed is a pointer to memory which contains the seed (Cache key). Must not be NULL.
+ * @param seedSize is the number of bytes of the seed.
+ *
+ * @return 1 on success, 0 if the Cache or Dataset could not be allocated.
+*/
+RANDOMX_EXPORT int randomx_epoch_manager_activate(randomx_epoch_manager *manager, const void *seed, size_t seedSize);
+
+/**
+ * @param manager is a pointer to a randomx_epoch_manager structure. Must not be NULL.
+ *
+ * @return Pointer to the current Dataset or NULL if no seed was activated yet.
+ *         The pointer remains valid while the epoch is current or used by a registered VM.
+*/
+RANDOMX_EXPORT randomx_dataset *randomx_epoch_manager_get_dataset(randomx_epoch_manager *manager);
+
+/**
+ * Registers a virtual machine created with RANDOMX_FLAG_FULL_MEM with the epoch manager
+ * and switches it to the current Dataset.
+ *
+ * @param manager is a pointer to a randomx_epoch_manager structure. Must not be NULL.
+ * @param machine is a pointer to a randomx_vm structure. Must not be NULL.
+*/
+RANDOMX_EXPORT void randomx_epoch_manager_register_vm(randomx_epoch_manager *manager, randomx_vm *machine);
+
+/**
+ * Unregisters a virtual machine. Must be called before the VM is destroyed.
+ *
+ * @param manager is a pointer to a randomx_epoch_manager structure. Must not be NULL.
+ * @param machine is a pointer to a registered randomx_vm structure. Must not be NULL.
+*/
+RANDOMX_EXPORT void randomx_epoch_manager_unregister_vm(randomx_epoch_manager *manager, randomx_vm *machine);
+
+/**
+ * Switches a registered virtual machine to the current Dataset if a new epoch was
+ * activated since the last call. Must be called by the thread that uses the VM between
+ * hash calculations (it must not run concurrently with randomx_calculate_hash* on the VM).
+ * The previous Dataset is released by the call that removes its last user.
+ *
+ * @param manager is a pointer to a randomx_epoch_manager structure. Must not be NULL.
+ * @param machine is a pointer to a registered randomx_vm structure. Must not be NULL.
+ *
+ * @return 1 if the VM was switched to a new Dataset, 0 otherwise.
+*/
+RANDOMX_EXPORT int randomx_epoch_manager_sync_vm(randomx_epoch_manager *manager, randomx_vm *machine);
+
+/**
+ * Cancels any background build and releases all Datasets owned by the epoch manager.
+ * Registered VMs must not be used with these Datasets afterwards.
+ *
+ * @param manager is a pointer to a randomx_epoch_manager structure.
+*/
+RANDOMX_EXPORT void randomx_destroy_epoch_manager(randomx_epoch_manager *manager);
+
+/**
+ * Creates a cache registry, which owns one cache per seed and shares it between all users
+ * of that seed. Unreferenced caches are kept until the memory budget is needed for another
+ * seed, in which case the least recently used one is released.
+ *
+ * @param flags is the flags used to allocate the caches (see randomx_alloc_cache).
+ * @param memoryBudget is the maximum memory used by the caches in bytes. At least one
+ *        cache is always allowed.
+ * @param initThreads is the number of threads used to initialize each cache.
+ *
+ * @return Pointer to a new randomx_cache_registry structure.
+ *         NULL is returned if the registry cannot be created.
+*/
+RANDOMX_EXPORT randomx_cache_registry *randomx_create_cache_registry(randomx_flags flags, size_t memoryBudget, unsigned int initThreads);
+
+/**
+ * Starts initializing the cache of a seed in a background thread. Returns immediately.
+ *
+ * @param registry is a pointer to a randomx_cache_registry structure. Must not be NULL.
+ * @param seed is a pointer to the seed. Must not be NULL if seedSize > 0.
+ * @param seedSize is the size of the seed in bytes.
+ *
+ * @return 1 if the cache is ready or being initialized, 0 if the memory budget is taken
+ *         by referenced caches or allocation fails.
+*/
+RANDOMX_EXPORT int randomx_cache_registry_prepare(randomx_cache_registry *registry, const void *seed, size_t seedSize);
+
+/**
+ * Gets a reference to the cache of a seed, waiting for its initialization to finish.
+ * The cache must not be reinitialized or released by the caller.
+ *
+ * @param registry is a pointer to a randomx_cache_registry structure. Must not be NULL.
+ * @param seed is a pointer to the seed. Must not be NULL if seedSize > 0.
+ * @param seedSize is the size of the seed in bytes.
+ *
+ * @return Pointer to an initialized cache, valid until randomx_cache_registry_release is called.
+ *         NULL is returned if the memory budget is taken by referenced caches or allocation fails.
+*/
+RANDOMX_EXPORT randomx_cache *randomx_cache_registry_acquire(randomx_cache_registry *registry, const void *seed, size_t seedSize);
+
+/**
+ * Drops a reference obtained with randomx_cache_registry_acquire.
+ *
+ * @param registry is a pointer to a randomx_cache_registry structure. Must not be NULL.
+ * @param cache is a pointer returned by randomx_cache_registry_acquire.
+*/
+RANDOMX_EXPORT void randomx_cache_registry_release(randomx_cache_registry *registry, randomx_cache *cache);
+
+/**
+ * Switches a light-mode virtual machine to the cache of a seed. The registry holds a reference
+ * to the cache for the virtual machine and drops the reference to its previous cache.
+ *
+ * @param registry is a pointer to a randomx_cache_registry structure. Must not be NULL.
+ * @param machine is a pointer to a randomx_vm structure created without RANDOMX_FLAG_FULL_MEM.
+ *        Must not be NULL.
+ * @param seed is a pointer to the seed. Must not be NULL if seedSize > 0.
+ * @param seedSize is the size of the seed in bytes.
+ *
+ * @return 1 on success, 0 if the cache cannot be acquired (the VM is not changed).
+*/
+RANDOMX_EXPORT int randomx_cache_registry_attach_vm(randomx_cache_registry *registry, randomx_vm *machine, const void *seed, size_t seedSize);
+
+/**
+ * Drops the cache reference held for a virtual machine. Must be called before the
+ * virtual machine is destroyed.
+ *
+ * @param registry is a pointer to a randomx_cache_registry structure. Must not be NULL.
+ * @param machine is a pointer to a randomx_vm structure. Must not be NULL.
+*/
+RANDOMX_EXPORT void randomx_cache_registry_detach_vm(randomx_cache_registry *registry, randomx_vm *machine);
+
+/**
+ * Gets the number of caches currently owned by the registry, including the caches that
+ * are being initialized.
+ *
+ * @param registry is a pointer to a randomx_cache_registry structure. Must not be NULL.
+*/
+RANDOMX_EXPORT size_t randomx_cache_registry_count(randomx_cache_registry *registry);
+
+/**
+ * Waits for pending initializations and releases all caches owned by the registry.
+ * No cache of the registry may be used afterwards.
+ *
+ * @param registry is a pointer to a randomx_cache_registry structure.
+*/
+RANDOMX_EXPORT void randomx_destroy_cache_registry(randomx_cache_registry *registry);
+
+/**
+ * Creates a batch verifier, which owns a pool of worker threads with one virtual machine each.
+ * The virtual machines are created by the first call to randomx_verify_batch.
+ *
+ * @param flags is the flags used to create the virtual machines (see randomx_create_vm).
+ * @param threads is the number of threads used for verification, including the calling thread.
+ *        0 is treated as 1.
+ *
+ * @return Pointer to a new randomx_verifier structure.
+ *         NULL is returned if the verifier cannot be created.
+*/
+RANDOMX_EXPORT randomx_verifier *randomx_create_verifier(randomx_flags flags, unsigned int threads);
+
+/**
+ * Calculates the RandomX hashes of a batch of inputs and compares them with the expected hashes.
+ * In light mode, items are grouped by cache, so a batch may contain inputs of several seeds.
+ * The call blocks until all items have been verified.
+ *
+ * @param verifier is a pointer to a randomx_verifier structure. Must not be NULL.
+ * @param caches is an array of count cache pointers, one for each input. Caches must be initialized.
+ *        Ignored (can be NULL) if the verifier was created with RANDOMX_FLAG_FULL_MEM.
+ * @param dataset is the Dataset used by all inputs. Must not be NULL if the verifier was
+ *        created with RANDOMX_FLAG_FULL_MEM, ignored otherwise.
+ * @param inputs is an array of count pointers to the inputs. Must not be NULL.
+ * @param inputSizes is an array of count input sizes. Must not be NULL.
+ * @param expectedHashes is an array of count pointers to RANDOMX_HASH_SIZE-byte hashes. Must not be NULL.
+ * @param count is the number of items in the batch.
+ * @param results is an array of count bytes that receives 1 if the item hash matches the
+ *        expected hash and 0 otherwise. Must not be NULL.
+ * @param hashes is the output buffer for count * RANDOMX_HASH_SIZE bytes of calculated hashes.
+ *        Can be NULL.
+ *
+ * @return 1 on success, 0 if the virtual machines cannot be created.
+*/
+RANDOMX_EXPORT int randomx_verify_batch(randomx_verifier *verifier, randomx_cache * const *caches, randomx_dataset *dataset,
+	const void * const *inputs, const size_t *inputSizes, const void * const *expectedHashes, size_t count,
+	unsigned char *results, void *hashes);
+
+/**
+ * Stops the worker threads and destroys the virtual machines of a batch verifier.
+ *
+ * @param verifier is a pointer to a randomx_verifier structure.
+*/
+RANDOMX_EXPORT void randomx_destroy_verifier(randomx_verifier *verifier);
+
 #if defined(__cplusplus)
 }
 #endif
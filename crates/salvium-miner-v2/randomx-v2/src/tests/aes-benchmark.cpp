@@ -0,0 +1,88 @@
+/*
+Copyright (c) 2026, The Salvium Project
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in the
+	  documentation and/or other materials provided with the distribution.
+	* Neither the name of the copyright holder nor the
+	  names of its contributors may be used to endorse or promote products
+	  derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include <iostream>
+#include <iomanip>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "stopwatch.hpp"
+#include "utility.hpp"
+#include "../aes_hash.hpp"
+#include "../common.hpp"
+#include "../program.hpp"
+
+//Compares the AES-NI and VAES scratchpad kernels on a scratchpad-sized buffer.
+
+template<typename F>
+double measure(int iterations, F f) {
+	Stopwatch sw(true);
+	for (int i = 0; i < iterations; ++i)
+		f();
+	sw.stop();
+	return sw.getElapsed() * 1e6 / iterations;
+}
+
+static void report(const char* name, double aesni, double vaes, bool match) {
+	std::cout << "  " << std::setw(20) << std::left << name << std::right << std::fixed << std::setprecision(1)
+		<< std::setw(9) << aesni << " us";
+	if (vaes > 0)
+		std::cout << std::setw(9) << vaes << " us  (" << std::setprecision(2) << aesni / vaes << "x)" << (match ? "" : "  MISMATCH");
+	std::cout << std::endl;
+}
+
+int main(int argc, char** argv) {
+	int iterations;
+	readIntOption("--iterations", argc, argv, iterations, 1000);
+
+	const bool vaes = hasVaesAesHash();
+	std::vector<uint8_t> buffer1(randomx::ScratchpadSize), buffer2(randomx::ScratchpadSize);
+	alignas(16) uint8_t state1[64], state2[64], hash1[64], hash2[64];
+	alignas(64) randomx::Program program1, program2;
+	for (unsigned i = 0; i < sizeof(state1); ++i)
+		state1[i] = (uint8_t)i;
+
+	std::cout << "AES-NI vs VAES" << (vaes ? "" : " (VAES not available)") << ", " << iterations << " iterations:" << std::endl;
+
+	double t1, t2 = 0;
+	fillAes1Rx4<false>(state1, buffer1.size(), buffer1.data());
+	buffer2 = buffer1;
+	t1 = measure(iterations, [&]() { hashAes1Rx4<false>(buffer1.data(), buffer1.size(), hash1); });
+	if (vaes)
+		t2 = measure(iterations, [&]() { hashAes1Rx4Vaes(buffer2.data(), buffer2.size(), hash2); });
+	report("hashAes1Rx4", t1, t2, memcmp(hash1, hash2, sizeof(hash1)) == 0);
+
+	memcpy(state2, state1, sizeof(state1));
+	t1 = measure(iterations * 100, [&]() { fillAes4Rx4<false>(state1, sizeof(program1), &program1); });
+	if (vaes)
+		t2 = measure(iterations * 100, [&]() { fillAes4Rx4Vaes(state2, sizeof(program2), &program2); });
+	report("fillAes4Rx4", t1, t2, memcmp(&program1, &program2, sizeof(program1)) == 0);
+
+	return 0;
+}
@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <fstream>
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
 #include <exception>
 #include <string>
 #include <vector>
@@ -41,6 +42,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "../blake2/endian.h"
 #include "../common.hpp"
 #include "../jit_compiler.hpp"
+#include "../aes_hash.hpp"
 #ifdef _WIN32
 #include <windows.h>
 #include <versionhelpers.h>
@@ -85,18 +87,42 @@ void printUsage(const char* executable) {
 	std::cout << "  --verify      verification mode: 256 MiB" << std::endl;
 	std::cout << "  --jit         JIT compiled mode (default: interpreter)" << std::endl;
 	std::cout << "  --secure      W^X policy for JIT pages (default: off)" << std::endl;
+	std::cout << "  --dualMap     with --secure, map JIT pages twice instead of switching protections" << std::endl;
 	std::cout << "  --largePages  use large pages (default: small pages)" << std::endl;
 	std::cout << "  --softAes     use software AES (default: hardware AES)" << std::endl;
 	std::cout << "  --threads T   use T threads (default: 1)" << std::endl;
 	std::cout << "  --affinity A  thread affinity bitmask (default: 0)" << std::endl;
 	std::cout << "  --init Q      initialize dataset with Q threads (default: 1)" << std::endl;
+	std::cout << "  --cacheInit C initialize cache with C threads (default: 1)" << std::endl;
 	std::cout << "  --nonces N    run N nonces (default: 1000)" << std::endl;
 	std::cout << "  --seed S      seed for cache initialization (default: 0)" << std::endl;
 	std::cout << "  --ssse3       use optimized Argon2 for SSSE3 CPUs" << std::endl;
 	std::cout << "  --avx2        use optimized Argon2 for AVX2 CPUs" << std::endl;
+	std::cout << "  --neon        use optimized Argon2 for 64-bit ARM CPUs" << std::endl;
 	std::cout << "  --auto        select the best options for the current CPU" << std::endl;
 	std::cout << "  --noBatch     calculate hashes one by one (default: batch)" << std::endl;
 	std::cout << "  --commit      calculate commitments instead of hashes (default: hashes)" << std::endl;
+	std::cout << "  --datasetFile F  load the dataset from file F if valid, otherwise initialize and save it" << std::endl;
+	std::cout << "  --numa        one dataset replica per NUMA node, threads bound round-robin to nodes" << std::endl;
+	std::cout << "  --interleave L  calculate L = 2 or 4 hashes at once per thread (--mine --jit only)" << std::endl;
+	std::cout << "  --vaes        use VAES for scratchpad hash and program generation if supported (hardware AES only)" << std::endl;
+	std::cout << "  --itemMemo M  memoize computed dataset items in M MiB (--verify only)" << std::endl;
+	std::cout << "  --verifyBatch verify all nonces with one randomx_verify_batch call on T threads" << std::endl;
+}
+
+const char* pageTypeName(randomx_page_type type) {
+	switch (type) {
+	case RANDOMX_PAGES_SMALL:
+		return "small";
+	case RANDOMX_PAGES_TRANSPARENT:
+		return "transparent huge";
+	case RANDOMX_PAGES_2MB:
+		return "2 MiB";
+	case RANDOMX_PAGES_1GB:
+		return "1 GiB";
+	default:
+		return "none";
+	}
 }
 
 struct MemoryException : public std::exception {
@@ -112,16 +138,27 @@ struct DatasetAllocException : public MemoryException {
 	}
 };
 
-using MineFunc = void(randomx_vm * vm, std::atomic<uint32_t> & atomicNonce, AtomicHash & result, uint32_t noncesCount, int thread, int cpuid);
+//hashes calculated by one thread, padded so that no two threads write to the same cache line
+struct HashCount {
+	uint32_t value = 0;
+	char padding[64 - sizeof(uint32_t)];
+};
+
+using MineFunc = void(randomx_vm * vm, std::atomic<uint32_t> & atomicNonce, AtomicHash & result, uint32_t noncesCount, int thread, int cpuid, int node, uint32_t & hashCount);
 
 template<bool batch, bool commit>
-void mine(randomx_vm* vm, std::atomic<uint32_t>& atomicNonce, AtomicHash& result, uint32_t noncesCount, int thread, int cpuid = -1) {
+void mine(randomx_vm* vm, std::atomic<uint32_t>& atomicNonce, AtomicHash& result, uint32_t noncesCount, int thread, int cpuid, int node, uint32_t& hashCount) {
 	if (cpuid >= 0) {
 		int rc = set_thread_affinity(cpuid);
 		if (rc) {
 			std::cerr << "Failed to set thread affinity for thread " << thread << " (error=" << rc << ")" << std::endl;
 		}
 	}
+	else if (node >= 0) {
+		if (!randomx_numa_bind_thread(node)) {
+			std::cerr << "Failed to bind thread " << thread << " to NUMA node " << node << std::endl;
+		}
+	}
 	uint64_t hash[RANDOMX_HASH_SIZE / sizeof(uint64_t)];
 	uint8_t blockTemplate[sizeof(blockTemplate_)];
 	memcpy(blockTemplate, blockTemplate_, sizeof(blockTemplate));
@@ -143,19 +180,129 @@ void mine(randomx_vm* vm, std::atomic<uint32_t>& atomicNonce, AtomicHash& result
 			randomx_calculate_commitment(blockTemplate, sizeof(blockTemplate), &hash, &hash);
 		}
 		result.xorWith(hash);
+		hashCount++;
 		if (!batch) {
 			nonce = atomicNonce.fetch_add(1);
 		}
 	}
 }
 
+template<uint32_t lanes>
+void mineInterleaved(randomx_vm* vm, std::atomic<uint32_t>& atomicNonce, AtomicHash& result, uint32_t noncesCount, int thread, int cpuid, int node, uint32_t& hashCount) {
+	if (cpuid >= 0) {
+		int rc = set_thread_affinity(cpuid);
+		if (rc) {
+			std::cerr << "Failed to set thread affinity for thread " << thread << " (error=" << rc << ")" << std::endl;
+		}
+	}
+	else if (node >= 0) {
+		if (!randomx_numa_bind_thread(node)) {
+			std::cerr << "Failed to bind thread " << thread << " to NUMA node " << node << std::endl;
+		}
+	}
+	uint64_t hashes[lanes][RANDOMX_HASH_SIZE / sizeof(uint64_t)];
+	auto nonce = atomicNonce.fetch_add(lanes);
+
+	while (nonce < noncesCount) {
+		uint32_t count = std::min(lanes, noncesCount - nonce);
+		randomx_calculate_hash_batch(vm, blockTemplate_, sizeof(blockTemplate_), 39, nonce, count, hashes, 0);
+		for (uint32_t k = 0; k < count; ++k) {
+			result.xorWith(hashes[k]);
+		}
+		hashCount += count;
+		nonce = atomicNonce.fetch_add(lanes);
+	}
+}
+
+double verifyBatch(randomx_flags flags, randomx_cache* cache, randomx_dataset* dataset, uint32_t noncesCount, unsigned threadCount, AtomicHash& result) {
+	std::vector<uint8_t> blockTemplates(noncesCount * sizeof(blockTemplate_));
+	std::vector<const void*> inputs(noncesCount);
+	std::vector<size_t> inputSizes(noncesCount, sizeof(blockTemplate_));
+	std::vector<randomx_cache*> caches(noncesCount, cache);
+	std::vector<uint8_t> hashes(noncesCount * RANDOMX_HASH_SIZE);
+	std::vector<const void*> expectedHashes(noncesCount);
+	std::vector<uint8_t> results(noncesCount);
+	uint8_t zeroHash[RANDOMX_HASH_SIZE] = { 0 };
+	for (uint32_t nonce = 0; nonce < noncesCount; ++nonce) {
+		uint8_t* blockTemplate = &blockTemplates[nonce * sizeof(blockTemplate_)];
+		memcpy(blockTemplate, blockTemplate_, sizeof(blockTemplate_));
+		store32(blockTemplate + 39, nonce);
+		inputs[nonce] = blockTemplate;
+		expectedHashes[nonce] = zeroHash;
+	}
+	randomx_verifier* verifier = randomx_create_verifier(flags, threadCount);
+	if (verifier == nullptr) {
+		throw std::runtime_error("Cannot create verifier");
+	}
+	//the first pass creates the VMs and calculates the expected hashes
+	if (!randomx_verify_batch(verifier, caches.data(), dataset, inputs.data(), inputSizes.data(), expectedHashes.data(), noncesCount, results.data(), hashes.data())) {
+		randomx_destroy_verifier(verifier);
+		throw std::runtime_error("Cannot create VM");
+	}
+	for (uint32_t nonce = 0; nonce < noncesCount; ++nonce) {
+		result.xorWith((uint64_t*)&hashes[nonce * RANDOMX_HASH_SIZE]);
+		expectedHashes[nonce] = &hashes[nonce * RANDOMX_HASH_SIZE];
+	}
+	Stopwatch sw(true);
+	randomx_verify_batch(verifier, caches.data(), dataset, inputs.data(), inputSizes.data(), expectedHashes.data(), noncesCount, results.data(), nullptr);
+	double elapsed = sw.getElapsed();
+	randomx_destroy_verifier(verifier);
+	uint32_t failed = 0;
+	for (uint32_t nonce = 0; nonce < noncesCount; ++nonce) {
+		failed += results[nonce] == 0;
+	}
+	if (failed != 0) {
+		std::cout << "ERROR: " << failed << " hash(es) failed verification" << std::endl;
+	}
+	return elapsed;
+}
+
+//prints the per-phase breakdown if the library was built with RANDOMX_VM_STATS
+static void printVmStats(const std::vector<randomx_vm*>& vms) {
+	randomx_vm_stats total = {};
+	for (auto vm : vms) {
+		randomx_vm_stats stats;
+		if (!randomx_vm_get_stats(vm, &stats))
+			return;
+		total.hashes += stats.hashes;
+		total.initScratchpad += stats.initScratchpad;
+		total.generateProgram += stats.generateProgram;
+		total.compile += stats.compile;
+		total.execute += stats.execute;
+		total.blake2bChain += stats.blake2bChain;
+		total.finalResult += stats.finalResult;
+	}
+	if (total.hashes == 0)
+		return;
+	const std::pair<const char*, uint64_t> phases[] = {
+		{ "initScratchpad", total.initScratchpad },
+		{ "generateProgram", total.generateProgram },
+		{ "compile", total.compile },
+		{ "execute", total.execute },
+		{ "blake2bChain", total.blake2bChain },
+		{ "finalResult", total.finalResult },
+	};
+	uint64_t sum = 0;
+	for (auto& phase : phases)
+		sum += phase.second;
+	const auto precision = std::cout.precision();
+	std::cout << "VM phases (ticks per hash):" << std::endl;
+	for (auto& phase : phases) {
+		std::cout << " - " << std::left << std::setw(16) << phase.first << std::right << std::setw(10) << phase.second / total.hashes;
+		std::cout << " (" << std::fixed << std::setprecision(1) << 100.0 * phase.second / sum << "%)" << std::endl;
+	}
+	std::cout.unsetf(std::ios::floatfield);
+	std::cout.precision(precision);
+}
+
 int main(int argc, char** argv) {
 	bool softAes, miningMode, verificationMode, help, largePages, jit, secure, commit;
-	bool ssse3, avx2, autoFlags, noBatch;
-	int noncesCount, threadCount, initThreadCount;
+	bool ssse3, avx2, neon, autoFlags, noBatch, numa, vaes, dualMap, batchVerification;
+	int noncesCount, threadCount, initThreadCount, cacheThreadCount, interleaveLanes, itemMemoSize;
 	uint64_t threadAffinity;
 	int32_t seedValue;
 	char seed[4];
+	const char* datasetFile;
 
 	readOption("--softAes", argc, argv, softAes);
 	readOption("--mine", argc, argv, miningMode);
@@ -164,6 +311,7 @@ int main(int argc, char** argv) {
 	readUInt64Option("--affinity", argc, argv, threadAffinity, 0);
 	readIntOption("--nonces", argc, argv, noncesCount, 1000);
 	readIntOption("--init", argc, argv, initThreadCount, 1);
+	readIntOption("--cacheInit", argc, argv, cacheThreadCount, 1);
 	readIntOption("--seed", argc, argv, seedValue, 0);
 	readOption("--largePages", argc, argv, largePages);
 	if (!largePages) {
@@ -172,11 +320,19 @@ int main(int argc, char** argv) {
 	readOption("--jit", argc, argv, jit);
 	readOption("--help", argc, argv, help);
 	readOption("--secure", argc, argv, secure);
+	readOption("--dualMap", argc, argv, dualMap);
 	readOption("--ssse3", argc, argv, ssse3);
 	readOption("--avx2", argc, argv, avx2);
+	readOption("--neon", argc, argv, neon);
 	readOption("--auto", argc, argv, autoFlags);
 	readOption("--noBatch", argc, argv, noBatch);
 	readOption("--commit", argc, argv, commit);
+	readStringOption("--datasetFile", argc, argv, datasetFile, nullptr);
+	readOption("--numa", argc, argv, numa);
+	readOption("--vaes", argc, argv, vaes);
+	readIntOption("--interleave", argc, argv, interleaveLanes, 1);
+	readIntOption("--itemMemo", argc, argv, itemMemoSize, 0);
+	readOption("--verifyBatch", argc, argv, batchVerification);
 
 	store32(&seed, seedValue);
 
@@ -197,6 +353,8 @@ int main(int argc, char** argv) {
 	AtomicHash result;
 	std::vector<randomx_vm*> vms;
 	std::vector<std::thread> threads;
+	std::vector<HashCount> hashCounts;
+	std::vector<randomx_dataset*> replicas;
 	randomx_dataset* dataset;
 	randomx_cache* cache;
 	randomx_flags flags;
@@ -213,6 +371,9 @@ int main(int argc, char** argv) {
 		if (avx2) {
 			flags |= RANDOMX_FLAG_ARGON2_AVX2;
 		}
+		if (neon) {
+			flags |= RANDOMX_FLAG_ARGON2_NEON;
+		}
 		if (!softAes) {
 			flags |= RANDOMX_FLAG_HARD_AES;
 		}
@@ -224,9 +385,25 @@ int main(int argc, char** argv) {
 		}
 	}
 
+	if (interleaveLanes == 4) {
+		flags |= RANDOMX_FLAG_INTERLEAVE_4;
+	}
+	else if (interleaveLanes == 2) {
+		flags |= RANDOMX_FLAG_INTERLEAVE_2;
+	}
+	else {
+		interleaveLanes = 1;
+	}
+
 	if (largePages) {
 		flags |= RANDOMX_FLAG_LARGE_PAGES;
 	}
+	if (vaes) {
+		flags |= RANDOMX_FLAG_VAES;
+	}
+	if (dualMap) {
+		flags |= RANDOMX_FLAG_DUAL_MAP;
+	}
 	if (miningMode) {
 		flags |= RANDOMX_FLAG_FULL_MEM;
 	}
@@ -242,6 +419,9 @@ int main(int argc, char** argv) {
 	else if (flags & RANDOMX_FLAG_ARGON2_SSSE3) {
 		std::cout << " - Argon2 implementation: SSSE3" << std::endl;
 	}
+	else if (flags & RANDOMX_FLAG_ARGON2_NEON) {
+		std::cout << " - Argon2 implementation: NEON" << std::endl;
+	}
 	else {
 		std::cout << " - Argon2 implementation: reference" << std::endl;
 	}
@@ -255,7 +435,10 @@ int main(int argc, char** argv) {
 
 	if (flags & RANDOMX_FLAG_JIT) {
 		std::cout << " - JIT compiled mode ";
-		if (flags & RANDOMX_FLAG_SECURE) {
+		if ((flags & RANDOMX_FLAG_SECURE) && (flags & RANDOMX_FLAG_DUAL_MAP)) {
+			std::cout << "(secure, dual-mapped)";
+		}
+		else if (flags & RANDOMX_FLAG_SECURE) {
 			std::cout << "(secure)";
 		}
 		std::cout << std::endl;
@@ -265,7 +448,7 @@ int main(int argc, char** argv) {
 	}
 
 	if (flags & RANDOMX_FLAG_HARD_AES) {
-		std::cout << " - hardware AES mode" << std::endl;
+		std::cout << " - hardware AES mode" << ((flags & RANDOMX_FLAG_VAES) ? " (VAES)" : (RANDOMX_ARMV8_AES_HASH ? " (ARMv8 CE)" : "")) << std::endl;
 	}
 	else {
 		std::cout << " - software AES mode" << std::endl;
@@ -282,9 +465,22 @@ int main(int argc, char** argv) {
 		std::cout << " - thread affinity (" << mask_to_string(threadAffinity) << ")" << std::endl;
 	}
 
+	unsigned numaNodes = 1;
+	if (numa && miningMode) {
+		numaNodes = randomx_numa_node_count();
+		std::cout << " - NUMA mode (" << numaNodes << " node" << (numaNodes > 1 ? "s)" : ")") << std::endl;
+	}
+	else {
+		numa = false;
+	}
+
 	MineFunc* func;
 
-	if (noBatch) {
+	if (interleaveLanes > 1 && miningMode && (flags & RANDOMX_FLAG_JIT) && !commit) {
+		std::cout << " - " << interleaveLanes << "-way interleaved mode" << std::endl;
+		func = interleaveLanes == 4 ? &mineInterleaved<4> : &mineInterleaved<2>;
+	}
+	else if (noBatch) {
 		if (commit) {
 			std::cout << " - hash commitments" << std::endl;
 			func = &mine<false, true>;
@@ -322,12 +518,55 @@ int main(int argc, char** argv) {
 		}
 
 		Stopwatch sw(true);
-		cache = randomx_alloc_cache(flags);
-		if (cache == nullptr) {
-			throw CacheAllocException();
+		dataset = nullptr;
+		cache = nullptr;
+		bool datasetLoaded = false;
+		if (miningMode && datasetFile != nullptr && !numa) {
+			dataset = randomx_dataset_map(datasetFile, &seed, sizeof(seed), flags);
+			datasetLoaded = dataset != nullptr;
+			if (datasetLoaded) {
+				std::cout << "Dataset loaded from " << datasetFile << std::endl;
+			}
+		}
+		if (dataset == nullptr) {
+			cache = randomx_alloc_cache(flags);
+			if (cache == nullptr) {
+				throw CacheAllocException();
+			}
+			randomx_init_cache_parallel(cache, &seed, sizeof(seed), cacheThreadCount);
+			std::cout << "Cache initialized in " << sw.getElapsed() << " s";
+			if (cacheThreadCount > 1)
+				std::cout << " (" << cacheThreadCount << " threads)";
+			std::cout << std::endl;
+			if (!miningMode && itemMemoSize > 0) {
+				if (!randomx_cache_set_item_memo(cache, (size_t)itemMemoSize * 1024 * 1024)) {
+					throw std::runtime_error("Cannot allocate the dataset item memo");
+				}
+				std::cout << "Dataset item memo: " << itemMemoSize << " MiB" << std::endl;
+			}
 		}
-		randomx_init_cache(cache, &seed, sizeof(seed));
-		if (miningMode) {
+		if (numa) {
+			auto threadsPerNode = std::max(1, initThreadCount / (int)numaNodes);
+			for (unsigned node = 0; node < numaNodes; ++node) {
+				randomx_dataset* replica = randomx_alloc_dataset_numa(flags, node);
+				if (replica == nullptr) {
+					throw DatasetAllocException();
+				}
+				replicas.push_back(replica);
+			}
+			//all replicas are initialized at the same time, each by the threads of its node
+			for (unsigned node = 0; node < numaNodes; ++node) {
+				threads.push_back(std::thread(&randomx_init_dataset_numa, replicas[node], cache, node, threadsPerNode));
+			}
+			for (unsigned i = 0; i < threads.size(); ++i) {
+				threads[i].join();
+			}
+			threads.clear();
+			dataset = replicas[0];
+			randomx_release_cache(cache);
+			cache = nullptr;
+		}
+		if (miningMode && dataset == nullptr) {
 			dataset = randomx_alloc_dataset(flags);
 			if (dataset == nullptr) {
 				throw DatasetAllocException();
@@ -354,44 +593,78 @@ int main(int argc, char** argv) {
 			threads.clear();
 		}
 		std::cout << "Memory initialized in " << sw.getElapsed() << " s" << std::endl;
-		std::cout << "Initializing " << threadCount << " virtual machine(s) ..." << std::endl;
-		for (int i = 0; i < threadCount; ++i) {
-			randomx_vm *vm = randomx_create_vm(flags, cache, dataset);
-			if (vm == nullptr) {
-				if ((flags & RANDOMX_FLAG_HARD_AES)) {
-					throw std::runtime_error("Cannot create VM with the selected options. Try using --softAes");
-				}
-				if (largePages) {
-					throw std::runtime_error("Cannot create VM with the selected options. Try without --largePages");
+		if (miningMode && datasetFile != nullptr && !datasetLoaded && !numa) {
+			if (!randomx_dataset_save(dataset, datasetFile, &seed, sizeof(seed))) {
+				std::cout << "WARNING: Failed to save the dataset to " << datasetFile << std::endl;
+			}
+		}
+		double elapsed;
+		if (batchVerification) {
+			std::cout << "Running batch verification (" << noncesCount << " nonces, " << threadCount << " thread(s)) ..." << std::endl;
+			elapsed = verifyBatch(flags, cache, dataset, noncesCount, threadCount, result);
+		}
+		else {
+			std::cout << "Initializing " << threadCount << " virtual machine(s) ..." << std::endl;
+			for (int i = 0; i < threadCount; ++i) {
+				randomx_vm *vm = randomx_create_vm(flags, cache, numa ? replicas[i % numaNodes] : dataset);
+				if (vm == nullptr) {
+					if ((flags & RANDOMX_FLAG_HARD_AES)) {
+						throw std::runtime_error("Cannot create VM with the selected options. Try using --softAes");
+					}
+					if (largePages) {
+						throw std::runtime_error("Cannot create VM with the selected options. Try without --largePages");
+					}
+					throw std::runtime_error("Cannot create VM");
 				}
-				throw std::runtime_error("Cannot create VM");
+				vms.push_back(vm);
 			}
-			vms.push_back(vm);
-		}
-		std::cout << "Running benchmark (" << noncesCount << " nonces) ..." << std::endl;
-		sw.restart();
-		if (threadCount > 1) {
-			for (unsigned i = 0; i < vms.size(); ++i) {
-				int cpuid = -1;
-				if (threadAffinity)
-					cpuid = cpuid_from_mask(threadAffinity, i);
-				threads.push_back(std::thread(func, vms[i], std::ref(atomicNonce), std::ref(result), noncesCount, i, cpuid));
+			if (largePages) {
+				randomx_memory_info memoryInfo;
+				randomx_get_memory_info(&memoryInfo, cache, dataset, vms[0]);
+				std::cout << "Memory pages: " << (miningMode ? "dataset " : "cache ");
+				std::cout << pageTypeName(miningMode ? memoryInfo.dataset : memoryInfo.cache);
+				std::cout << ", scratchpad " << pageTypeName(memoryInfo.scratchpad) << std::endl;
 			}
-			for (unsigned i = 0; i < threads.size(); ++i) {
-				threads[i].join();
+			std::cout << "Running benchmark (" << noncesCount << " nonces) ..." << std::endl;
+			hashCounts.resize(vms.size());
+			sw.restart();
+			if (threadCount > 1) {
+				for (unsigned i = 0; i < vms.size(); ++i) {
+					int cpuid = -1;
+					if (threadAffinity)
+						cpuid = cpuid_from_mask(threadAffinity, i);
+					int node = numa ? (int)(i % numaNodes) : -1;
+					threads.push_back(std::thread(func, vms[i], std::ref(atomicNonce), std::ref(result), noncesCount, i, cpuid, node, std::ref(hashCounts[i].value)));
+				}
+				for (unsigned i = 0; i < threads.size(); ++i) {
+					threads[i].join();
+				}
 			}
+			else {
+				func(vms[0], std::ref(atomicNonce), std::ref(result), noncesCount, 0, -1, numa ? 0 : -1, std::ref(hashCounts[0].value));
+			}
+
+			elapsed = sw.getElapsed();
+			printVmStats(vms);
+			for (unsigned i = 0; i < vms.size(); ++i)
+				randomx_destroy_vm(vms[i]);
 		}
-		else {
-			func(vms[0], std::ref(atomicNonce), std::ref(result), noncesCount, 0, -1);
+		if (numa) {
+			for (auto replica : replicas)
+				randomx_release_dataset(replica);
 		}
-
-		double elapsed = sw.getElapsed();
-		for (unsigned i = 0; i < vms.size(); ++i)
-			randomx_destroy_vm(vms[i]);
-		if (miningMode)
+		else if (miningMode)
 			randomx_release_dataset(dataset);
-		else
+		else {
+			randomx_item_memo_stats memoStats;
+			randomx_cache_get_item_memo_stats(cache, &memoStats, 0);
+			if (memoStats.capacity != 0) {
+				uint64_t reads = memoStats.hits + memoStats.misses;
+				std::cout << "Dataset item memo: " << memoStats.hits << " hits, " << memoStats.misses << " misses";
+				std::cout << " (" << (reads ? 100.0 * memoStats.hits / reads : 0.0) << "% hit rate)" << std::endl;
+			}
 			randomx_release_cache(cache);
+		}
 		std::cout << "Calculated result: ";
 		result.print(std::cout);
 		if (noncesCount == 1000 && seedValue == 0 && !commit)
@@ -401,6 +674,14 @@ int main(int argc, char** argv) {
 		}
 		else {
 			std::cout << "Performance: " << noncesCount / elapsed << " hashes per second" << std::endl;
+			if (numa) {
+				for (unsigned node = 0; node < numaNodes; ++node) {
+					uint64_t nodeHashes = 0;
+					for (unsigned i = node; i < hashCounts.size(); i += numaNodes)
+						nodeHashes += hashCounts[i].value;
+					std::cout << " - node " << node << ": " << nodeHashes / elapsed << " hashes per second" << std::endl;
+				}
+			}
 		}
 	}
 	catch (MemoryException& e) {
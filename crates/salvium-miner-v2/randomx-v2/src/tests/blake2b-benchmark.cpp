@@ -0,0 +1,91 @@
+/*
+Copyright (c) 2026, The Salvium Project
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in the
+	  documentation and/or other materials provided with the distribution.
+	* Neither the name of the copyright holder nor the
+	  names of its contributors may be used to endorse or promote products
+	  derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include <iostream>
+#include <iomanip>
+#include <cstdint>
+#include <cstring>
+#include "stopwatch.hpp"
+#include "utility.hpp"
+#include "../blake2/blake2.h"
+#include "../common.hpp"
+
+//Hashes the same inputs as randomx_calculate_hash with every Blake2b implementation available.
+int main(int argc, char** argv) {
+	int iterations;
+	readIntOption("--iterations", argc, argv, iterations, 1000000);
+
+	const struct {
+		blake2b_impl impl;
+		const char* name;
+	} impls[] = {
+		{ BLAKE2B_IMPL_REF, "reference" },
+		{ BLAKE2B_IMPL_SSE41, "SSE4.1" },
+		{ BLAKE2B_IMPL_AVX2, "AVX2" },
+		{ BLAKE2B_IMPL_NEON, "NEON" },
+	};
+	const struct {
+		size_t size;
+		const char* name;
+	} inputs[] = {
+		{ 76, "block template" },
+		{ sizeof(randomx::RegisterFile), "register file" },
+		{ 64, "generator state" },
+	};
+
+	uint8_t input[sizeof(randomx::RegisterFile)];
+	for (unsigned i = 0; i < sizeof(input); ++i)
+		input[i] = (uint8_t)i;
+
+	for (auto& in : inputs) {
+		std::cout << in.name << " (" << in.size << " bytes):" << std::endl;
+		uint8_t reference[64];
+		blake2b_set_impl(BLAKE2B_IMPL_REF);
+		blake2b(reference, sizeof(reference), input, in.size, nullptr, 0);
+		for (auto& impl : impls) {
+			if (blake2b_set_impl(impl.impl) != 0)
+				continue;
+			uint8_t hash[64];
+			memcpy(hash, input, sizeof(hash));
+			Stopwatch sw(true);
+			for (int i = 0; i < iterations; ++i) {
+				blake2b(hash, sizeof(hash), input, in.size, nullptr, 0);
+				input[0] ^= hash[0];
+			}
+			sw.stop();
+			input[0] = 0;
+			blake2b(hash, sizeof(hash), input, in.size, nullptr, 0);
+			std::cout << "  " << std::setw(10) << std::left << impl.name << std::right << std::fixed << std::setprecision(1)
+				<< std::setw(8) << sw.getElapsed() * 1e9 / iterations << " ns/hash"
+				<< (memcmp(hash, reference, sizeof(hash)) == 0 ? "" : "  MISMATCH") << std::endl;
+		}
+	}
+	blake2b_set_impl(BLAKE2B_IMPL_AUTO);
+	return 0;
+}
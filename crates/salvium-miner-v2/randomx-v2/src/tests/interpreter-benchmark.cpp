@@ -0,0 +1,112 @@
+/*
+Copyright (c) 2026, The Salvium Project
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in the
+	  documentation and/or other materials provided with the distribution.
+	* Neither the name of the copyright holder nor the
+	  names of its contributors may be used to endorse or promote products
+	  derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+
+#include <iostream>
+#include <iomanip>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "stopwatch.hpp"
+#include "utility.hpp"
+#include "../aes_hash.hpp"
+#include "../bytecode_machine.hpp"
+#include "../program.hpp"
+
+//Compares the switch and threaded bytecode interpreters on random programs.
+
+struct BenchmarkProgram {
+	randomx::InstructionByteCode bytecode[RANDOMX_PROGRAM_SIZE];
+	uint8_t dispatch[RANDOMX_PROGRAM_SIZE + 1];
+	alignas(16) randomx::ProgramConfiguration config;
+	randomx::NativeRegisterFile init;
+};
+
+template<typename F>
+double measure(std::vector<BenchmarkProgram>& programs, randomx::NativeRegisterFile& reg, int iterations, F f) {
+	Stopwatch sw(true);
+	for (auto& p : programs) {
+		for (int i = 0; i < iterations; ++i) {
+			reg = p.init;
+			f(p);
+		}
+	}
+	sw.stop();
+	rx_reset_float_state();
+	return sw.getElapsed() * 1e9 / ((double)programs.size() * iterations * RANDOMX_PROGRAM_SIZE);
+}
+
+int main(int argc, char** argv) {
+	int programCount, iterations;
+	readIntOption("--programs", argc, argv, programCount, 64);
+	readIntOption("--iterations", argc, argv, iterations, 2048);
+
+	std::vector<uint8_t> scratchpad(RANDOMX_SCRATCHPAD_L3);
+	std::vector<BenchmarkProgram> programs(programCount);
+	alignas(64) randomx::Program program;
+	alignas(16) uint8_t state[64] = { 0 };
+	randomx::NativeRegisterFile reg;
+	randomx::BytecodeMachine machine;
+	int fused = 0, specialized = 0;
+
+	fillAes1Rx4<false>(state, scratchpad.size(), scratchpad.data());
+
+	for (auto& p : programs) {
+		fillAes4Rx4<false>(state, sizeof(program), &program);
+		fillAes1Rx4<false>(state, sizeof(p.init), &p.init);
+		p.config.eMask[0] = (program.getEntropy(14) & 0x00F00000FFFFFFFF) | 0x3000000000000000;
+		p.config.eMask[1] = (program.getEntropy(15) & 0x00F00000FFFFFFFF) | 0x3000000000000000;
+		machine.compileProgram(program, p.bytecode, reg);
+		machine.threadBytecode(p.bytecode, p.dispatch);
+		for (int pc = 0; pc < RANDOMX_PROGRAM_SIZE; ++pc) {
+			fused += p.dispatch[pc] >= randomx::ThreadedFusedBase;
+			specialized += p.dispatch[pc] >= randomx::ThreadedSpecializedBase && p.dispatch[pc] < randomx::ThreadedFusedBase;
+		}
+	}
+
+	std::cout << "Bytecode interpreter, " << programCount << " programs x " << iterations << " iterations" << std::endl;
+	std::cout << std::fixed << std::setprecision(1);
+	std::cout << "Specialized instructions: " << specialized / (double)programCount << " per program" << std::endl;
+	std::cout << "Fused pairs: " << fused / (double)programCount << " per program" << std::endl;
+	if (!RANDOMX_COMPUTED_GOTO)
+		std::cout << "Computed goto not available, the threaded interpreter uses the switch" << std::endl;
+
+	double t1 = measure(programs, reg, iterations, [&](BenchmarkProgram& p) {
+		randomx::BytecodeMachine::executeBytecode(p.bytecode, scratchpad.data(), p.config);
+	});
+	double t2 = measure(programs, reg, iterations, [&](BenchmarkProgram& p) {
+		randomx::BytecodeMachine::executeBytecodeThreaded(p.bytecode, p.dispatch, scratchpad.data(), p.config);
+	});
+
+	std::cout << std::setprecision(2);
+	std::cout << "  switch:   " << std::setw(6) << t1 << " ns/instruction" << std::endl;
+	std::cout << "  threaded: " << std::setw(6) << t2 << " ns/instruction  (" << t1 / t2 << "x)" << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,477 @@
+/*
+Copyright (c) 2026, The Salvium Project
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in the
+	  documentation and/or other materials provided with the distribution.
+	* Neither the name of the copyright holder nor the
+	  names of its contributors may be used to endorse or promote products
+	  derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include "stopwatch.hpp"
+#include "utility.hpp"
+#include "../randomx.h"
+#include "../blake2/endian.h"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+//Runs the mining loop in each selected VM mode and collects hardware performance
+//counters of every thread through Linux perf_event. The results are printed as JSON
+//(progress goes to stderr). Counters that the kernel or the CPU does not provide
+//(e.g. inside most virtual machines) are reported as null.
+
+const uint8_t blockTemplate[] = {
+		0x07, 0x07, 0xf7, 0xa4, 0xf0, 0xd6, 0x05, 0xb3, 0x03, 0x26, 0x08, 0x16, 0xba, 0x3f, 0x10, 0x90, 0x2e, 0x1a, 0x14,
+		0x5a, 0xc5, 0xfa, 0xd3, 0xaa, 0x3a, 0xf6, 0xea, 0x44, 0xc1, 0x18, 0x69, 0xdc, 0x4f, 0x85, 0x3f, 0x00, 0x2b, 0x2e,
+		0xea, 0x00, 0x00, 0x00, 0x00, 0x77, 0xb2, 0x06, 0xa0, 0x2c, 0xa5, 0xb1, 0xd4, 0xce, 0x6b, 0xbf, 0xdf, 0x0a, 0xca,
+		0xc3, 0x8b, 0xde, 0xd3, 0x4d, 0x2d, 0xcd, 0xee, 0xf9, 0x5c, 0xd2, 0x0c, 0xef, 0xc1, 0x2f, 0x61, 0xd5, 0x61, 0x09
+};
+
+enum Counter {
+	Cycles,
+	Instructions,
+	L1dMisses,
+	L2Misses,
+	L3Misses,
+	DtlbMisses,
+	BranchMisses,
+	TaskClock,
+	CounterCount
+};
+
+static const char* counterNames[CounterCount] = {
+	"cycles", "instructions", "l1dMisses", "l2Misses", "l3Misses", "dtlbMisses", "branchMisses", "taskClockNs"
+};
+
+constexpr int64_t CounterUnavailable = -1;
+
+//There is no generic L2 miss event, so it is only counted with a raw event code (--l2Event)
+static uint64_t l2RawEvent = 0;
+
+class PerfCounters {
+public:
+	PerfCounters() {
+		for (int i = 0; i < CounterCount; ++i)
+			fds[i] = -1;
+	}
+	~PerfCounters() {
+#if defined(__linux__)
+		for (int i = 0; i < CounterCount; ++i) {
+			if (fds[i] >= 0)
+				close(fds[i]);
+		}
+#endif
+	}
+	PerfCounters(const PerfCounters&) = delete;
+	PerfCounters& operator=(const PerfCounters&) = delete;
+
+	//counts the calling thread in user mode
+	void open() {
+#if defined(__linux__)
+		const uint64_t cacheReadMiss = (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+		fds[Cycles] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+		fds[Instructions] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+		fds[L1dMisses] = openEvent(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | cacheReadMiss);
+		if (l2RawEvent != 0)
+			fds[L2Misses] = openEvent(PERF_TYPE_RAW, l2RawEvent);
+		fds[L3Misses] = openEvent(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL | cacheReadMiss);
+		fds[DtlbMisses] = openEvent(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | cacheReadMiss);
+		fds[BranchMisses] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+		fds[TaskClock] = openEvent(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK);
+#endif
+	}
+
+	void start() {
+#if defined(__linux__)
+		for (int i = 0; i < CounterCount; ++i) {
+			if (fds[i] >= 0) {
+				ioctl(fds[i], PERF_EVENT_IOC_RESET, 0);
+				ioctl(fds[i], PERF_EVENT_IOC_ENABLE, 0);
+			}
+		}
+#endif
+	}
+
+	void stop() {
+#if defined(__linux__)
+		for (int i = 0; i < CounterCount; ++i) {
+			if (fds[i] >= 0)
+				ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+		}
+#endif
+	}
+
+	//values are scaled if the kernel had to multiplex the counters
+	void read(int64_t (&values)[CounterCount]) {
+		for (int i = 0; i < CounterCount; ++i) {
+			values[i] = CounterUnavailable;
+#if defined(__linux__)
+			uint64_t data[3];
+			if (fds[i] >= 0 && ::read(fds[i], data, sizeof(data)) == sizeof(data) && data[2] != 0) {
+				values[i] = (int64_t)(data[2] == data[1] ? data[0] : (double)data[0] * data[1] / data[2]);
+			}
+#endif
+		}
+	}
+private:
+#if defined(__linux__)
+	static int openEvent(uint32_t type, uint64_t config) {
+		perf_event_attr attr;
+		memset(&attr, 0, sizeof(attr));
+		attr.size = sizeof(attr);
+		attr.type = type;
+		attr.config = config;
+		attr.disabled = 1;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+		return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+	}
+#endif
+	int fds[CounterCount];
+};
+
+struct Mode {
+	bool jit;
+	bool fullMem;
+	bool largePages;
+	bool hardAes;
+};
+
+struct ThreadResult {
+	uint64_t hashes = 0;
+	int64_t counters[CounterCount];
+};
+
+static void mine(randomx_vm* vm, std::atomic<uint32_t>& atomicNonce, uint32_t noncesCount, ThreadResult& result) {
+	PerfCounters perf;
+	perf.open();
+	uint8_t blob[sizeof(blockTemplate)];
+	memcpy(blob, blockTemplate, sizeof(blob));
+	void* noncePtr = blob + 39;
+	uint64_t hash[RANDOMX_HASH_SIZE / sizeof(uint64_t)];
+
+	perf.start();
+	auto nonce = atomicNonce.fetch_add(1);
+	if (nonce < noncesCount) {
+		store32(noncePtr, nonce);
+		randomx_calculate_hash_first(vm, blob, sizeof(blob));
+		while (true) {
+			nonce = atomicNonce.fetch_add(1);
+			if (nonce >= noncesCount)
+				break;
+			store32(noncePtr, nonce);
+			randomx_calculate_hash_next(vm, blob, sizeof(blob), &hash);
+			result.hashes++;
+		}
+		randomx_calculate_hash_last(vm, &hash);
+		result.hashes++;
+	}
+	perf.stop();
+	perf.read(result.counters);
+}
+
+static void initDataset(randomx_dataset* dataset, randomx_cache* cache, unsigned threadCount) {
+	const uint32_t itemCount = randomx_dataset_item_count();
+	std::vector<std::thread> threads;
+	uint32_t start = 0;
+	for (unsigned i = 0; i < threadCount; ++i) {
+		uint32_t count = itemCount / threadCount + (i < itemCount % threadCount ? 1 : 0);
+		threads.push_back(std::thread(&randomx_init_dataset, dataset, cache, start, count));
+		start += count;
+	}
+	for (auto& thread : threads)
+		thread.join();
+}
+
+static void printCounter(std::ostream& os, int64_t value) {
+	if (value == CounterUnavailable)
+		os << "null";
+	else
+		os << value;
+}
+
+static void printRatio(std::ostream& os, int64_t numerator, int64_t denominator) {
+	if (numerator == CounterUnavailable || denominator == CounterUnavailable || denominator == 0)
+		os << "null";
+	else
+		os << std::setprecision(6) << (double)numerator / denominator;
+}
+
+//the last line is not terminated
+static void printCounters(std::ostream& os, const int64_t (&counters)[CounterCount], uint64_t hashes, const char* indent) {
+	for (int i = 0; i < CounterCount; ++i) {
+		os << indent << "\"" << counterNames[i] << "\": ";
+		printCounter(os, counters[i]);
+		os << "," << std::endl;
+	}
+	os << indent << "\"ipc\": ";
+	printRatio(os, counters[Instructions], counters[Cycles]);
+	os << "," << std::endl;
+	os << indent << "\"perHash\": {";
+	for (int i = 0; i < CounterCount; ++i) {
+		os << (i ? ", " : "") << "\"" << counterNames[i] << "\": ";
+		printRatio(os, counters[i], hashes);
+	}
+	os << "}";
+}
+
+static std::string cpuModel() {
+	std::ifstream cpuinfo("/proc/cpuinfo");
+	std::string line;
+	while (std::getline(cpuinfo, line)) {
+		if (line.compare(0, 10, "model name") == 0 || line.compare(0, 8, "Hardware") == 0) {
+			auto pos = line.find(':');
+			if (pos != std::string::npos)
+				return line.substr(line.find_first_not_of(" \t", pos + 1));
+		}
+	}
+	return "unknown";
+}
+
+static std::string jsonString(const std::string& s) {
+	std::string out = "\"";
+	for (char c : s) {
+		if (c == '"' || c == '\\')
+			out += '\\';
+		if ((unsigned char)c >= 0x20)
+			out += c;
+	}
+	return out + "\"";
+}
+
+static void printUsage(const char* executable) {
+	std::cout << "Usage: " << executable << " [OPTIONS]" << std::endl;
+	std::cout << "Supported options:" << std::endl;
+	std::cout << "  --help        shows this message" << std::endl;
+	std::cout << "  --threads T   use T threads per mode (default: 1)" << std::endl;
+	std::cout << "  --nonces N    run N nonces per mode (default: 100)" << std::endl;
+	std::cout << "  --init Q      initialize the dataset with Q threads (default: all CPUs)" << std::endl;
+	std::cout << "  --full        also run the full memory modes (2080 MiB)" << std::endl;
+	std::cout << "  --datasetFile F  map the dataset from file F (see randomx-benchmark)" << std::endl;
+	std::cout << "  --largePages  also run the modes with large pages" << std::endl;
+	std::cout << "  --softAes     also run the modes with software AES" << std::endl;
+	std::cout << "  --noInterpreter  skip the interpreted modes" << std::endl;
+	std::cout << "  --l2Event E   raw PMU event code used to count L2 misses (e.g. 0x3f24 on Intel)" << std::endl;
+	std::cout << "  --output F    write the JSON report to file F (default: stdout)" << std::endl;
+}
+
+int main(int argc, char** argv) {
+	bool help, full, largePages, softAes, noInterpreter;
+	int threadCount, noncesCount, initThreadCount;
+	const char* datasetFile;
+	const char* outputFile;
+
+	readOption("--help", argc, argv, help);
+	readIntOption("--threads", argc, argv, threadCount, 1);
+	readIntOption("--nonces", argc, argv, noncesCount, 100);
+	readIntOption("--init", argc, argv, initThreadCount, std::max(1u, std::thread::hardware_concurrency()));
+	readOption("--full", argc, argv, full);
+	readStringOption("--datasetFile", argc, argv, datasetFile, nullptr);
+	readOption("--largePages", argc, argv, largePages);
+	readOption("--softAes", argc, argv, softAes);
+	readOption("--noInterpreter", argc, argv, noInterpreter);
+	readUInt64Option("--l2Event", argc, argv, l2RawEvent, 0);
+	readStringOption("--output", argc, argv, outputFile, nullptr);
+
+	if (help) {
+		printUsage(argv[0]);
+		return 0;
+	}
+
+	const randomx_flags available = randomx_get_flags();
+	const bool haveJit = (available & RANDOMX_FLAG_JIT) != 0;
+	const bool haveHardAes = (available & RANDOMX_FLAG_HARD_AES) != 0;
+	const randomx_flags argonFlags = available & RANDOMX_FLAG_ARGON2;
+
+	std::vector<Mode> modes;
+	for (int lp = 0; lp <= (largePages ? 1 : 0); ++lp) {
+		for (int fm = 0; fm <= (full ? 1 : 0); ++fm) {
+			for (int jit = noInterpreter ? 1 : 0; jit <= (haveJit ? 1 : 0); ++jit) {
+				for (int aes = haveHardAes ? 1 : 0; aes >= (softAes || !haveHardAes ? 0 : 1); --aes) {
+					Mode mode = { jit != 0, fm != 0, lp != 0, aes != 0 };
+					modes.push_back(mode);
+				}
+			}
+		}
+	}
+
+	std::ostringstream report;
+	report << "{" << std::endl;
+	report << "  \"cpu\": " << jsonString(cpuModel()) << "," << std::endl;
+	report << "  \"logicalCpus\": " << std::thread::hardware_concurrency() << "," << std::endl;
+	report << "  \"recommendedFlags\": " << available << "," << std::endl;
+	report << "  \"threads\": " << threadCount << "," << std::endl;
+	report << "  \"nonces\": " << noncesCount << "," << std::endl;
+	report << "  \"runs\": [";
+
+	const char seed[4] = { 0 };
+	randomx_cache* cache = nullptr;
+	randomx_dataset* dataset = nullptr;
+	int currentLargePages = -1;
+	bool first = true;
+	int rc = 0;
+
+	for (auto& mode : modes) {
+		//cache and dataset are shared by all modes with the same page size
+		if ((int)mode.largePages != currentLargePages) {
+			if (dataset != nullptr)
+				randomx_release_dataset(dataset);
+			if (cache != nullptr)
+				randomx_release_cache(cache);
+			dataset = nullptr;
+			cache = nullptr;
+			currentLargePages = mode.largePages;
+		}
+		randomx_flags flags = argonFlags;
+		if (mode.jit)
+			flags |= RANDOMX_FLAG_JIT;
+		if (mode.hardAes)
+			flags |= RANDOMX_FLAG_HARD_AES;
+		if (mode.largePages)
+			flags |= RANDOMX_FLAG_LARGE_PAGES;
+		if (mode.fullMem)
+			flags |= RANDOMX_FLAG_FULL_MEM;
+
+		std::cerr << "Mode: " << (mode.jit ? "JIT" : "interpreted") << ", " << (mode.fullMem ? "full" : "light") << " memory, ";
+		std::cerr << (mode.largePages ? "large" : "small") << " pages, " << (mode.hardAes ? "hardware" : "software") << " AES" << std::endl;
+
+		if (mode.fullMem && dataset == nullptr && datasetFile != nullptr) {
+			dataset = randomx_dataset_map(datasetFile, seed, sizeof(seed), mode.largePages ? RANDOMX_FLAG_LARGE_PAGES : RANDOMX_FLAG_DEFAULT);
+		}
+		if (cache == nullptr && (!mode.fullMem || dataset == nullptr)) {
+			cache = randomx_alloc_cache(argonFlags | (haveJit ? RANDOMX_FLAG_JIT : RANDOMX_FLAG_DEFAULT) | (mode.largePages ? RANDOMX_FLAG_LARGE_PAGES : RANDOMX_FLAG_DEFAULT));
+			if (cache == nullptr) {
+				std::cerr << "Cache allocation failed, skipping mode" << std::endl;
+				rc = 1;
+				continue;
+			}
+			randomx_init_cache_parallel(cache, seed, sizeof(seed), initThreadCount);
+		}
+		if (mode.fullMem && dataset == nullptr) {
+			dataset = randomx_alloc_dataset(mode.largePages ? RANDOMX_FLAG_LARGE_PAGES : RANDOMX_FLAG_DEFAULT);
+			if (dataset == nullptr) {
+				std::cerr << "Dataset allocation failed, skipping mode" << std::endl;
+				rc = 1;
+				continue;
+			}
+			std::cerr << "Initializing dataset (" << initThreadCount << " threads) ..." << std::endl;
+			initDataset(dataset, cache, initThreadCount);
+		}
+
+		std::vector<randomx_vm*> vms;
+		for (int i = 0; i < threadCount; ++i) {
+			randomx_vm* vm = randomx_create_vm(flags, cache, dataset);
+			if (vm == nullptr)
+				break;
+			vms.push_back(vm);
+		}
+		if ((int)vms.size() != threadCount) {
+			std::cerr << "VM creation failed, skipping mode" << std::endl;
+			for (auto vm : vms)
+				randomx_destroy_vm(vm);
+			rc = 1;
+			continue;
+		}
+
+		std::atomic<uint32_t> atomicNonce(0);
+		std::vector<ThreadResult> results(threadCount);
+		std::vector<std::thread> threads;
+		Stopwatch sw(true);
+		for (int i = 0; i < threadCount; ++i)
+			threads.push_back(std::thread(&mine, vms[i], std::ref(atomicNonce), (uint32_t)noncesCount, std::ref(results[i])));
+		for (auto& thread : threads)
+			thread.join();
+		double elapsed = sw.getElapsed();
+		for (auto vm : vms)
+			randomx_destroy_vm(vm);
+
+		ThreadResult total;
+		for (int c = 0; c < CounterCount; ++c) {
+			total.counters[c] = 0;
+			for (auto& result : results) {
+				if (result.counters[c] == CounterUnavailable)
+					total.counters[c] = CounterUnavailable;
+				else if (total.counters[c] != CounterUnavailable)
+					total.counters[c] += result.counters[c];
+			}
+		}
+		for (auto& result : results)
+			total.hashes += result.hashes;
+
+		report << (first ? "" : ",") << std::endl;
+		first = false;
+		report << "    {" << std::endl;
+		report << "      \"mode\": {\"jit\": " << (mode.jit ? "true" : "false") << ", \"fullMem\": " << (mode.fullMem ? "true" : "false");
+		report << ", \"largePages\": " << (mode.largePages ? "true" : "false") << ", \"hardAes\": " << (mode.hardAes ? "true" : "false") << "}," << std::endl;
+		report << "      \"flags\": " << flags << "," << std::endl;
+		report << "      \"elapsedSeconds\": " << std::setprecision(6) << elapsed << "," << std::endl;
+		report << "      \"hashesPerSecond\": " << std::setprecision(6) << total.hashes / elapsed << "," << std::endl;
+		report << "      \"hashes\": " << total.hashes << "," << std::endl;
+		printCounters(report, total.counters, total.hashes, "      ");
+		report << "," << std::endl << "      \"perThread\": [";
+		for (int i = 0; i < threadCount; ++i) {
+			report << (i ? "," : "") << std::endl << "        {" << std::endl;
+			report << "          \"thread\": " << i << "," << std::endl;
+			report << "          \"hashes\": " << results[i].hashes << "," << std::endl;
+			printCounters(report, results[i].counters, results[i].hashes, "          ");
+			report << std::endl << "        }";
+		}
+		report << std::endl << "      ]" << std::endl << "    }";
+		std::cerr << "  " << total.hashes / elapsed << " hashes per second" << std::endl;
+	}
+	if (dataset != nullptr)
+		randomx_release_dataset(dataset);
+	if (cache != nullptr)
+		randomx_release_cache(cache);
+
+	report << std::endl << "  ]" << std::endl << "}" << std::endl;
+
+	if (outputFile != nullptr) {
+		std::ofstream fout(outputFile);
+		fout << report.str();
+		if (!fout) {
+			std::cerr << "Failed to write " << outputFile << std::endl;
+			return 1;
+		}
+	}
+	else {
+		std::cout << report.str();
+	}
+	return rc;
+}
@@ -4,6 +4,8 @@
 
 #include <cassert>
 #include <iomanip>
+#include <thread>
+#include <vector>
 #include "utility.hpp"
 #include "../bytecode_machine.hpp"
 #include "../dataset.hpp"
@@ -15,6 +17,10 @@
 #include "../intrin_portable.h"
 #include "../jit_compiler.hpp"
 #include "../aes_hash.hpp"
+#include "../cpu.hpp"
+#include "../dataset_memo.hpp"
+#include "../epoch_manager.hpp"
+#include "../virtual_machine.hpp"
 
 randomx_cache* cache;
 randomx_vm* vm = nullptr;
@@ -51,6 +57,44 @@ void calcHexHash(const char(&key)[K], const char(&hex)[H], void* output) {
 	randomx_calculate_hash(vm, input, sizeof(input), output);
 }
 
+//compares the first itemCount items of a Dataset with a freshly initialized one
+bool datasetMatches(randomx_dataset* dataset, const char* seed, unsigned long itemCount) {
+	randomx_cache* seedCache = randomx_alloc_cache(RANDOMX_FLAG_DEFAULT);
+	randomx_dataset* expected = randomx_alloc_dataset(RANDOMX_FLAG_DEFAULT);
+	assert(seedCache != nullptr && expected != nullptr);
+	randomx_init_cache(seedCache, seed, strlen(seed));
+	randomx_init_dataset(expected, seedCache, 0, itemCount);
+	bool equal = memcmp(randomx_get_dataset_memory(dataset), randomx_get_dataset_memory(expected), itemCount * RANDOMX_DATASET_ITEM_SIZE) == 0;
+	randomx_release_dataset(expected);
+	randomx_release_cache(seedCache);
+	return equal;
+}
+
+randomx_dataset* fullDataset = nullptr;
+
+//initializes the complete Dataset for "test key 000" on all hardware threads (once)
+randomx_dataset* getFullDataset() {
+	if (fullDataset != nullptr)
+		return fullDataset;
+	randomx_cache* keyCache = randomx_alloc_cache(RANDOMX_FLAG_JIT);
+	fullDataset = randomx_alloc_dataset(RANDOMX_FLAG_DEFAULT);
+	assert(keyCache != nullptr && fullDataset != nullptr);
+	randomx_init_cache(keyCache, "test key 000", 12);
+	const unsigned long itemCount = randomx_dataset_item_count();
+	const unsigned threadCount = std::max(1u, std::thread::hardware_concurrency());
+	std::vector<std::thread> threads;
+	for (unsigned i = 0; i < threadCount; ++i) {
+		unsigned long first = itemCount * i / threadCount;
+		unsigned long last = itemCount * (i + 1) / threadCount;
+		threads.emplace_back(&randomx_init_dataset, fullDataset, keyCache, first, last - first);
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+	randomx_release_cache(keyCache);
+	return fullDataset;
+}
+
 int testNo = 0;
 int skipped = 0;
 
@@ -146,6 +190,30 @@ int main() {
 		assert(datasetItem[0] == 0x145a5091f7853099);
 	});
 
+#if defined(_M_X64) || defined(__x86_64__)
+	runTest("JIT instruction templates", RANDOMX_HAVE_COMPILER, []() {
+		//programs compiled from templates must match the handler output byte for byte
+		randomx::JitCompilerX86 templated, handlers;
+		handlers.disableTemplates();
+		alignas(16) randomx::Program program;
+		alignas(16) randomx::ProgramConfiguration config;
+		uint8_t seed[64];
+		blake2b(seed, sizeof(seed), "JIT instruction templates", 25, nullptr, 0);
+		for (int i = 0; i < 200; ++i) {
+			fillAes1Rx4<true>(seed, sizeof(program), &program);
+			uint64_t addressRegisters = program.getEntropy(12);
+			config.readReg0 = 0 + (addressRegisters & 1);
+			config.readReg1 = 2 + ((addressRegisters >> 1) & 1);
+			config.readReg2 = 4 + ((addressRegisters >> 2) & 1);
+			config.readReg3 = 6 + ((addressRegisters >> 3) & 1);
+			templated.generateProgram(program, config);
+			handlers.generateProgram(program, config);
+			assert(templated.getCodeSize() == handlers.getCodeSize());
+			assert(memcmp(templated.getCode(), handlers.getCode(), templated.getCodeSize()) == 0);
+		}
+	});
+#endif
+
 	runTest("Dataset initialization (compiler)", RANDOMX_HAVE_COMPILER && stringsEqual(RANDOMX_ARGON_SALT, "RandomX\x03"), []() {
 		initCache("test key 000");
 		randomx::JitCompiler jit;
@@ -167,6 +235,49 @@ int main() {
 		assert(datasetItem[0] == 0x145a5091f7853099);
 	});
 
+	runTest("Dataset initialization (SIMD)", stringsEqual(RANDOMX_ARGON_SALT, "RandomX\x03"), []() {
+		initCache("test key 000");
+		randomx::Cpu cpu;
+		randomx::DatasetInitFunc* impls[] = {
+			cpu.hasAvx512() ? randomx::datasetInitAvx512() : nullptr,
+			cpu.hasAvx2() ? randomx::datasetInitAvx2() : nullptr,
+			randomx::datasetInitNeon(),
+		};
+		constexpr uint32_t startItem = 10000000 - 3;
+		constexpr uint32_t itemCount = 19;
+		std::vector<uint64_t> expected(8 * itemCount), actual(8 * itemCount);
+		for (uint32_t i = 0; i < itemCount; ++i)
+			randomx::initDatasetItem(cache, (uint8_t*)&expected[8 * i], startItem + i);
+		assert(expected[8 * 3] == 0x7943a1f6186ffb72);
+		for (auto impl : impls) {
+			if (impl == nullptr)
+				continue;
+			std::fill(actual.begin(), actual.end(), 0);
+			impl(cache, (uint8_t*)actual.data(), startItem, startItem + itemCount);
+			assert(actual == expected);
+		}
+	});
+
+	runTest("Blake2b implementations", true, []() {
+		const blake2b_impl impls[] = { BLAKE2B_IMPL_SSE41, BLAKE2B_IMPL_AVX2, BLAKE2B_IMPL_NEON };
+		uint8_t input[300];
+		for (unsigned i = 0; i < sizeof(input); ++i)
+			input[i] = (uint8_t)(i * 7);
+		for (size_t size = 0; size <= sizeof(input); size += 13) {
+			uint8_t expected[64], actual[64];
+			assert(blake2b_set_impl(BLAKE2B_IMPL_REF) == 0);
+			blake2b(expected, sizeof(expected), input, size, nullptr, 0);
+			for (auto impl : impls) {
+				if (blake2b_set_impl(impl) != 0)
+					continue;
+				blake2b(actual, sizeof(actual), input, size, nullptr, 0);
+				assert(memcmp(expected, actual, sizeof(expected)) == 0);
+			}
+		}
+		assert(blake2b_set_impl(BLAKE2B_IMPL_AUTO) == 0);
+		assert(blake2b_get_impl() != BLAKE2B_IMPL_AUTO);
+	});
+
 	runTest("AesGenerator1R", true, []() {
 		char state[64] = { 0 };
 		hex2bin("6c19536eb2de31b6c0065f7f116e86f960d8af0c57210a6584c3237b9d064dc7", 64, state);
@@ -174,6 +285,41 @@ int main() {
 		assert(equalsHex(state, "fa89397dd6ca422513aeadba3f124b5540324c4ad4b6db434394307a17c833ab"));
 	});
 
+	runTest("AES kernels (VAES)", hasVaesAesHash(), []() {
+		std::vector<uint8_t> buffer1(64 * 1024), buffer2(64 * 1024);
+		alignas(16) uint8_t state1[64], state2[64], hash1[64], hash2[64];
+		for (unsigned i = 0; i < sizeof(state1); ++i)
+			state1[i] = state2[i] = (uint8_t)(i * 5);
+		fillAes1Rx4<true>(state1, buffer1.size(), buffer1.data());
+		buffer2 = buffer1;
+		hashAes1Rx4<true>(buffer1.data(), buffer1.size(), hash1);
+		hashAes1Rx4Vaes(buffer2.data(), buffer2.size(), hash2);
+		assert(memcmp(hash1, hash2, sizeof(hash1)) == 0);
+		memcpy(state2, state1, sizeof(state1));
+		fillAes4Rx4<true>(state1, buffer1.size(), buffer1.data());
+		fillAes4Rx4Vaes(state2, buffer2.size(), buffer2.data());
+		assert(buffer1 == buffer2);
+	});
+
+	runTest("AES kernels (ARMv8)", RANDOMX_ARMV8_AES_HASH, []() {
+		std::vector<uint8_t> buffer1(64 * 1024), buffer2(64 * 1024);
+		alignas(16) uint8_t state1[64], state2[64], hash1[64], hash2[64];
+		for (unsigned i = 0; i < sizeof(state1); ++i)
+			state1[i] = state2[i] = (uint8_t)(i * 5);
+		fillAes1Rx4<true>(state1, buffer1.size(), buffer1.data());
+		fillAes1Rx4<false>(state2, buffer2.size(), buffer2.data());
+		assert(buffer1 == buffer2 && memcmp(state1, state2, sizeof(state1)) == 0);
+		hashAes1Rx4<true>(buffer1.data(), buffer1.size(), hash1);
+		hashAes1Rx4<false>(buffer2.data(), buffer2.size(), hash2);
+		assert(memcmp(hash1, hash2, sizeof(hash1)) == 0);
+		hashAndFillAes1Rx4<true>(buffer1.data(), buffer1.size(), hash1, state1);
+		hashAndFillAes1Rx4<false>(buffer2.data(), buffer2.size(), hash2, state2);
+		assert(buffer1 == buffer2 && memcmp(hash1, hash2, sizeof(hash1)) == 0);
+		fillAes4Rx4<true>(state1, buffer1.size(), buffer1.data());
+		fillAes4Rx4<false>(state2, buffer2.size(), buffer2.data());
+		assert(buffer1 == buffer2);
+	});
+
 	randomx::NativeRegisterFile reg;
 	randomx::BytecodeMachine decoder;
 	randomx::InstructionByteCode ibc;
@@ -962,6 +1108,43 @@ int main() {
 		assert(ibc.memMask == randomx::ScratchpadL3Mask);
 	});
 
+	runTest("Threaded interpreter", true, [] {
+		std::vector<uint8_t> scratchpad1(RANDOMX_SCRATCHPAD_L3), scratchpad2(RANDOMX_SCRATCHPAD_L3);
+		alignas(16) randomx::Program program;
+		alignas(16) randomx::ProgramConfiguration config;
+		alignas(16) uint8_t state[64] = { 0 };
+		randomx::NativeRegisterFile reg1, reg2, init;
+		randomx::BytecodeMachine machine;
+		randomx::InstructionByteCode bytecode[RANDOMX_PROGRAM_SIZE];
+		uint8_t dispatch[RANDOMX_PROGRAM_SIZE + 1];
+		int fused = 0, specialized = 0;
+		fillAes1Rx4<false>(state, scratchpad1.size(), scratchpad1.data());
+		for (int i = 0; i < 64; ++i) {
+			fillAes4Rx4<false>(state, sizeof(program), &program);
+			fillAes1Rx4<false>(state, sizeof(init), &init);
+			config.eMask[0] = (program.getEntropy(14) & 0x00F00000FFFFFFFF) | 0x3000000000000000;
+			config.eMask[1] = (program.getEntropy(15) & 0x00F00000FFFFFFFF) | 0x3000000000000000;
+			machine.compileProgram(program, bytecode, reg1);
+			machine.threadBytecode(bytecode, dispatch);
+			for (int pc = 0; pc < RANDOMX_PROGRAM_SIZE; ++pc) {
+				fused += dispatch[pc] >= randomx::ThreadedFusedBase;
+				specialized += dispatch[pc] >= randomx::ThreadedSpecializedBase && dispatch[pc] < randomx::ThreadedFusedBase;
+			}
+			scratchpad2 = scratchpad1;
+			reg1 = init;
+			rx_reset_float_state();
+			randomx::BytecodeMachine::executeBytecode(bytecode, scratchpad1.data(), config);
+			reg2 = reg1;
+			reg1 = init;
+			rx_reset_float_state();
+			randomx::BytecodeMachine::executeBytecodeThreaded(bytecode, dispatch, scratchpad2.data(), config);
+			assert(memcmp(&reg1, &reg2, sizeof(reg1)) == 0);
+			assert(scratchpad1 == scratchpad2);
+		}
+		rx_reset_float_state();
+		assert(fused > 0 && specialized > 0);
+	});
+
 #ifdef RANDOMX_FORCE_SECURE
 	vm = randomx_create_vm(RANDOMX_FLAG_DEFAULT | RANDOMX_FLAG_SECURE, cache, nullptr);
 #else
@@ -1034,6 +1217,219 @@ int main() {
 
 	runTest("Hash test 2e (compiler)", RANDOMX_HAVE_COMPILER && stringsEqual(RANDOMX_ARGON_SALT, "RandomX\x03"), test_e);
 
+	if (RANDOMX_HAVE_COMPILER) {
+		randomx_destroy_vm(vm);
+		vm = nullptr;
+		initCache("test key 000");
+		vm = randomx_create_vm(RANDOMX_FLAG_JIT | RANDOMX_FLAG_SECURE | RANDOMX_FLAG_DUAL_MAP, cache, nullptr);
+	}
+
+	runTest("Hash test 3a (compiler, dual-mapped)", RANDOMX_HAVE_COMPILER && stringsEqual(RANDOMX_ARGON_SALT, "RandomX\x03"), test_a);
+
+	runTest("Hash test 3d (compiler, dual-mapped)", RANDOMX_HAVE_COMPILER && stringsEqual(RANDOMX_ARGON_SALT, "RandomX\x03"), test_d);
+
+	runTest("Dataset item memo", stringsEqual(RANDOMX_ARGON_SALT, "RandomX\x03"), []() {
+		const uint64_t readsPerHash = RANDOMX_PROGRAM_COUNT * RANDOMX_PROGRAM_ITERATIONS;
+		randomx_item_memo_stats stats;
+		char hash[RANDOMX_HASH_SIZE];
+		assert(randomx_cache_set_item_memo(cache, 500) == 0);
+		assert(randomx_cache_set_item_memo(cache, 1024 * 1024) == 1);
+		initCache("test key 000");
+		auto lightVm = randomx_create_vm(RANDOMX_FLAG_DEFAULT, cache, nullptr);
+		assert(lightVm != nullptr);
+		for (int i = 0; i < 2; ++i) {
+			randomx_calculate_hash(lightVm, "This is a test", 14, &hash);
+			assert(equalsHex(hash, "639183aae1bf4c9a35884cb46b09cad9175f04efd7684e7262a0ac1c2f0b4e3f"));
+		}
+		randomx_destroy_vm(lightVm);
+		randomx_cache_get_item_memo_stats(cache, &stats, 1);
+		assert(stats.capacity == 8192);
+		assert(stats.hits + stats.misses == 2 * readsPerHash);
+		assert(stats.hits > 0 && stats.misses > 0);
+#if defined(_M_X64) || defined(__x86_64__)
+		if (RANDOMX_HAVE_COMPILER) {
+			randomx_calculate_hash(vm, "This is a test", 14, &hash);
+			assert(equalsHex(hash, "639183aae1bf4c9a35884cb46b09cad9175f04efd7684e7262a0ac1c2f0b4e3f"));
+			randomx_cache_get_item_memo_stats(cache, &stats, 0);
+			assert(stats.hits + stats.misses == readsPerHash);
+			assert(stats.hits > 0);
+		}
+#endif
+		initCache("test key 001");
+		randomx_cache_get_item_memo_stats(cache, &stats, 1);
+		assert(randomx_cache_set_item_memo(cache, 0) == 1);
+		randomx_cache_get_item_memo_stats(cache, &stats, 0);
+		assert(stats.capacity == 0 && stats.hits == 0);
+	});
+
+	runTest("Dataset item memo (concurrent)", true, []() {
+		//few slots and many item numbers, so that readers often race with writers
+		randomx::DatasetItemMemo* memo = randomx::DatasetItemMemo::create(8);
+		assert(memo != nullptr);
+		assert(randomx::DatasetItemMemo::create(12) == nullptr);
+		auto itemWord = [](uint32_t itemNumber, unsigned i) {
+			return ((uint64_t)itemNumber << 32) | (itemNumber * 8 + i);
+		};
+		const uint32_t itemCount = 64;
+		const int iterations = 200000;
+		std::atomic<bool> torn(false);
+		std::vector<std::thread> threads;
+		for (unsigned t = 0; t < 4; ++t) {
+			threads.push_back(std::thread([&, t]() {
+				uint64_t item[8];
+				for (int j = 0; j < iterations; ++j) {
+					uint32_t itemNumber = (uint32_t)(j * (2 * t + 1)) % itemCount;
+					if (t % 2 == 0) {
+						for (unsigned i = 0; i < 8; ++i)
+							item[i] = itemWord(itemNumber, i);
+						memo->store(itemNumber, item);
+					}
+					else if (memo->lookup(itemNumber, item)) {
+						for (unsigned i = 0; i < 8; ++i) {
+							if (item[i] != itemWord(itemNumber, i))
+								torn = true;
+						}
+					}
+				}
+			}));
+		}
+		for (auto& thread : threads)
+			thread.join();
+		assert(!torn);
+		uint64_t item[8];
+		for (unsigned i = 0; i < 8; ++i)
+			item[i] = itemWord(5, i);
+		memo->store(5, item);
+		item[7] = 0;
+		assert(memo->lookup(5, item) && item[7] == itemWord(5, 7));
+		delete memo;
+	});
+
+	runTest("Batch verification", stringsEqual(RANDOMX_ARGON_SALT, "RandomX\x03"), []() {
+		//cache holds "test key 001" from the previous test
+		randomx_cache* cache0 = randomx_alloc_cache(RANDOMX_FLAG_DEFAULT);
+		assert(cache0 != nullptr);
+		randomx_init_cache(cache0, "test key 000", 12);
+		randomx_flags verifierFlags = RANDOMX_HAVE_COMPILER ? RANDOMX_FLAG_JIT : RANDOMX_FLAG_DEFAULT;
+		randomx_verifier* verifier = randomx_create_verifier(verifierFlags, 2);
+		assert(verifier != nullptr);
+		const char* lorem = "Lorem ipsum dolor sit amet";
+		const char* sed = "sed do eiusmod tempor incididunt ut labore et dolore magna aliqua";
+		randomx_cache* caches[] = { cache0, cache, cache0, cache0 };
+		const void* inputs[] = { "This is a test", sed, lorem, sed };
+		size_t inputSizes[] = { 14, strlen(sed), strlen(lorem), strlen(sed) };
+		char expected[4][RANDOMX_HASH_SIZE];
+		hex2bin("639183aae1bf4c9a35884cb46b09cad9175f04efd7684e7262a0ac1c2f0b4e3f", 64, expected[0]);
+		hex2bin("e9ff4503201c0c2cca26d285c93ae883f9b1d30c9eb240b820756f2d5a7905fc", 64, expected[1]);
+		hex2bin("300a0adb47603dedb42228ccb2b211104f4da45af709cd7547cd049e9489c969", 64, expected[2]);
+		hex2bin("c36d4ed4191e617309867ed66a443be4075014e2b061bcdaf9ce7b721d2b77a8", 64, expected[3]);
+		expected[3][0] ^= 1;
+		const void* expectedHashes[] = { expected[0], expected[1], expected[2], expected[3] };
+		unsigned char results[4];
+		char hashes[4][RANDOMX_HASH_SIZE];
+		for (int i = 0; i < 2; ++i) {
+			memset(results, 0xff, sizeof(results));
+			assert(randomx_verify_batch(verifier, caches, nullptr, inputs, inputSizes, expectedHashes, 4, results, hashes) == 1);
+			assert(results[0] == 1 && results[1] == 1 && results[2] == 1 && results[3] == 0);
+			assert(equalsHex(hashes[3], "c36d4ed4191e617309867ed66a443be4075014e2b061bcdaf9ce7b721d2b77a8"));
+		}
+		assert(randomx_verify_batch(verifier, caches, nullptr, inputs, inputSizes, expectedHashes, 0, results, nullptr) == 1);
+		randomx_destroy_verifier(verifier);
+		randomx_release_cache(cache0);
+	});
+
+	runTest("Cache registry", stringsEqual(RANDOMX_ARGON_SALT, "RandomX\x03"), []() {
+		const size_t cacheSize = RANDOMX_ARGON_MEMORY * 1024;
+		const char* sed = "sed do eiusmod tempor incididunt ut labore et dolore magna aliqua";
+		char hash[RANDOMX_HASH_SIZE];
+		randomx_cache_registry* registry = randomx_create_cache_registry(RANDOMX_FLAG_DEFAULT, 2 * cacheSize, 1);
+		assert(registry != nullptr);
+		assert(randomx_cache_registry_prepare(registry, "test key 000", 12) == 1);
+		auto lightVm = randomx_create_vm(RANDOMX_FLAG_DEFAULT, cache, nullptr);
+		assert(lightVm != nullptr);
+		assert(randomx_cache_registry_attach_vm(registry, lightVm, "test key 000", 12) == 1);
+		randomx_calculate_hash(lightVm, "This is a test", 14, &hash);
+		assert(equalsHex(hash, "639183aae1bf4c9a35884cb46b09cad9175f04efd7684e7262a0ac1c2f0b4e3f"));
+		randomx_cache* cache1 = randomx_cache_registry_acquire(registry, "test key 001", 12);
+		assert(cache1 != nullptr);
+		assert(randomx_cache_registry_acquire(registry, "test key 001", 12) == cache1);
+		assert(randomx_cache_registry_count(registry) == 2);
+		//both caches are referenced, so a third seed does not fit into the budget
+		assert(randomx_cache_registry_acquire(registry, "test key 002", 12) == nullptr);
+		randomx_cache_registry_release(registry, cache1);
+		randomx_cache_registry_release(registry, cache1);
+		randomx_cache* cache2 = randomx_cache_registry_acquire(registry, "test key 002", 12);
+		assert(cache2 != nullptr);
+		assert(randomx_cache_registry_count(registry) == 2);
+		assert(randomx_cache_registry_attach_vm(registry, lightVm, "test key 001", 12) == 0);
+		randomx_cache_registry_release(registry, cache2);
+		assert(randomx_cache_registry_attach_vm(registry, lightVm, "test key 001", 12) == 1);
+		randomx_calculate_hash(lightVm, sed, strlen(sed), &hash);
+		assert(equalsHex(hash, "e9ff4503201c0c2cca26d285c93ae883f9b1d30c9eb240b820756f2d5a7905fc"));
+		randomx_cache_registry_detach_vm(registry, lightVm);
+		randomx_destroy_vm(lightVm);
+		randomx_destroy_cache_registry(registry);
+	});
+
+	//the epoch managers below only build the first items of each Dataset
+	const unsigned long epochItems = 3 * 4096 + 100;
+
+	runTest("Epoch manager: prepare, activate", stringsEqual(RANDOMX_ARGON_SALT, "RandomX\x03"), [epochItems]() {
+		randomx_epoch_manager manager(randomx_get_flags(), 2, epochItems);
+		assert(manager.getDataset() == nullptr);
+		manager.prepare("test key 000");
+		assert(manager.activate("test key 000"));
+		assert(manager.getDataset() != nullptr);
+		assert(datasetMatches(manager.getDataset(), "test key 000", epochItems));
+		//activating the current seed again keeps its Dataset
+		randomx_dataset* dataset = manager.getDataset();
+		assert(manager.activate("test key 000"));
+		assert(manager.getDataset() == dataset);
+	});
+
+	runTest("Epoch manager: activate without prepare", stringsEqual(RANDOMX_ARGON_SALT, "RandomX\x03"), [epochItems]() {
+		randomx_epoch_manager manager(randomx_get_flags(), 2, epochItems);
+		assert(manager.activate("test key 001"));
+		assert(datasetMatches(manager.getDataset(), "test key 001", epochItems));
+	});
+
+	runTest("Epoch manager: prepare during a build", stringsEqual(RANDOMX_ARGON_SALT, "RandomX\x03"), [epochItems]() {
+		randomx_epoch_manager manager(randomx_get_flags(), 2, epochItems);
+		assert(manager.activate("test key 000"));
+		manager.prepare("test key 001");
+		//cancels the unfinished build for the previous seed
+		manager.prepare("test key 002");
+		assert(datasetMatches(manager.getDataset(), "test key 000", epochItems));
+		assert(manager.activate("test key 002"));
+		assert(datasetMatches(manager.getDataset(), "test key 002", epochItems));
+		//a prepared seed that is never activated is dropped by the next activation
+		manager.prepare("test key 001");
+		assert(manager.activate("test key 000"));
+		assert(datasetMatches(manager.getDataset(), "test key 000", epochItems));
+	});
+
+	runTest("Epoch manager: sync VM after rotation", stringsEqual(RANDOMX_ARGON_SALT, "RandomX\x03"), [epochItems]() {
+		randomx_epoch_manager manager(RANDOMX_FLAG_DEFAULT, 2, epochItems);
+		assert(manager.activate("test key 000"));
+		randomx_dataset* first = manager.getDataset();
+		//interpreted VMs read the Dataset through getMemory()
+		randomx_vm* fullVm = randomx_create_vm(RANDOMX_FLAG_FULL_MEM, nullptr, first);
+		assert(fullVm != nullptr);
+		manager.registerVm(fullVm);
+		assert(!manager.syncVm(fullVm));
+		manager.prepare("test key 001");
+		assert(manager.activate("test key 001"));
+		assert(manager.getDataset() != first);
+		//the VM keeps using (and owning) the previous Dataset until it is synchronized
+		assert(fullVm->getMemory() == randomx_get_dataset_memory(first));
+		assert(datasetMatches(first, "test key 000", epochItems));
+		assert(manager.syncVm(fullVm));
+		assert(fullVm->getMemory() == randomx_get_dataset_memory(manager.getDataset()));
+		assert(!manager.syncVm(fullVm));
+		manager.unregisterVm(fullVm);
+		randomx_destroy_vm(fullVm);
+	});
+
 	auto flags = randomx_get_flags();
 
 	randomx_release_cache(cache);
@@ -1059,10 +1455,42 @@ int main() {
 		assert(cacheMemory[33554431] == 0x1f47f056d05cd99b);
 	});
 
+	if (cache != nullptr)
+		randomx_release_cache(cache);
+	cache = randomx_alloc_cache(RANDOMX_FLAG_ARGON2_NEON);
+
+	runTest("Cache initialization: NEON", (flags & RANDOMX_FLAG_ARGON2_NEON) && RANDOMX_ARGON_ITERATIONS == 3 && RANDOMX_ARGON_LANES == 1 && RANDOMX_ARGON_MEMORY == 262144 && stringsEqual(RANDOMX_ARGON_SALT, "RandomX\x03"), []() {
+		initCache("test key 000");
+		uint64_t* cacheMemory = (uint64_t*)cache->memory;
+		assert(cacheMemory[0] == 0x191e0e1d23c02186);
+		assert(cacheMemory[1568413] == 0xf1b62fe6210bf8b1);
+		assert(cacheMemory[33554431] == 0x1f47f056d05cd99b);
+	});
+
 	if (cache != nullptr)
 		randomx_release_cache(cache);
 	cache = randomx_alloc_cache(RANDOMX_FLAG_DEFAULT);
 
+	runTest("Cache initialization (parallel)", RANDOMX_ARGON_ITERATIONS == 3 && RANDOMX_ARGON_LANES == 1 && RANDOMX_ARGON_MEMORY == 262144 && stringsEqual(RANDOMX_ARGON_SALT, "RandomX\x03"), []() {
+		randomx_cache* parallelCache = randomx_alloc_cache(RANDOMX_FLAG_DEFAULT);
+		assert(parallelCache != nullptr);
+		initCache("test key 000");
+		randomx_init_cache_parallel(parallelCache, "test key 000", 12, 4);
+		uint64_t* cacheMemory = (uint64_t*)parallelCache->memory;
+		assert(cacheMemory[0] == 0x191e0e1d23c02186);
+		assert(cacheMemory[1568413] == 0xf1b62fe6210bf8b1);
+		assert(cacheMemory[33554431] == 0x1f47f056d05cd99b);
+		assert(parallelCache->reciprocalCache == cache->reciprocalCache);
+		for (int i = 0; i < RANDOMX_CACHE_ACCESSES; ++i) {
+			assert(parallelCache->programs[i].getSize() == cache->programs[i].getSize());
+			assert(memcmp(&parallelCache->programs[i].programBuffer, &cache->programs[i].programBuffer, sizeof(randomx::Instruction) * cache->programs[i].getSize()) == 0);
+		}
+		uint64_t datasetItem[8];
+		randomx::initDatasetItem(parallelCache, (uint8_t*)&datasetItem, 10000000);
+		assert(datasetItem[0] == 0x7943a1f6186ffb72);
+		randomx_release_cache(parallelCache);
+	});
+
 	runTest("Hash batch test", RANDOMX_HAVE_COMPILER && stringsEqual(RANDOMX_ARGON_SALT, "RandomX\x03"), []() {
 		char hash1[RANDOMX_HASH_SIZE];
 		char hash2[RANDOMX_HASH_SIZE];
@@ -1082,6 +1510,126 @@ int main() {
 		assert(equalsHex(hash3, "c36d4ed4191e617309867ed66a443be4075014e2b061bcdaf9ce7b721d2b77a8"));
 	});
 
+	runTest("Hash batch API", RANDOMX_HAVE_COMPILER && stringsEqual(RANDOMX_ARGON_SALT, "RandomX\x03"), []() {
+		constexpr size_t count = 4;
+		constexpr size_t nonceOffset = 4;
+		char input[] = "Lorem ipsum dolor sit amet";
+		char hashes[count][RANDOMX_HASH_SIZE];
+		char reference[count][RANDOMX_HASH_SIZE];
+		initCache("test key 000");
+
+		for (size_t i = 0; i < count; ++i) {
+			store32(input + nonceOffset, 1000 + (uint32_t)i);
+			randomx_calculate_hash(vm, input, sizeof(input) - 1, &reference[i]);
+		}
+
+		size_t done = randomx_calculate_hash_batch(vm, input, sizeof(input) - 1, nonceOffset, 1000, count, &hashes, 0);
+		assert(done == count);
+		assert(memcmp(hashes, reference, sizeof(reference)) == 0);
+
+		uint64_t target = load64(reference[2] + 24) + 1;
+		size_t expected = 0;
+		while (load64(reference[expected] + 24) >= target)
+			++expected;
+		done = randomx_calculate_hash_batch(vm, input, sizeof(input) - 1, nonceOffset, 1000, count, &hashes, target);
+		assert(done == expected + 1);
+		assert(memcmp(hashes, reference, done * RANDOMX_HASH_SIZE) == 0);
+	});
+
+#if defined(_M_X64) || defined(__x86_64__)
+	const bool haveInterleavedVm = RANDOMX_HAVE_COMPILER;
+#else
+	const bool haveInterleavedVm = false;
+#endif
+
+	runTest("Interleaved hashes", haveInterleavedVm && stringsEqual(RANDOMX_ARGON_SALT, "RandomX\x03"), []() {
+#ifdef RANDOMX_FORCE_SECURE
+		const randomx_flags secure = RANDOMX_FLAG_SECURE;
+#else
+		const randomx_flags secure = RANDOMX_FLAG_DEFAULT;
+#endif
+		constexpr unsigned count = 8;
+		constexpr size_t nonceOffset = 39;
+		char inputs[count][76];
+		const void* inputPtrs[count];
+		char reference[count][RANDOMX_HASH_SIZE];
+		char hashes[count][RANDOMX_HASH_SIZE];
+		for (unsigned i = 0; i < count; ++i) {
+			memset(inputs[i], 0x5a, sizeof(inputs[i]));
+			store32(inputs[i] + nonceOffset, 1000 + i);
+			inputPtrs[i] = inputs[i];
+		}
+
+		//light VMs only agree with full VMs when the whole Dataset is initialized
+		randomx_dataset* dataset = getFullDataset();
+		randomx_cache* jitCache = randomx_alloc_cache(RANDOMX_FLAG_JIT);
+		assert(jitCache != nullptr);
+		randomx_init_cache(jitCache, "test key 000", 12);
+
+		const randomx_flags modes[] = {
+			RANDOMX_FLAG_DEFAULT,
+			RANDOMX_FLAG_JIT | secure,
+			RANDOMX_FLAG_FULL_MEM,
+			RANDOMX_FLAG_FULL_MEM | RANDOMX_FLAG_JIT | secure,
+		};
+		for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); ++m) {
+			const bool fullMem = (modes[m] & RANDOMX_FLAG_FULL_MEM) != 0;
+			randomx_vm* machine = randomx_create_vm(modes[m], fullMem ? nullptr : jitCache, fullMem ? dataset : nullptr);
+			assert(machine != nullptr);
+			for (unsigned i = 0; i < count; ++i) {
+				randomx_calculate_hash(machine, inputs[i], sizeof(inputs[i]), m == 0 ? reference[i] : hashes[i]);
+			}
+			if (m > 0) {
+				assert(memcmp(hashes, reference, sizeof(reference)) == 0);
+			}
+			randomx_destroy_vm(machine);
+		}
+
+		const randomx_flags interleave[] = { RANDOMX_FLAG_INTERLEAVE_2, RANDOMX_FLAG_INTERLEAVE_4 };
+		for (auto lanesFlag : interleave) {
+			randomx_vm* machine = randomx_create_vm(RANDOMX_FLAG_FULL_MEM | RANDOMX_FLAG_JIT | secure | lanesFlag, nullptr, dataset);
+			assert(machine != nullptr);
+			const unsigned lanes = machine->getLaneCount();
+			assert(lanes == (lanesFlag == RANDOMX_FLAG_INTERLEAVE_4 ? 4u : 2u));
+			memset(hashes, 0, sizeof(hashes));
+			for (unsigned i = 0; i < count; i += lanes) {
+				machine->calculateHashInterleaved(&inputPtrs[i], sizeof(inputs[i]), hashes[i]);
+			}
+			assert(memcmp(hashes, reference, sizeof(reference)) == 0);
+			randomx_destroy_vm(machine);
+		}
+
+		randomx_release_cache(jitCache);
+	});
+
+	runTest("Dataset file", stringsEqual(RANDOMX_ARGON_SALT, "RandomX\x03"), []() {
+		const char* path = "randomx-tests-dataset.bin";
+		const size_t datasetSize = randomx_dataset_item_count() * RANDOMX_DATASET_ITEM_SIZE;
+		randomx_dataset* dataset = getFullDataset();
+		assert(randomx_dataset_save(dataset, path, "test key 000", 12) == 1);
+		assert(randomx_dataset_map(path, "test key 001", 12, RANDOMX_FLAG_DEFAULT) == nullptr);
+		assert(randomx_dataset_map(path, "test key 001", 12, RANDOMX_FLAG_LAZY_MAP) == nullptr);
+
+		//large pages are optional, so that mode is only checked if the allocation succeeds
+		const randomx_flags mapFlags[] = { RANDOMX_FLAG_DEFAULT, RANDOMX_FLAG_LAZY_MAP, RANDOMX_FLAG_LARGE_PAGES };
+		for (auto flags : mapFlags) {
+			randomx_dataset* mapped = randomx_dataset_map(path, "test key 000", 12, flags);
+			if (mapped == nullptr) {
+				assert(flags == RANDOMX_FLAG_LARGE_PAGES);
+				continue;
+			}
+			assert(memcmp(randomx_get_dataset_memory(mapped), randomx_get_dataset_memory(dataset), datasetSize) == 0);
+			randomx_vm* fullVm = randomx_create_vm(RANDOMX_FLAG_FULL_MEM, nullptr, mapped);
+			assert(fullVm != nullptr);
+			char hash[RANDOMX_HASH_SIZE];
+			randomx_calculate_hash(fullVm, "This is a test", 14, &hash);
+			assert(equalsHex(hash, "639183aae1bf4c9a35884cb46b09cad9175f04efd7684e7262a0ac1c2f0b4e3f"));
+			randomx_destroy_vm(fullVm);
+			randomx_release_dataset(mapped);
+		}
+		remove(path);
+	});
+
 	runTest("Preserve rounding mode", RANDOMX_FREQ_CFROUND > 0, []() {
 		rx_set_rounding_mode(RoundToNearest);
 		char hash[RANDOMX_HASH_SIZE];
@@ -1090,6 +1638,58 @@ int main() {
 		assert(rx_get_rounding_mode() == RoundToNearest);
 	});
 
+	runTest("Memory info", true, []() {
+		randomx_memory_info info;
+		randomx_get_memory_info(&info, cache, nullptr, vm);
+		assert(info.cache == RANDOMX_PAGES_SMALL);
+		assert(info.dataset == RANDOMX_PAGES_NONE);
+		assert(info.scratchpad == RANDOMX_PAGES_SMALL);
+		randomx_cache* largePageCache = randomx_alloc_cache(RANDOMX_FLAG_LARGE_PAGES);
+		if (largePageCache != nullptr) {
+			randomx_get_memory_info(&info, largePageCache, nullptr, nullptr);
+			assert(info.cache != RANDOMX_PAGES_NONE && info.cache != RANDOMX_PAGES_1GB);
+			memset(largePageCache->memory, 0xff, randomx::CacheSize);
+			randomx_release_cache(largePageCache);
+		}
+	});
+
+	runTest("VM statistics", true, []() {
+		char hash[RANDOMX_HASH_SIZE];
+		randomx_vm_stats stats;
+		randomx_vm_reset_stats(vm);
+		randomx_calculate_hash(vm, "This is a test", 14, hash);
+		randomx_calculate_hash_first(vm, "This is a test", 14);
+		randomx_calculate_hash_next(vm, "This is a test", 14, hash);
+		randomx_calculate_hash_last(vm, hash);
+		if (randomx_vm_get_stats(vm, &stats)) {
+			assert(stats.hashes == 3);
+			assert(stats.initScratchpad > 0 && stats.generateProgram > 0 && stats.compile > 0);
+			assert(stats.execute > 0 && stats.blake2bChain > 0 && stats.finalResult > 0);
+			randomx_vm_reset_stats(vm);
+			randomx_vm_get_stats(vm, &stats);
+		}
+		assert(stats.hashes == 0 && stats.execute == 0 && stats.finalResult == 0);
+		//resets from another thread while the VM is hashing must not be undone
+		std::atomic<bool> hashing(true);
+		std::thread resetter([&hashing]() {
+			randomx_vm_stats current;
+			while (hashing) {
+				randomx_vm_reset_stats(vm);
+				randomx_vm_get_stats(vm, &current);
+				assert(current.hashes <= 4);
+			}
+		});
+		for (int i = 0; i < 4; ++i)
+			randomx_calculate_hash(vm, "This is a test", 14, hash);
+		hashing = false;
+		resetter.join();
+		std::thread([]() { randomx_vm_reset_stats(vm); }).join();
+		randomx_calculate_hash(vm, "This is a test", 14, hash);
+		if (randomx_vm_get_stats(vm, &stats)) {
+			assert(stats.hashes == 1);
+		}
+	});
+
 	if (RANDOMX_HAVE_COMPILER) {
 		randomx_destroy_vm(vm);
 		vm = nullptr;
@@ -1112,6 +1712,9 @@ int main() {
 	if (cache != nullptr)
 		randomx_release_cache(cache);
 
+	if (fullDataset != nullptr)
+		randomx_release_dataset(fullDataset);
+
 	std::cout << std::endl << "All tests PASSED" << std::endl;
 
 	if (skipped) {
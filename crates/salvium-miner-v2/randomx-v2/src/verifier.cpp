@@ -0,0 +1,154 @@
+/*
+Copyright (c) 2026, The Salvium Project
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in the
+	  documentation and/or other materials provided with the distribution.
+	* Neither the name of the copyright holder nor the
+	  names of its contributors may be used to endorse or promote products
+	  derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include <algorithm>
+#include <cstring>
+#include "verifier.hpp"
+
+randomx_verifier::randomx_verifier(randomx_flags flags, unsigned threads) :
+	flags(flags), threadCount(std::max(threads, 1u)), generation(0), pending(0), stopping(false), nextItem(0) {
+}
+
+randomx_verifier::~randomx_verifier() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	startCondition.notify_all();
+	for (auto& worker : workers) {
+		worker.join();
+	}
+	for (auto vm : vms) {
+		randomx_destroy_vm(vm);
+	}
+}
+
+bool randomx_verifier::createVms(randomx_cache* cache, randomx_dataset* dataset) {
+	while (vms.size() < threadCount) {
+		randomx_vm* vm = randomx_create_vm(flags, (flags & RANDOMX_FLAG_FULL_MEM) ? nullptr : cache, dataset);
+		if (vm == nullptr) {
+			return false;
+		}
+		vms.push_back(vm);
+	}
+	uint64_t current;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		current = generation;
+	}
+	while (workers.size() + 1 < threadCount) {
+		try {
+			//a worker started after an earlier verify() must wait for the next generation
+			workers.push_back(std::thread(&randomx_verifier::workerLoop, this, (unsigned)workers.size() + 1, current));
+		}
+		catch (std::exception&) {
+			//the remaining VMs are not used
+			break;
+		}
+	}
+	return true;
+}
+
+bool randomx_verifier::verify(randomx_cache* const* caches, randomx_dataset* dataset, const void* const* inputs, const size_t* inputSizes,
+	const void* const* expectedHashes, size_t count, uint8_t* results, uint8_t* hashes) {
+	if (count == 0) {
+		return true;
+	}
+	bool fullMem = flags & RANDOMX_FLAG_FULL_MEM;
+	if (!createVms(fullMem ? nullptr : caches[0], dataset)) {
+		return false;
+	}
+	if (fullMem) {
+		for (auto vm : vms) {
+			randomx_vm_set_dataset(vm, dataset);
+		}
+	}
+	order.resize(count);
+	for (size_t i = 0; i < count; ++i) {
+		order[i] = i;
+	}
+	if (!fullMem) {
+		std::stable_sort(order.begin(), order.end(), [caches](size_t a, size_t b) {
+			return std::less<randomx_cache*>()(caches[a], caches[b]);
+		});
+	}
+	nextItem = 0;
+	this->caches = fullMem ? nullptr : caches;
+	this->inputs = inputs;
+	this->inputSizes = inputSizes;
+	this->expectedHashes = expectedHashes;
+	this->results = results;
+	this->hashes = hashes;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		pending = (unsigned)workers.size();
+		generation++;
+	}
+	startCondition.notify_all();
+	work(0);
+	std::unique_lock<std::mutex> lock(mutex);
+	doneCondition.wait(lock, [this] { return pending == 0; });
+	return true;
+}
+
+void randomx_verifier::workerLoop(unsigned index, uint64_t seen) {
+	for (;;) {
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			startCondition.wait(lock, [this, seen] { return stopping || generation != seen; });
+			if (stopping) {
+				return;
+			}
+			seen = generation;
+		}
+		work(index);
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			pending--;
+		}
+		doneCondition.notify_one();
+	}
+}
+
+void randomx_verifier::work(unsigned index) {
+	randomx_vm* vm = vms[index];
+	uint8_t hash[RANDOMX_HASH_SIZE];
+	size_t k;
+	while ((k = nextItem.fetch_add(1)) < order.size()) {
+		size_t i = order[k];
+		if (caches != nullptr) {
+			randomx_vm_set_cache(vm, caches[i]);
+		}
+		randomx_calculate_hash(vm, inputs[i], inputSizes[i], hash);
+		results[i] = memcmp(hash, expectedHashes[i], RANDOMX_HASH_SIZE) == 0;
+		if (hashes != nullptr) {
+			memcpy(hashes + i * RANDOMX_HASH_SIZE, hash, RANDOMX_HASH_SIZE);
+		}
+	}
+}
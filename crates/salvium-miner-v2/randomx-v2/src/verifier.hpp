@@ -0,0 +1,71 @@
+/*
+Copyright (c) 2026, The Salvium Project
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in the
+	  documentation and/or other materials provided with the distribution.
+	* Neither the name of the copyright holder nor the
+	  names of its contributors may be used to endorse or promote products
+	  derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "randomx.h"
+
+/* Global namespace for C binding */
+class randomx_verifier {
+public:
+	randomx_verifier(randomx_flags flags, unsigned threads);
+	~randomx_verifier();
+	bool verify(randomx_cache* const* caches, randomx_dataset* dataset, const void* const* inputs, const size_t* inputSizes,
+		const void* const* expectedHashes, size_t count, uint8_t* results, uint8_t* hashes);
+private:
+	bool createVms(randomx_cache* cache, randomx_dataset* dataset);
+	void workerLoop(unsigned index, uint64_t seen);
+	void work(unsigned index);
+
+	const randomx_flags flags;
+	const unsigned threadCount;
+	std::vector<randomx_vm*> vms; //one per thread, vms[0] is used by the calling thread
+	std::vector<std::thread> workers;
+	std::mutex mutex;
+	std::condition_variable startCondition;
+	std::condition_variable doneCondition;
+	uint64_t generation;
+	unsigned pending;
+	bool stopping;
+
+	//current batch, sorted by cache so that VMs rarely switch between seeds
+	std::vector<size_t> order;
+	std::atomic<size_t> nextItem;
+	randomx_cache* const* caches;
+	const void* const* inputs;
+	const size_t* inputSizes;
+	const void* const* expectedHashes;
+	uint8_t* results;
+	uint8_t* hashes;
+};
@@ -114,26 +114,42 @@ namespace randomx {
 		scratchpad = (uint8_t*)Allocator::allocMemory(ScratchpadSize);
 	}
 
+	template<class Allocator, bool softAes>
+	void VmBase<Allocator, softAes>::enableVaes() {
+		vaes = !softAes && hasVaesAesHash();
+	}
+
 	template<class Allocator, bool softAes>
 	void VmBase<Allocator, softAes>::getFinalResult(void* out, size_t outSize) {
-		hashAes1Rx4<softAes>(scratchpad, ScratchpadSize, &reg.a);
+		RANDOMX_VM_PHASE(this, finalResult);
+		RANDOMX_VM_COUNT_HASH(this);
+		if (!softAes && vaes)
+			hashAes1Rx4Vaes(scratchpad, ScratchpadSize, &reg.a);
+		else
+			hashAes1Rx4<softAes>(scratchpad, ScratchpadSize, &reg.a);
 		blake2b(out, outSize, &reg, sizeof(RegisterFile), nullptr, 0);
 	}
 
 	template<class Allocator, bool softAes>
 	void VmBase<Allocator, softAes>::hashAndFill(void* out, size_t outSize, uint64_t *fill_state) {
+		RANDOMX_VM_PHASE(this, finalResult);
+		RANDOMX_VM_COUNT_HASH(this);
 		hashAndFillAes1Rx4<softAes>((void*) getScratchpad(), ScratchpadSize, &reg.a, fill_state);
 		blake2b(out, outSize, &reg, sizeof(RegisterFile), nullptr, 0);
 	}
 
 	template<class Allocator, bool softAes>
 	void VmBase<Allocator, softAes>::initScratchpad(void* seed) {
+		RANDOMX_VM_PHASE(this, initScratchpad);
 		fillAes1Rx4<softAes>(seed, ScratchpadSize, scratchpad);
 	}
 
 	template<class Allocator, bool softAes>
 	void VmBase<Allocator, softAes>::generateProgram(void* seed) {
-		fillAes4Rx4<softAes>(seed, sizeof(program), &program);
+		if (!softAes && vaes)
+			fillAes4Rx4Vaes(seed, sizeof(program), &program);
+		else
+			fillAes4Rx4<softAes>(seed, sizeof(program), &program);
 	}
 
 	template class VmBase<AlignedAllocator<CacheLineSize>, false>;
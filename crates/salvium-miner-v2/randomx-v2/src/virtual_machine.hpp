@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <cstdint>
 #include "common.hpp"
 #include "program.hpp"
+#include "vm_stats.hpp"
 
 /* Global namespace for C binding */
 class randomx_vm {
@@ -43,6 +44,14 @@ public:
 	virtual void setCache(randomx_cache* cache) { }
 	virtual void initScratchpad(void* seed) = 0;
 	virtual void run(void* seed) = 0;
+	virtual void enableVaes() { }
+	virtual void enableDualMapping() { }
+	virtual unsigned getLaneCount() {
+		return 1;
+	}
+	//Calculates getLaneCount() hashes at once. Callers only use it when getLaneCount() > 1,
+	//which only interleaved VMs report, so the default body is never reached.
+	virtual void calculateHashInterleaved(const void* const*, size_t, void*) { }
 	void resetRoundingMode();
 	randomx::RegisterFile *getRegisterFile() {
 		return &reg;
@@ -72,6 +81,8 @@ protected:
 public:
 	std::string cacheKey;
 	alignas(16) uint64_t tempHash[8]; //8 64-bit values used to store intermediate data
+	randomx::VmStats vmStats;
+	randomx::VmStats* stats = &vmStats; //lanes of interleaved VMs report to their owner
 };
 
 namespace randomx {
@@ -84,8 +95,10 @@ namespace randomx {
 		void initScratchpad(void* seed) override;
 		void getFinalResult(void* out, size_t outSize) override;
 		void hashAndFill(void* out, size_t outSize, uint64_t *fill_state) override;
+		void enableVaes() override;
 	protected:
 		void generateProgram(void* seed);
+		bool vaes = false;
 	};
 
 }
@@ -26,6 +26,8 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <stdint.h>
+
 #if defined(_WIN32) || defined(__CYGWIN__)
 #include <windows.h>
 #else
@@ -43,10 +45,28 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #endif
 #include <sys/types.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <errno.h>
 #ifndef MAP_ANONYMOUS
 #define MAP_ANONYMOUS MAP_ANON
 #endif
+#ifdef __linux__
+#include <sys/syscall.h>
+#ifndef MPOL_BIND
+#define MPOL_BIND 2
+#endif
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+#ifndef MAP_HUGE_2MB
+#define MAP_HUGE_2MB (21 << MAP_HUGE_SHIFT)
+#endif
+#ifndef MAP_HUGE_1GB
+#define MAP_HUGE_1GB (30 << MAP_HUGE_SHIFT)
+#endif
+#endif
 #define PAGE_READONLY PROT_READ
 #define PAGE_READWRITE (PROT_READ | PROT_WRITE)
 #define PAGE_EXECUTE_READ (PROT_READ | PROT_EXEC)
@@ -231,6 +251,98 @@ void* allocLargePagesMemory(size_t bytes) {
 	return mem;
 }
 
+/* bytes must be a multiple of pageSize */
+void* allocHugePagesMemory(size_t bytes, size_t pageSize) {
+#if defined(__linux__)
+	int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_POPULATE;
+	void* mem;
+	if (pageSize == HugePageSize1GB)
+		flags |= MAP_HUGE_1GB;
+	else if (pageSize == HugePageSize2MB)
+		flags |= MAP_HUGE_2MB;
+	else
+		return NULL;
+	mem = mmap(NULL, bytes, PROT_READ | PROT_WRITE, flags, -1, 0);
+	if (mem == MAP_FAILED)
+		return NULL;
+	return mem;
+#else
+	if (pageSize != HugePageSize2MB)
+		return NULL;
+	return allocLargePagesMemory(bytes);
+#endif
+}
+
+/* bytes must be a multiple of HugePageSize2MB */
+void* allocTransparentHugePagesMemory(size_t bytes, int* advised) {
+	*advised = 0;
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+	uint8_t* mem;
+	uint8_t* aligned;
+	mem = (uint8_t*)mmap(NULL, bytes + HugePageSize2MB, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (mem == MAP_FAILED)
+		return NULL;
+	/* trim the mapping so that it starts and ends on a huge page boundary */
+	aligned = (uint8_t*)(((uintptr_t)mem + HugePageSize2MB - 1) & ~(uintptr_t)(HugePageSize2MB - 1));
+	if (aligned != mem)
+		munmap(mem, aligned - mem);
+	if (mem + HugePageSize2MB != aligned)
+		munmap(aligned + bytes, mem + HugePageSize2MB - aligned);
+	*advised = madvise(aligned, bytes, MADV_HUGEPAGE) == 0;
+	return aligned;
+#else
+	return NULL;
+#endif
+}
+
+void* allocNumaMemory(size_t bytes, unsigned node, int largePages) {
+	void* mem;
+#if defined(_WIN32) || defined(__CYGWIN__)
+	char *errfunc;
+	DWORD type = MEM_COMMIT | MEM_RESERVE;
+	if (largePages) {
+		size_t pageMinimum;
+		if (setPrivilege("SeLockMemoryPrivilege", 1, &errfunc))
+			return NULL;
+		pageMinimum = GetLargePageMinimum();
+		if (!pageMinimum)
+			return NULL;
+		bytes = alignSize(bytes, pageMinimum);
+		type |= MEM_LARGE_PAGES;
+	}
+	mem = VirtualAllocExNuma(GetCurrentProcess(), NULL, bytes, type, PAGE_READWRITE, node);
+#elif defined(__linux__)
+	unsigned long nodeMask[16] = { 0 };
+	const unsigned bitsPerWord = 8 * sizeof(unsigned long);
+	int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+	if (node >= sizeof(nodeMask) * 8)
+		return NULL;
+	if (largePages)
+		flags |= MAP_HUGETLB | MAP_HUGE_2MB;
+	/* no MAP_POPULATE: the pages must be faulted in after the memory policy is set */
+	mem = mmap(NULL, bytes, PROT_READ | PROT_WRITE, flags, -1, 0);
+	if (mem == MAP_FAILED)
+		return NULL;
+	nodeMask[node / bitsPerWord] = 1UL << (node % bitsPerWord);
+	if (syscall(SYS_mbind, mem, bytes, MPOL_BIND, nodeMask, sizeof(nodeMask) * 8, 0) != 0) {
+		/* kernels without NUMA support only have node 0 */
+		if (errno != ENOSYS || node != 0) {
+			munmap(mem, bytes);
+			return NULL;
+		}
+	}
+#else
+	if (node != 0)
+		return NULL;
+	if (largePages)
+		return allocLargePagesMemory(bytes);
+	mem = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (mem == MAP_FAILED)
+		mem = NULL;
+#endif
+	return mem;
+}
+
 void freePagedMemory(void* ptr, size_t bytes) {
 #if defined(_WIN32) || defined(__CYGWIN__)
 	VirtualFree(ptr, 0, MEM_RELEASE);
@@ -238,3 +350,110 @@ void freePagedMemory(void* ptr, size_t bytes) {
 	munmap(ptr, bytes);
 #endif
 }
+
+void* mapFileMemory(const char* path, size_t bytes, int populate) {
+	void* mem;
+#if defined(_WIN32) || defined(__CYGWIN__)
+	HANDLE file, mapping;
+	LARGE_INTEGER fileSize;
+	file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		return NULL;
+	if (!GetFileSizeEx(file, &fileSize) || (unsigned long long)fileSize.QuadPart < bytes) {
+		CloseHandle(file);
+		return NULL;
+	}
+	mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	CloseHandle(file);
+	if (mapping == NULL)
+		return NULL;
+	mem = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, bytes);
+	CloseHandle(mapping);
+#else
+	struct stat st;
+	int flags = MAP_PRIVATE;
+	int fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return NULL;
+	if (fstat(fd, &st) != 0 || (unsigned long long)st.st_size < bytes) {
+		close(fd);
+		return NULL;
+	}
+#ifdef MAP_POPULATE
+	if (populate)
+		flags |= MAP_POPULATE;
+#endif
+	mem = mmap(NULL, bytes, PROT_READ, flags, fd, 0);
+	close(fd);
+	if (mem == MAP_FAILED)
+		mem = NULL;
+#endif
+	return mem;
+}
+
+void freeMappedFileMemory(void* ptr, size_t bytes) {
+#if defined(_WIN32) || defined(__CYGWIN__)
+	UnmapViewOfFile(ptr);
+#else
+	munmap(ptr, bytes);
+#endif
+}
+
+/* Maps the same memory twice: the returned view is read+write and *execView
+ * is read+execute, so JIT code can be written and executed without ever
+ * changing page protections. Returns NULL if not supported. */
+void* allocDualMappedMemory(size_t bytes, void** execView) {
+	void* mem = NULL;
+	*execView = NULL;
+#if defined(_WIN32) || defined(__CYGWIN__)
+	HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_EXECUTE_READWRITE | SEC_COMMIT,
+		(DWORD)((unsigned long long)bytes >> 32), (DWORD)bytes, NULL);
+	if (mapping == NULL)
+		return NULL;
+	mem = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, bytes);
+	if (mem != NULL) {
+		*execView = MapViewOfFile(mapping, FILE_MAP_READ | FILE_MAP_EXECUTE, 0, 0, bytes);
+		if (*execView == NULL) {
+			UnmapViewOfFile(mem);
+			mem = NULL;
+		}
+	}
+	CloseHandle(mapping);
+#elif (defined(__linux__) && defined(SYS_memfd_create)) || defined(__FreeBSD__)
+	void* exec;
+#if defined(__linux__)
+	int fd = (int)syscall(SYS_memfd_create, "randomx-jit", 1 /* MFD_CLOEXEC */);
+#else
+	int fd = shm_open(SHM_ANON, O_RDWR | O_CLOEXEC, 0600);
+#endif
+	if (fd < 0)
+		return NULL;
+	if (ftruncate(fd, (off_t)bytes) != 0) {
+		close(fd);
+		return NULL;
+	}
+	mem = mmap(NULL, bytes, PAGE_READWRITE, MAP_SHARED, fd, 0);
+	if (mem == MAP_FAILED) {
+		close(fd);
+		return NULL;
+	}
+	exec = mmap(NULL, bytes, PAGE_EXECUTE_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (exec == MAP_FAILED) {
+		munmap(mem, bytes);
+		return NULL;
+	}
+	*execView = exec;
+#endif
+	return mem;
+}
+
+void freeDualMappedMemory(void* ptr, void* execView, size_t bytes) {
+#if defined(_WIN32) || defined(__CYGWIN__)
+	UnmapViewOfFile(execView);
+	UnmapViewOfFile(ptr);
+#else
+	munmap(execView, bytes);
+	munmap(ptr, bytes);
+#endif
+}
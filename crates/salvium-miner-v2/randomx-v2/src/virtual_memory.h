@@ -36,12 +36,22 @@ extern "C" {
 
 #define alignSize(pos, align) (((pos - 1) / align + 1) * align)
 
+#define HugePageSize2MB ((size_t)2 * 1024 * 1024)
+#define HugePageSize1GB ((size_t)1024 * 1024 * 1024)
+
 void* allocMemoryPages(size_t);
 void setPagesRW(void*, size_t);
 void setPagesRX(void*, size_t);
 void setPagesRWX(void*, size_t);
 void* allocLargePagesMemory(size_t);
+void* allocHugePagesMemory(size_t, size_t);
+void* allocTransparentHugePagesMemory(size_t, int*);
+void* allocNumaMemory(size_t, unsigned, int);
 void freePagedMemory(void*, size_t);
+void* mapFileMemory(const char*, size_t, int);
+void freeMappedFileMemory(void*, size_t);
+void* allocDualMappedMemory(size_t, void**);
+void freeDualMappedMemory(void*, void*, size_t);
 
 #ifdef __cplusplus
 }
@@ -41,6 +41,13 @@ namespace randomx {
 		}
 	}
 
+	template<class Allocator, bool softAes, bool secureJit>
+	void CompiledVm<Allocator, softAes, secureJit>::enableDualMapping() {
+		if (secureJit) {
+			compiler.enableDualMapping();
+		}
+	}
+
 	template<class Allocator, bool softAes, bool secureJit>
 	void CompiledVm<Allocator, softAes, secureJit>::setDataset(randomx_dataset* dataset) {
 		datasetPtr = dataset;
@@ -48,14 +55,20 @@ namespace randomx {
 
 	template<class Allocator, bool softAes, bool secureJit>
 	void CompiledVm<Allocator, softAes, secureJit>::run(void* seed) {
-		VmBase<Allocator, softAes>::generateProgram(seed);
-		randomx_vm::initialize();
-		if (secureJit) {
-			compiler.enableWriting();
+		{
+			RANDOMX_VM_PHASE(this, generateProgram);
+			VmBase<Allocator, softAes>::generateProgram(seed);
+			randomx_vm::initialize();
 		}
-		compiler.generateProgram(program, config);
-		if (secureJit) {
-			compiler.enableExecution();
+		{
+			RANDOMX_VM_PHASE(this, compile);
+			if (secureJit) {
+				compiler.enableWriting();
+			}
+			compiler.generateProgram(program, config);
+			if (secureJit) {
+				compiler.enableExecution();
+			}
 		}
 		mem.memory = datasetPtr->memory + datasetOffset;
 		execute();
@@ -63,6 +76,7 @@ namespace randomx {
 
 	template<class Allocator, bool softAes, bool secureJit>
 	void CompiledVm<Allocator, softAes, secureJit>::execute() {
+		RANDOMX_VM_PHASE(this, execute);
 #ifdef __aarch64__
 		memcpy(reg.f, config.eMask, sizeof(config.eMask));
 #endif
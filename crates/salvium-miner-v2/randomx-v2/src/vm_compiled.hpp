@@ -52,6 +52,7 @@ namespace randomx {
 		CompiledVm();
 		void setDataset(randomx_dataset* dataset) override;
 		void run(void* seed) override;
+		void enableDualMapping() override;
 
 		using VmBase<Allocator, softAes>::mem;
 		using VmBase<Allocator, softAes>::program;
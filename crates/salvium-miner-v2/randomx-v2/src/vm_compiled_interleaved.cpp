@@ -0,0 +1,179 @@
+/*
+Copyright (c) 2026, The Salvium Project
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in the
+	  documentation and/or other materials provided with the distribution.
+	* Neither the name of the copyright holder nor the
+	  names of its contributors may be used to endorse or promote products
+	  derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cstring>
+#include "vm_compiled_interleaved.hpp"
+#include "common.hpp"
+#include "intrin_portable.h"
+#include "blake2/blake2.h"
+
+namespace randomx {
+
+	template<class Allocator, bool softAes>
+	void InterleavedLane<Allocator, softAes>::run(void* seed) {
+		RANDOMX_VM_PHASE(this, generateProgram);
+		VmBase<Allocator, softAes>::generateProgram(seed);
+		randomx_vm::initialize();
+	}
+
+	//Same initial state as the program prologue of a single-lane VM. The rounding mode is kept across programs.
+	template<class Allocator, bool softAes>
+	void InterleavedLane<Allocator, softAes>::loadState(InterleavedLaneState& state) {
+		memset(state.reg.r, 0, sizeof(state.reg.r));
+		memcpy(state.reg.a, reg.a, sizeof(reg.a));
+		memcpy(state.eMask, config.eMask, sizeof(config.eMask));
+		state.spAddr0 = mem.mx & ScratchpadL3Mask64;
+		state.spAddr1 = mem.ma & ScratchpadL3Mask64;
+		state.memoryRegisters = ((uint64_t)mem.mx << 32) | mem.ma;
+		state.scratchpad = scratchpad;
+		state.dataset = datasetPtr->memory + datasetOffset;
+	}
+
+	template<class Allocator, bool softAes>
+	void InterleavedLane<Allocator, softAes>::storeState(const InterleavedLaneState& state) {
+		memcpy(reg.r, state.reg.r, sizeof(reg.r));
+		memcpy(reg.f, state.reg.f, sizeof(reg.f));
+		memcpy(reg.e, state.reg.e, sizeof(reg.e));
+	}
+
+	template<class Allocator, bool softAes, bool secureJit>
+	CompiledInterleavedVm<Allocator, softAes, secureJit>::CompiledInterleavedVm(unsigned lanes) : laneCount(lanes), interleavedCompiler(lanes) {
+		if (!secureJit) {
+			interleavedCompiler.enableAll();
+		}
+	}
+
+	template<class Allocator, bool softAes, bool secureJit>
+	CompiledInterleavedVm<Allocator, softAes, secureJit>::~CompiledInterleavedVm() {
+		for (unsigned k = 0; k < laneCount; ++k) {
+			delete lanes[k];
+		}
+	}
+
+	template<class Allocator, bool softAes, bool secureJit>
+	void CompiledInterleavedVm<Allocator, softAes, secureJit>::allocate() {
+		CompiledVm<Allocator, softAes, secureJit>::allocate();
+		for (unsigned k = 0; k < laneCount; ++k) {
+			lanes[k] = new InterleavedLane<Allocator, softAes>();
+			lanes[k]->setDataset(datasetPtr);
+			lanes[k]->allocate();
+			lanes[k]->stats = this->stats;
+		}
+	}
+
+	template<class Allocator, bool softAes, bool secureJit>
+	void CompiledInterleavedVm<Allocator, softAes, secureJit>::setDataset(randomx_dataset* dataset) {
+		CompiledVm<Allocator, softAes, secureJit>::setDataset(dataset);
+		for (unsigned k = 0; k < laneCount; ++k) {
+			if (lanes[k] != nullptr)
+				lanes[k]->setDataset(dataset);
+		}
+	}
+
+	template<class Allocator, bool softAes, bool secureJit>
+	void CompiledInterleavedVm<Allocator, softAes, secureJit>::enableVaes() {
+		CompiledVm<Allocator, softAes, secureJit>::enableVaes();
+		for (unsigned k = 0; k < laneCount; ++k) {
+			lanes[k]->enableVaes();
+		}
+	}
+
+	template<class Allocator, bool softAes, bool secureJit>
+	void CompiledInterleavedVm<Allocator, softAes, secureJit>::enableDualMapping() {
+		CompiledVm<Allocator, softAes, secureJit>::enableDualMapping();
+		if (secureJit) {
+			interleavedCompiler.enableDualMapping();
+		}
+	}
+
+	template<class Allocator, bool softAes, bool secureJit>
+	void CompiledInterleavedVm<Allocator, softAes, secureJit>::calculateHashInterleaved(const void* const* inputs, size_t inputSize, void* output) {
+		for (unsigned k = 0; k < laneCount; ++k) {
+			{
+				RANDOMX_VM_PHASE(this, blake2bChain);
+				blake2b(lanes[k]->tempHash, sizeof(lanes[k]->tempHash), inputs[k], inputSize, nullptr, 0);
+			}
+			lanes[k]->initScratchpad(lanes[k]->tempHash);
+			states[k].mxcsr = rx_mxcsr_default;
+		}
+		for (int chain = 0; chain < RANDOMX_PROGRAM_COUNT; ++chain) {
+			for (unsigned k = 0; k < laneCount; ++k) {
+				lanes[k]->run(lanes[k]->tempHash);
+			}
+			execute();
+			if (chain == RANDOMX_PROGRAM_COUNT - 1)
+				break;
+			RANDOMX_VM_PHASE(this, blake2bChain);
+			for (unsigned k = 0; k < laneCount; ++k) {
+				blake2b(lanes[k]->tempHash, sizeof(lanes[k]->tempHash), &lanes[k]->reg, sizeof(RegisterFile), nullptr, 0);
+			}
+		}
+		for (unsigned k = 0; k < laneCount; ++k) {
+			lanes[k]->getFinalResult((uint8_t*)output + k * RANDOMX_HASH_SIZE, RANDOMX_HASH_SIZE);
+		}
+	}
+
+	template<class Allocator, bool softAes, bool secureJit>
+	void CompiledInterleavedVm<Allocator, softAes, secureJit>::execute() {
+		Program* programs[MaxInterleavedLanes];
+		ProgramConfiguration* configs[MaxInterleavedLanes];
+		for (unsigned k = 0; k < laneCount; ++k) {
+			lanes[k]->loadState(states[k]);
+			programs[k] = &lanes[k]->program;
+			configs[k] = &lanes[k]->config;
+		}
+		{
+			RANDOMX_VM_PHASE(this, compile);
+			if (secureJit) {
+				interleavedCompiler.enableWriting();
+			}
+			interleavedCompiler.generateProgramInterleaved(programs, configs, states, laneCount);
+			if (secureJit) {
+				interleavedCompiler.enableExecution();
+			}
+		}
+		RANDOMX_VM_PHASE(this, execute);
+		//the prologue only needs valid pointers, the lane states are loaded by the generated code
+		MemoryRegisters memory;
+		memory.memory = datasetPtr->memory;
+		auto last = lanes[laneCount - 1];
+		interleavedCompiler.getProgramFunc()(last->reg, memory, last->scratchpad, RANDOMX_PROGRAM_ITERATIONS);
+		for (unsigned k = 0; k < laneCount; ++k) {
+			lanes[k]->storeState(states[k]);
+		}
+	}
+
+	template class CompiledInterleavedVm<AlignedAllocator<CacheLineSize>, false, false>;
+	template class CompiledInterleavedVm<AlignedAllocator<CacheLineSize>, true, false>;
+	template class CompiledInterleavedVm<LargePageAllocator, false, false>;
+	template class CompiledInterleavedVm<LargePageAllocator, true, false>;
+	template class CompiledInterleavedVm<AlignedAllocator<CacheLineSize>, false, true>;
+	template class CompiledInterleavedVm<AlignedAllocator<CacheLineSize>, true, true>;
+	template class CompiledInterleavedVm<LargePageAllocator, false, true>;
+	template class CompiledInterleavedVm<LargePageAllocator, true, true>;
+}
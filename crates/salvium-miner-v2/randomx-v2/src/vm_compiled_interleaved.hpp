@@ -0,0 +1,112 @@
+/*
+Copyright (c) 2026, The Salvium Project
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in the
+	  documentation and/or other materials provided with the distribution.
+	* Neither the name of the copyright holder nor the
+	  names of its contributors may be used to endorse or promote products
+	  derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include <new>
+#include <cstdint>
+#include "vm_compiled.hpp"
+
+namespace randomx {
+
+	constexpr unsigned MaxInterleavedLanes = 4;
+
+	//Scratchpad, program and registers of one hash of an interleaved VM.
+	template<class Allocator, bool softAes>
+	class InterleavedLane : public VmBase<Allocator, softAes> {
+	public:
+		void* operator new(size_t size) {
+			void* ptr = AlignedAllocator<CacheLineSize>::allocMemory(size);
+			if (ptr == nullptr)
+				throw std::bad_alloc();
+			return ptr;
+		}
+		void operator delete(void* ptr) {
+			AlignedAllocator<CacheLineSize>::freeMemory(ptr, sizeof(InterleavedLane));
+		}
+		void setDataset(randomx_dataset* dataset) override {
+			datasetPtr = dataset;
+		}
+		//only generates the program, it is executed by the owning CompiledInterleavedVm
+		void run(void* seed) override;
+		void loadState(InterleavedLaneState& state);
+		void storeState(const InterleavedLaneState& state);
+
+		using VmBase<Allocator, softAes>::mem;
+		using VmBase<Allocator, softAes>::program;
+		using VmBase<Allocator, softAes>::config;
+		using VmBase<Allocator, softAes>::reg;
+		using VmBase<Allocator, softAes>::scratchpad;
+		using VmBase<Allocator, softAes>::datasetPtr;
+		using VmBase<Allocator, softAes>::datasetOffset;
+	};
+
+	//Full memory compiled VM that calculates 2 or 4 hashes at once by executing
+	//the iterations of their programs in turn. Single hashes use the CompiledVm base.
+	template<class Allocator, bool softAes, bool secureJit>
+	class CompiledInterleavedVm : public CompiledVm<Allocator, softAes, secureJit> {
+	public:
+		void* operator new(size_t size) {
+			void* ptr = AlignedAllocator<CacheLineSize>::allocMemory(size);
+			if (ptr == nullptr)
+				throw std::bad_alloc();
+			return ptr;
+		}
+		void operator delete(void* ptr) {
+			AlignedAllocator<CacheLineSize>::freeMemory(ptr, sizeof(CompiledInterleavedVm));
+		}
+		explicit CompiledInterleavedVm(unsigned lanes);
+		~CompiledInterleavedVm() override;
+		void allocate() override;
+		void setDataset(randomx_dataset* dataset) override;
+		void enableVaes() override;
+		void enableDualMapping() override;
+		unsigned getLaneCount() override {
+			return laneCount;
+		}
+		void calculateHashInterleaved(const void* const* inputs, size_t inputSize, void* output) override;
+
+		using CompiledVm<Allocator, softAes, secureJit>::datasetPtr;
+	private:
+		void execute();
+
+		alignas(64) InterleavedLaneState states[MaxInterleavedLanes];
+		InterleavedLane<Allocator, softAes>* lanes[MaxInterleavedLanes] = {};
+		unsigned laneCount;
+		JitCompiler interleavedCompiler;
+	};
+
+	using CompiledInterleavedVmDefault = CompiledInterleavedVm<AlignedAllocator<CacheLineSize>, true, false>;
+	using CompiledInterleavedVmHardAes = CompiledInterleavedVm<AlignedAllocator<CacheLineSize>, false, false>;
+	using CompiledInterleavedVmLargePage = CompiledInterleavedVm<LargePageAllocator, true, false>;
+	using CompiledInterleavedVmLargePageHardAes = CompiledInterleavedVm<LargePageAllocator, false, false>;
+	using CompiledInterleavedVmDefaultSecure = CompiledInterleavedVm<AlignedAllocator<CacheLineSize>, true, true>;
+	using CompiledInterleavedVmHardAesSecure = CompiledInterleavedVm<AlignedAllocator<CacheLineSize>, false, true>;
+	using CompiledInterleavedVmLargePageSecure = CompiledInterleavedVm<LargePageAllocator, true, true>;
+	using CompiledInterleavedVmLargePageHardAesSecure = CompiledInterleavedVm<LargePageAllocator, false, true>;
+}
@@ -47,16 +47,24 @@ namespace randomx {
 
 	template<class Allocator, bool softAes, bool secureJit>
 	void CompiledLightVm<Allocator, softAes, secureJit>::run(void* seed) {
-		VmBase<Allocator, softAes>::generateProgram(seed);
-		randomx_vm::initialize();
-		if (secureJit) {
-			compiler.enableWriting();
+		{
+			RANDOMX_VM_PHASE(this, generateProgram);
+			VmBase<Allocator, softAes>::generateProgram(seed);
+			randomx_vm::initialize();
 		}
-		compiler.generateProgramLight(program, config, datasetOffset);
-		if (secureJit) {
-			compiler.enableExecution();
+		{
+			RANDOMX_VM_PHASE(this, compile);
+			if (secureJit) {
+				compiler.enableWriting();
+			}
+			compiler.setItemMemo(cachePtr->itemMemo, &memoCounters);
+			compiler.generateProgramLight(program, config, datasetOffset);
+			if (secureJit) {
+				compiler.enableExecution();
+			}
 		}
 		CompiledVm<Allocator, softAes, secureJit>::execute();
+		memoCounters.flush(cachePtr->itemMemo);
 	}
 
 	template class CompiledLightVm<AlignedAllocator<CacheLineSize>, false, false>;
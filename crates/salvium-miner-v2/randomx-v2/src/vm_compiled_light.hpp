@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <new>
 #include "vm_compiled.hpp"
+#include "dataset_memo.hpp"
 
 namespace randomx {
 
@@ -55,6 +56,8 @@ namespace randomx {
 		using CompiledVm<Allocator, softAes, secureJit>::config;
 		using CompiledVm<Allocator, softAes, secureJit>::cachePtr;
 		using CompiledVm<Allocator, softAes, secureJit>::datasetOffset;
+	private:
+		ItemMemoCounters memoCounters;
 	};
 
 	using CompiledLightVmDefault = CompiledLightVm<AlignedAllocator<CacheLineSize>, true, false>;
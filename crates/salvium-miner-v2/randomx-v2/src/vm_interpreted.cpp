@@ -47,8 +47,11 @@ namespace randomx {
 
 	template<class Allocator, bool softAes>
 	void InterpretedVm<Allocator, softAes>::run(void* seed) {
-		VmBase<Allocator, softAes>::generateProgram(seed);
-		randomx_vm::initialize();
+		{
+			RANDOMX_VM_PHASE(this, generateProgram);
+			VmBase<Allocator, softAes>::generateProgram(seed);
+			randomx_vm::initialize();
+		}
 		execute();
 	}
 
@@ -60,7 +63,13 @@ namespace randomx {
 		for(unsigned i = 0; i < RegisterCountFlt; ++i)
 			nreg.a[i] = rx_load_vec_f128(&reg.a[i].lo);
 
-		compileProgram(program, bytecode, nreg);
+		{
+			RANDOMX_VM_PHASE(this, compile);
+			compileProgram(program, bytecode, nreg);
+			threadBytecode(bytecode, dispatch);
+		}
+
+		RANDOMX_VM_PHASE(this, execute);
 
 		uint32_t spAddr0 = mem.mx;
 		uint32_t spAddr1 = mem.ma;
@@ -81,7 +90,7 @@ namespace randomx {
 			for (unsigned i = 0; i < RegisterCountFlt; ++i)
 				nreg.e[i] = maskRegisterExponentMantissa(config, rx_cvt_packed_int_vec_f128(scratchpad + spAddr1 + 8 * (RegisterCountFlt + i)));
 
-			executeBytecode(bytecode, scratchpad, config);
+			executeBytecodeThreaded(bytecode, dispatch, scratchpad, config);
 
 			mem.mx ^= nreg.r[config.readReg2] ^ nreg.r[config.readReg3];
 			mem.mx &= CacheLineAlignMask;
@@ -66,6 +66,7 @@ namespace randomx {
 		void execute();
 
 		InstructionByteCode bytecode[RANDOMX_PROGRAM_SIZE];
+		uint8_t dispatch[RANDOMX_PROGRAM_SIZE + 1];
 	};
 
 	using InterpretedVmDefault = InterpretedVm<AlignedAllocator<CacheLineSize>, true>;
@@ -37,12 +37,29 @@ namespace randomx {
 		mem.memory = cache->memory;
 	}
 
+	template<class Allocator, bool softAes>
+	void InterpretedLightVm<Allocator, softAes>::run(void* seed) {
+		InterpretedVm<Allocator, softAes>::run(seed);
+		memoCounters.flush(cachePtr->itemMemo);
+	}
+
 	template<class Allocator, bool softAes>
 	void InterpretedLightVm<Allocator, softAes>::datasetRead(uint64_t address, int_reg_t(&r)[8]) {
 		uint32_t itemNumber = address / CacheLineSize;
 		int_reg_t rl[8];
-		
-		initDatasetItem(cachePtr, (uint8_t*)rl, itemNumber);
+		DatasetItemMemo* memo = cachePtr->itemMemo;
+
+		if (memo == nullptr) {
+			initDatasetItem(cachePtr, (uint8_t*)rl, itemNumber);
+		}
+		else if (memo->lookup(itemNumber, rl)) {
+			memoCounters.hits++;
+		}
+		else {
+			initDatasetItem(cachePtr, (uint8_t*)rl, itemNumber);
+			memo->store(itemNumber, rl);
+			memoCounters.misses++;
+		}
 
 		for (unsigned q = 0; q < 8; ++q)
 			r[q] ^= rl[q];
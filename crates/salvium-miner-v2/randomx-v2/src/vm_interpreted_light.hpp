@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <new>
 #include "vm_interpreted.hpp"
+#include "dataset_memo.hpp"
 
 namespace randomx {
 
@@ -49,9 +50,12 @@ namespace randomx {
 		}
 		void setDataset(randomx_dataset* dataset) override { }
 		void setCache(randomx_cache* cache) override;
+		void run(void* seed) override;
 	protected:
 		void datasetRead(uint64_t address, int_reg_t(&r)[8]) override;
 		void datasetPrefetch(uint64_t address) override { }
+
+		ItemMemoCounters memoCounters;
 	};
 
 	using InterpretedLightVmDefault = InterpretedLightVm<AlignedAllocator<CacheLineSize>, true>;
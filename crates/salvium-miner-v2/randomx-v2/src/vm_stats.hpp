@@ -0,0 +1,128 @@
+/*
+Copyright (c) 2026, The Salvium Project
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in the
+	  documentation and/or other materials provided with the distribution.
+	* Neither the name of the copyright holder nor the
+	  names of its contributors may be used to endorse or promote products
+	  derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif !defined(__aarch64__)
+#include <chrono>
+#endif
+
+namespace randomx {
+
+	//Per-VM time spent in each phase of the hash calculation, in ticks of readCycleCounter().
+	//The totals are only written by the thread that runs the VM; relaxed atomics
+	//let another thread read them without a data race and cost nothing extra on x86 and ARM.
+	//A reset from another thread must not write the totals (the VM thread would store
+	//its stale sum back), so it records a baseline that get() subtracts instead.
+	class VmCounter {
+	public:
+		VmCounter() : total(0), baseline(0) {}
+		void add(uint64_t value) {
+			total.store(total.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+		}
+		//the acquire load orders the total after the baseline, so the difference never underflows
+		uint64_t get() const {
+			uint64_t base = baseline.load(std::memory_order_acquire);
+			return total.load(std::memory_order_relaxed) - base;
+		}
+		void reset() {
+			baseline.store(total.load(std::memory_order_relaxed), std::memory_order_release);
+		}
+	private:
+		std::atomic<uint64_t> total;
+		std::atomic<uint64_t> baseline;
+	};
+
+	struct VmStats {
+		VmCounter hashes;
+		VmCounter initScratchpad;
+		VmCounter generateProgram;
+		VmCounter compile;
+		VmCounter execute;
+		VmCounter blake2bChain;
+		VmCounter finalResult;
+
+		void reset() {
+			hashes.reset();
+			initScratchpad.reset();
+			generateProgram.reset();
+			compile.reset();
+			execute.reset();
+			blake2bChain.reset();
+			finalResult.reset();
+		}
+	};
+
+	//TSC on x86, the virtual counter on ARMv8, nanoseconds elsewhere
+	inline uint64_t readCycleCounter() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+		return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+		return __rdtsc();
+#elif defined(__aarch64__)
+		uint64_t ticks;
+		asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+		return ticks;
+#else
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+	}
+
+	class PhaseTimer {
+	public:
+		explicit PhaseTimer(VmCounter& phaseCounter) : counter(phaseCounter), start(readCycleCounter()) {}
+		~PhaseTimer() {
+			counter.add(readCycleCounter() - start);
+		}
+		PhaseTimer(const PhaseTimer&) = delete;
+		PhaseTimer& operator=(const PhaseTimer&) = delete;
+	private:
+		VmCounter& counter;
+		uint64_t start;
+	};
+}
+
+//RANDOMX_VM_PHASE(vm, phase) accounts the rest of the enclosing scope to vm->stats->phase.
+//The instrumentation is compiled in only if RANDOMX_VM_STATS is defined.
+#ifdef RANDOMX_VM_STATS
+#define RANDOMX_VM_PHASE_CONCAT2(a, b) a##b
+#define RANDOMX_VM_PHASE_CONCAT(a, b) RANDOMX_VM_PHASE_CONCAT2(a, b)
+#define RANDOMX_VM_PHASE(vm, phase) randomx::PhaseTimer RANDOMX_VM_PHASE_CONCAT(phaseTimer, __LINE__)((vm)->stats->phase)
+#define RANDOMX_VM_COUNT_HASH(vm) (vm)->stats->hashes.add(1)
+#else
+#define RANDOMX_VM_PHASE(vm, phase)
+#define RANDOMX_VM_COUNT_HASH(vm)
+#endif
@@ -2,6 +2,20 @@
 //!
 //! Same API surface as RandomX v1 plus `randomx_calculate_commitment`.
 
+/// Per-VM phase counters filled by `randomx_vm_get_stats` (see randomx.h).
+#[allow(dead_code)]
+#[repr(C)]
+#[derive(Debug, Default, Clone, Copy)]
+pub struct RandomxVmStats {
+    pub hashes: u64,
+    pub init_scratchpad: u64,
+    pub generate_program: u64,
+    pub compile: u64,
+    pub execute: u64,
+    pub blake2b_chain: u64,
+    pub final_result: u64,
+}
+
 #[allow(dead_code)]
 extern "C" {
     pub fn randomx_get_flags() -> u32;
@@ -46,6 +60,19 @@ extern "C" {
     );
     pub fn randomx_calculate_hash_last(vm: *mut std::ffi::c_void, output: *mut u8);
 
+    /// Hash `count` consecutive nonces through the first/next/last pipeline.
+    /// Returns the number of hashes written; stops early on a 64-bit target hit.
+    pub fn randomx_calculate_hash_batch(
+        vm: *mut std::ffi::c_void,
+        input: *const u8,
+        input_size: usize,
+        nonce_offset: usize,
+        nonce_start: u32,
+        count: usize,
+        output: *mut u8,
+        target: u64,
+    ) -> usize;
+
     /// v2-specific: calculate commitment = Blake2b(input || hash)
     pub fn randomx_calculate_commitment(
         input: *const u8,
@@ -53,4 +80,59 @@ extern "C" {
         hash_in: *const u8,
         com_out: *mut u8,
     );
+
+    /// Batch verifier with a persistent pool of `threads` VMs (including the caller).
+    pub fn randomx_create_verifier(flags: u32, threads: u32) -> *mut std::ffi::c_void;
+    /// Hash `count` inputs and set `results[i]` to 1 when the hash matches
+    /// `expected_hashes[i]`. Light mode takes one cache per input; `hashes` may be null.
+    pub fn randomx_verify_batch(
+        verifier: *mut std::ffi::c_void,
+        caches: *const *mut std::ffi::c_void,
+        dataset: *mut std::ffi::c_void,
+        inputs: *const *const u8,
+        input_sizes: *const usize,
+        expected_hashes: *const *const u8,
+        count: usize,
+        results: *mut u8,
+        hashes: *mut u8,
+    ) -> i32;
+    pub fn randomx_destroy_verifier(verifier: *mut std::ffi::c_void);
+
+    /// Seed-keyed cache registry: one refcounted cache per seed, LRU eviction
+    /// of unreferenced caches once `memory_budget` bytes are in use.
+    pub fn randomx_create_cache_registry(
+        flags: u32,
+        memory_budget: usize,
+        init_threads: u32,
+    ) -> *mut std::ffi::c_void;
+    pub fn randomx_cache_registry_prepare(
+        registry: *mut std::ffi::c_void,
+        seed: *const u8,
+        seed_size: usize,
+    ) -> i32;
+    pub fn randomx_cache_registry_acquire(
+        registry: *mut std::ffi::c_void,
+        seed: *const u8,
+        seed_size: usize,
+    ) -> *mut std::ffi::c_void;
+    pub fn randomx_cache_registry_release(
+        registry: *mut std::ffi::c_void,
+        cache: *mut std::ffi::c_void,
+    );
+    pub fn randomx_cache_registry_attach_vm(
+        registry: *mut std::ffi::c_void,
+        vm: *mut std::ffi::c_void,
+        seed: *const u8,
+        seed_size: usize,
+    ) -> i32;
+    pub fn randomx_cache_registry_detach_vm(
+        registry: *mut std::ffi::c_void,
+        vm: *mut std::ffi::c_void,
+    );
+    pub fn randomx_cache_registry_count(registry: *mut std::ffi::c_void) -> usize;
+    pub fn randomx_destroy_cache_registry(registry: *mut std::ffi::c_void);
+
+    /// Returns 0 (and zeroed stats) unless built with the `vm-stats` feature.
+    pub fn randomx_vm_get_stats(vm: *mut std::ffi::c_void, stats: *mut RandomxVmStats) -> i32;
+    pub fn randomx_vm_reset_stats(vm: *mut std::ffi::c_void);
 }